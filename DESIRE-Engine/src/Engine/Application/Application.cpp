@@ -4,7 +4,10 @@
 #include "Engine/Application/OSWindow.h"
 #include "Engine/Application/ResourceManager.h"
 
+#include "Engine/Core/Job/JobSystem.h"
+#include "Engine/Core/Memory/AllocationTracker.h"
 #include "Engine/Core/Memory/MemorySystem.h"
+#include "Engine/Core/Object.h"
 #include "Engine/Core/Timer.h"
 
 #include "Engine/Input/Input.h"
@@ -12,6 +15,9 @@
 #include "Engine/Physics/Physics.h"
 
 #include "Engine/Render/Render.h"
+#include "Engine/Render/RenderThread.h"
+
+#include "Engine/Scene/ISceneManager.h"
 
 #include "Engine/Script/ScriptSystem.h"
 
@@ -42,6 +48,11 @@ ResourceManager& Application::GetResourceManager()
 	return *m_spResourceManager;
 }
 
+const FrameTaskGraph& Application::GetFrameTaskGraph() const
+{
+	return m_frameTaskGraph;
+}
+
 void Application::SendEvent(EAppEventType eventType, const void* pUserData)
 {
 	DESIRE_UNUSED(pUserData);
@@ -70,9 +81,17 @@ int32_t Application::Start(int32_t argc, const char* const* ppArgv)
 	{
 		CreationParams params = Modules::Application->GetCreationParams(argc, ppArgv);
 		Modules::Application->m_spMainWindow = std::make_unique<OSWindow>(params.windowParams);
+		if(params.isPipelinedRenderingEnabled)
+		{
+			Modules::Application->m_spRenderThread = std::make_unique<RenderThread>();
+			Modules::Render->SetOwnerThread(Modules::Application->m_spRenderThread->GetThreadId());
+		}
 	}
 
-	Modules::Render->Init(*Modules::Application->m_spMainWindow);
+	Modules::Application->ExecuteOnRenderThread([]()
+	{
+		Modules::Render->Init(*Modules::Application->m_spMainWindow);
+	});
 	Modules::Input->Init(*Modules::Application->m_spMainWindow);
 	Modules::UI->Init();
 
@@ -80,11 +99,21 @@ int32_t Application::Start(int32_t argc, const char* const* ppArgv)
 
 	Modules::UI->Kill();
 	Modules::Input->Kill();
-	Modules::Render->Kill();
+	Modules::Application->ExecuteOnRenderThread([]()
+	{
+		Modules::Render->ExecuteDeferredCommands();
+		Modules::Render->Kill();
+	});
+
+	// The resources destroyed after this point are unbound right away on the main thread
+	Modules::Render->SetOwnerThread(std::this_thread::get_id());
 
 	Modules::Application = nullptr;
 	DestroyModules();
 
+	// Everything tracked at this point has been leaked
+	AllocationTracker::LogLeakReport();
+
 	return s_returnValue;
 }
 
@@ -97,6 +126,13 @@ void Application::Stop(int32_t returnValue)
 void Application::Run()
 {
 	Init();
+	SetupFrameTaskGraph(m_frameTaskGraph);
+
+	// The scene is updated after every stage of the application which is writing it
+	m_frameTaskGraph.AddMainThreadStage("UpdateScene", FrameTaskGraph::SCENE, FrameTaskGraph::SCENE, [this]()
+	{
+		UpdateScene();
+	});
 
 	s_isMainLoopRunning = true;
 	while(s_isMainLoopRunning)
@@ -106,23 +142,148 @@ void Application::Run()
 
 		m_spMainWindow->HandleWindowMessages();
 
-		if(Modules::ScriptSystem != nullptr)
+		m_frameTaskGraph.Execute(Modules::JobSystem.get());
+
+		if(m_spRenderThread != nullptr)
 		{
-			Modules::ScriptSystem->Update();
+			RenderFramePipelined();
 		}
+		else
+		{
+			RenderFrameSerial();
+		}
+
+		MemorySystem::SampleMemoryTagStats();
+		AllocationTracker::EndFrame();
+	}
 
-		if(Modules::Physics != nullptr)
+	// Wait for the last frame to finish rendering
+	if(m_spRenderThread != nullptr)
+	{
+		m_spRenderThread->WaitForIdle();
+	}
+
+	Kill();
+}
+
+void Application::SetupFrameTaskGraph(FrameTaskGraph& taskGraph)
+{
+	// The default stages are conflicting on the scene, so they run one after the other:
+	// - The scripts move their objects and drive the physics bodies through the components of the objects
+	// - Physics reads the transforms of the kinematic bodies and writes the transforms of the dynamic ones
+	if(Modules::ScriptSystem != nullptr)
+	{
+		taskGraph.AddMainThreadStage("ScriptSystem", FrameTaskGraph::TIMER | FrameTaskGraph::INPUT, FrameTaskGraph::SCRIPTS | FrameTaskGraph::SCENE | FrameTaskGraph::PHYSICS, []()
+		{
+			DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Script);
+			Modules::ScriptSystem->Update();
+		});
+	}
+
+	if(Modules::Physics != nullptr)
+	{
+		taskGraph.AddStage("Physics", FrameTaskGraph::TIMER | FrameTaskGraph::SCENE, FrameTaskGraph::PHYSICS | FrameTaskGraph::SCENE, [this]()
 		{
+			DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Physics);
 			const float deltaTime = m_spTimer->GetSecDelta();
 			Modules::Physics->Update(deltaTime);
-		}
+		});
+	}
 
+	// Update() can access anything except the timer and the input which are updated before the stages
+	// Applications can split it into smaller stages with narrower resources by overriding this function
+	taskGraph.AddMainThreadStage("Update", FrameTaskGraph::ALL_RESOURCES, FrameTaskGraph::ALL_RESOURCES & ~(FrameTaskGraph::TIMER | FrameTaskGraph::INPUT), [this]()
+	{
+		DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Application);
 		Update();
+	});
+}
+
+void Application::UpdateScene()
+{
+	// The world matrices are updated in one batch instead of lazily during the visibility tests and the extraction
+	// The levels of the hierarchies are split between the threads of the job system when a lot of transforms are dirty
+	Object::UpdateAllWorldMatricesParallel();
 
-		MemorySystem::ResetScratchAllocator();
+	if(m_spSceneManager != nullptr)
+	{
+		m_spSceneManager->Update();
 	}
+}
 
-	Kill();
+void Application::ExtractRenderState(FrameRenderState& renderState)
+{
+	if(m_spSceneManager == nullptr)
+	{
+		return;
+	}
+
+	m_spSceneManager->ExtractRenderState(renderState);
+}
+
+void Application::RenderFrame(const FrameRenderState& renderState)
+{
+	// Applications which don't extract anything are rendering inside Update()
+	if(renderState.IsEmpty())
+	{
+		return;
+	}
+
+	Modules::Render->BeginFrame(*m_spMainWindow);
+	renderState.Submit(*Modules::Render);
+	Modules::Render->EndFrame();
+}
+
+void Application::RenderFrameSerial()
+{
+	FrameRenderState& renderState = m_renderStates[0];
+	ExtractRenderState(renderState);
+	{
+		DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Render);
+		RenderFrame(renderState);
+	}
+	renderState.Clear();
+
+	MemorySystem::ResetScratchAllocator();
+	MemorySystem::AdvanceFrameAllocator();
+}
+
+void Application::RenderFramePipelined()
+{
+	// Extract into the render state which is not used by the render thread (it was cleared after it was rendered)
+	FrameRenderState& renderState = m_renderStates[m_renderStateIdx];
+	ExtractRenderState(renderState);
+
+	// The scratch allocator can be reset only when both the simulation and the previous frame on the render thread are done with it
+	m_spRenderThread->WaitForIdle();
+	MemorySystem::ResetScratchAllocator();
+
+	// The frame allocations of this frame stay valid for the render thread, which allocates from the next frame
+	MemorySystem::AdvanceFrameAllocator();
+
+	m_spRenderThread->Run([this, &renderState]()
+	{
+		DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Render);
+		RenderFrame(renderState);
+
+		// The renderables released by the simulation are destroyed here, because it unbinds them from the render module
+		renderState.Clear();
+	});
+
+	m_renderStateIdx ^= 1;
+}
+
+void Application::ExecuteOnRenderThread(const std::function<void()>& func)
+{
+	if(m_spRenderThread != nullptr)
+	{
+		m_spRenderThread->Run(func);
+		m_spRenderThread->WaitForIdle();
+	}
+	else
+	{
+		func();
+	}
 }
 
 Application::CreationParams Application::GetCreationParams(int32_t argc, const char* const* ppArgv)
@@ -134,6 +295,7 @@ Application::CreationParams Application::GetCreationParams(int32_t argc, const c
 
 void Application::CreateModules()
 {
+	Modules::JobSystem = std::make_unique<JobSystem>();
 	Modules::Input = std::make_unique<Input>();
 
 	if(s_physicsFactory != nullptr)
@@ -170,4 +332,5 @@ void Application::DestroyModules()
 	Modules::Render = nullptr;
 	Modules::Physics = nullptr;
 	Modules::Input = nullptr;
+	Modules::JobSystem = nullptr;
 }
@@ -2,11 +2,15 @@
 
 #include "Engine/Application/OSWindowCreationParams.h"
 #include "Engine/Core/Factory.h"
+#include "Engine/Core/Job/FrameTaskGraph.h"
+#include "Engine/Render/FrameRenderState.h"
 
 class CoreAppEvent;
+class ISceneManager;
 class OSWindow;
 class Physics;
 class Render;
+class RenderThread;
 class ResourceManager;
 class ScriptSystem;
 class SoundSystem;
@@ -29,6 +33,7 @@ public:
 
 	const Timer* GetTimer() const;
 	ResourceManager& GetResourceManager();
+	const FrameTaskGraph& GetFrameTaskGraph() const;
 
 	virtual void SendEvent(EAppEventType eventType, const void* pUserData = nullptr);
 
@@ -36,6 +41,22 @@ public:
 	virtual void Kill() = 0;
 	virtual void Update() = 0;
 
+	// Called once after Init() to add the stages which are executed every frame
+	// The default stages are updating the script system and physics then calling Update() on the main thread (these are
+	// serial, because all of them are accessing the scene)
+	// The scene update (world matrices and visibility) is added as the last stage after this
+	// The critical path of each frame can be profiled by setting FrameTaskGraph::SetCriticalPathCallback() here
+	virtual void SetupFrameTaskGraph(FrameTaskGraph& taskGraph);
+
+	// Called after Update() and the scene update (world matrices and visibility) to copy everything which is needed to render the frame
+	// By default the visible render components are extracted from the scene manager
+	virtual void ExtractRenderState(FrameRenderState& renderState);
+	// Called with the extracted state of the frame, by default it is submitted to the render module when it is not empty.
+	// In pipelined mode this runs on the render thread in parallel with the simulation of the next frame, so it must not access
+	// anything other than the render state and the render module. The render module must not be used from anywhere else then,
+	// except for unbinding the resources (their render data is released on the render thread at the beginning of its next frame).
+	virtual void RenderFrame(const FrameRenderState& renderState);
+
 	static int32_t Start(int32_t argc, const char* const* ppArgv);
 	static void Stop(int32_t returnValue = 0);
 
@@ -43,14 +64,20 @@ protected:
 	struct CreationParams
 	{
 		OSWindowCreationParams windowParams;
+		bool isPipelinedRenderingEnabled = false;
 	};
 
 	std::unique_ptr<Timer> m_spTimer;
 	std::unique_ptr<ResourceManager> m_spResourceManager;
 	std::unique_ptr<OSWindow> m_spMainWindow;
+	std::unique_ptr<ISceneManager> m_spSceneManager;
 
 private:
 	void Run();
+	void UpdateScene();
+	void RenderFrameSerial();
+	void RenderFramePipelined();
+	void ExecuteOnRenderThread(const std::function<void()>& func);
 
 	virtual CreationParams GetCreationParams(int32_t argc, const char* const* ppArgv);
 
@@ -65,6 +92,13 @@ private:
 	static const Factory<SoundSystem>::Func_t s_soundSystemFactory;
 	static const Factory<UI>::Func_t s_uiFactory;
 
+	FrameTaskGraph m_frameTaskGraph;
+
+	// Double-buffered render state: one is extracted while the other can be still rendered in pipelined mode
+	FrameRenderState m_renderStates[2];
+	uint32_t m_renderStateIdx = 0;
+	std::unique_ptr<RenderThread> m_spRenderThread;	// Only created in pipelined mode
+
 	static bool s_isMainLoopRunning;
 	static int32_t s_returnValue;
 };
@@ -3,6 +3,7 @@
 
 #include "Engine/Core/FS/FileSystem.h"
 #include "Engine/Core/FS/IReadFile.h"
+#include "Engine/Core/Memory/MemorySystem.h"
 #include "Engine/Core/Object.h"
 #include "Engine/Core/String/StackString.h"
 
@@ -27,16 +28,12 @@ std::unique_ptr<Object> ResourceManager::CreateObjectFromFile(const String& file
 
 std::shared_ptr<Shader> ResourceManager::GetShader(const String& filename, const String& defines)
 {
-	DynamicString shaderNameWithDefines;
-	shaderNameWithDefines.Reserve(filename.Length() + 1 + defines.Length());
-	shaderNameWithDefines += filename;
-	shaderNameWithDefines += "|";
-	shaderNameWithDefines += defines;
-
-	auto it = m_loadedShaders.find(shaderNameWithDefines);
-	if(it != m_loadedShaders.end() && !it->second.expired())
+	static const String kSeparator = "|";
+	const HashedString key = HashedString::FromConcatenation({ &filename, &kSeparator, &defines });
+	std::weak_ptr<Shader>* pLoadedShader = m_loadedShaders.Find(key);
+	if(pLoadedShader != nullptr && !pLoadedShader->expired())
 	{
-		return it->second.lock();
+		return pLoadedShader->lock();
 	}
 
 	std::shared_ptr<Shader> spShader = LoadShader(filename);
@@ -45,13 +42,13 @@ std::shared_ptr<Shader> ResourceManager::GetShader(const String& filename, const
 		spShader = std::make_unique<Shader>(filename);
 	}
 
-	if(it != m_loadedShaders.end())
+	if(pLoadedShader != nullptr)
 	{
-		it->second = spShader;
+		*pLoadedShader = spShader;
 	}
 	else
 	{
-		m_loadedShaders.emplace(std::move(shaderNameWithDefines), spShader);
+		m_loadedShaders.Insert(key, spShader);
 	}
 
 	return spShader;
@@ -59,10 +56,11 @@ std::shared_ptr<Shader> ResourceManager::GetShader(const String& filename, const
 
 std::shared_ptr<Texture> ResourceManager::GetTexture(const String& filename)
 {
-	auto it = m_loadedTextures.find(filename);
-	if(it != m_loadedTextures.end() && !it->second.expired())
+	const HashedString key(filename);
+	std::weak_ptr<Texture>* pLoadedTexture = m_loadedTextures.Find(key);
+	if(pLoadedTexture != nullptr && !pLoadedTexture->expired())
 	{
-		return it->second.lock();
+		return pLoadedTexture->lock();
 	}
 
 	std::shared_ptr<Texture> spTexture = LoadTexture(filename);
@@ -71,13 +69,13 @@ std::shared_ptr<Texture> ResourceManager::GetTexture(const String& filename)
 		spTexture = m_spErrorTexture;
 	}
 
-	if(it != m_loadedTextures.end())
+	if(pLoadedTexture != nullptr)
 	{
-		it->second = spTexture;
+		*pLoadedTexture = spTexture;
 	}
 	else
 	{
-		m_loadedTextures.emplace(filename, spTexture);
+		m_loadedTextures.Insert(key, spTexture);
 	}
 
 	return spTexture;
@@ -85,13 +83,13 @@ std::shared_ptr<Texture> ResourceManager::GetTexture(const String& filename)
 
 void ResourceManager::ReloadTexture(const String& filename)
 {
-	auto it = m_loadedTextures.find(filename);
-	if(it == m_loadedTextures.end())
+	std::weak_ptr<Texture>* pLoadedTexture = m_loadedTextures.Find(filename);
+	if(pLoadedTexture == nullptr)
 	{
 		return;
 	}
 
-	std::shared_ptr<Texture> spTexture = it->second.lock();
+	std::shared_ptr<Texture> spTexture = pLoadedTexture->lock();
 	if(spTexture)
 	{
 		std::unique_ptr<Texture> spNewTexture = LoadTexture(filename);
@@ -108,28 +106,35 @@ void ResourceManager::ReloadTexture(const String& filename)
 
 void ResourceManager::ReloadShader(const String& filename)
 {
-	for(auto& pair : m_loadedShaders)
+	// The shaders are loaded with different defines under different keys
+	m_loadedShaders.ForEach([this, &filename](std::weak_ptr<Shader>& loadedShader)
 	{
-		std::shared_ptr<Shader> spShader = pair.second.lock();
+		std::shared_ptr<Shader> spShader = loadedShader.lock();
 		if(spShader && spShader->m_name == filename)
 		{
-			Modules::Render->Unbind(*spShader);
-
-			std::unique_ptr<Shader> spNewShader = LoadShader(filename);
-			if(spNewShader)
-			{
-				spShader->m_data = std::move(spNewShader->m_data);
-			}
-			else
+			// The shader can be in use by the render thread, so it is only replaced there
+			std::shared_ptr<Shader> spNewShader = LoadShader(filename);
+			Modules::Render->RunOnOwnerThread([spShader, spNewShader]()
 			{
-				spShader->m_data = MemoryBuffer();
-			}
+				Modules::Render->Unbind(*spShader);
+
+				if(spNewShader)
+				{
+					spShader->m_data = std::move(spNewShader->m_data);
+				}
+				else
+				{
+					spShader->m_data = MemoryBuffer();
+				}
+			});
 		}
-	}
+	});
 }
 
 std::unique_ptr<Object> ResourceManager::LoadObject(const String& filename)
 {
+	DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Resource);
+
 	for(ObjectLoaderFunc_t loaderFunc : s_objectLoaders)
 	{
 		std::unique_ptr<Object> spObject = loaderFunc(filename);
@@ -145,6 +150,8 @@ std::unique_ptr<Object> ResourceManager::LoadObject(const String& filename)
 
 std::unique_ptr<Shader> ResourceManager::LoadShader(const String& filename)
 {
+	DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Resource);
+
 	StackString<DESIRE_MAX_PATH_LEN> filenameWithPath;
 	Modules::Render->AppendShaderFilenameWithPath(filenameWithPath, filename);
 
@@ -169,6 +176,8 @@ std::unique_ptr<Shader> ResourceManager::LoadShader(const String& filename)
 
 std::unique_ptr<Texture> ResourceManager::LoadTexture(const String& filename)
 {
+	DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Resource);
+
 	ReadFilePtr spFile = FileSystem::Get().Open(filename);
 	if(spFile)
 	{
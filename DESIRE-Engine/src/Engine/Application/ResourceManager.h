@@ -2,10 +2,9 @@
 
 #include "Engine/Core/FS/FilePtr_fwd.h"
 #include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/HashedStringMap.h"
 #include "Engine/Core/String/DynamicString.h"
 
-#include <map>
-
 class Object;
 class Shader;
 class Texture;
@@ -34,8 +33,8 @@ private:
 
 	void CreateErrorTexture();
 
-	std::map<DynamicString, std::weak_ptr<Shader>> m_loadedShaders;
-	std::map<DynamicString, std::weak_ptr<Texture>> m_loadedTextures;
+	HashedStringMap<std::weak_ptr<Shader>> m_loadedShaders;
+	HashedStringMap<std::weak_ptr<Texture>> m_loadedTextures;
 
 	std::shared_ptr<Texture> m_spErrorTexture;
 
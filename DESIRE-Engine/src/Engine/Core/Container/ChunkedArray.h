@@ -0,0 +1,208 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	ChunkedArray stores its elements in fixed-size chunks, so growing never moves the existing elements and pointers to
+//	them remain valid. Only RemoveFast() moves an element: the last one is moved into the place of the removed one.
+//	The chunks are kept allocated until the ChunkedArray is destroyed.
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename T, size_t CHUNK_SIZE = 64>
+class ChunkedArray
+{
+	static_assert(CHUNK_SIZE > 0 && (CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "CHUNK_SIZE must be a power of two");
+
+public:
+	template<typename ArrayType, typename ValueType>
+	class Iterator
+	{
+	public:
+		Iterator(ArrayType& array, size_t idx)
+			: m_array(array)
+			, m_idx(idx)
+		{
+		}
+
+		ValueType& operator *() const						{ return m_array.GetAt(m_idx); }
+		ValueType* operator ->() const						{ return &m_array.GetAt(m_idx); }
+		Iterator& operator ++()								{ m_idx++; return *this; }
+		bool operator ==(const Iterator& other) const		{ return (m_idx == other.m_idx); }
+		bool operator !=(const Iterator& other) const		{ return (m_idx != other.m_idx); }
+
+	private:
+		ArrayType& m_array;
+		size_t m_idx;
+	};
+
+	ChunkedArray()
+	{
+	}
+
+	ChunkedArray(ChunkedArray&& otherArray)
+	{
+		Swap(otherArray);
+	}
+
+	~ChunkedArray()
+	{
+		Clear();
+
+		for(T* pChunk : m_chunks)
+		{
+			MemorySystem::Free(pChunk);
+		}
+	}
+
+	ChunkedArray& operator =(ChunkedArray&& otherArray)
+	{
+		Swap(otherArray);
+		return *this;
+	}
+
+	// Element access
+	T& operator [](size_t idx)					{ return GetAt(idx); }
+	const T& operator [](size_t idx) const		{ return GetAt(idx); }
+
+	T& GetAt(size_t idx)						{ ASSERT(idx < m_size); return m_chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; }
+	const T& GetAt(size_t idx) const			{ ASSERT(idx < m_size); return m_chunks[idx / CHUNK_SIZE][idx % CHUNK_SIZE]; }
+
+	T& GetFirst()								{ return GetAt(0); }
+	const T& GetFirst() const					{ return GetAt(0); }
+
+	T& GetLast()								{ return GetAt(m_size - 1); }
+	const T& GetLast() const					{ return GetAt(m_size - 1); }
+
+	// Iterators for supporting range-based for loop
+	Iterator<ChunkedArray, T> begin()							{ return Iterator<ChunkedArray, T>(*this, 0); }
+	Iterator<const ChunkedArray, const T> begin() const			{ return Iterator<const ChunkedArray, const T>(*this, 0); }
+	Iterator<ChunkedArray, T> end()								{ return Iterator<ChunkedArray, T>(*this, m_size); }
+	Iterator<const ChunkedArray, const T> end() const			{ return Iterator<const ChunkedArray, const T>(*this, m_size); }
+
+	// Calls 'func' with the pointer and the number of elements of each used chunk
+	template<typename Func>
+	void ForEachChunk(const Func& func)
+	{
+		for(size_t firstIdx = 0; firstIdx < m_size; firstIdx += CHUNK_SIZE)
+		{
+			func(m_chunks[firstIdx / CHUNK_SIZE], std::min(CHUNK_SIZE, m_size - firstIdx));
+		}
+	}
+
+	// Calls 'func' for every element, iterating chunk by chunk
+	template<typename Func>
+	void ForEach(const Func& func)
+	{
+		ForEachChunk([&func](T* pElements, size_t numElements)
+		{
+			for(size_t i = 0; i < numElements; ++i)
+			{
+				func(pElements[i]);
+			}
+		});
+	}
+
+	// Capacity
+	bool IsEmpty() const						{ return (m_size == 0); }
+	size_t Size() const							{ return m_size; }
+	size_t GetReservedSize() const				{ return m_chunks.Size() * CHUNK_SIZE; }
+
+	void Reserve(size_t newReservedSize)
+	{
+		while(GetReservedSize() < newReservedSize)
+		{
+			m_chunks.Add(static_cast<T*>(MemorySystem::Alloc(CHUNK_SIZE * sizeof(T), std::max(alignof(T), MemorySystem::kDefaultAlignment))));
+		}
+	}
+
+	// Erases all elements from the ChunkedArray, but doesn't free its memory
+	void Clear()
+	{
+		ForEach([](T& element)
+		{
+			element.~T();
+		});
+
+		m_size = 0;
+	}
+
+	T& Add(const T& value)
+	{
+		return EmplaceAdd(value);
+	}
+
+	T& Add(T&& value)
+	{
+		return EmplaceAdd(std::move(value));
+	}
+
+	template<class... Args>
+	T& EmplaceAdd(Args&&... args)
+	{
+		Reserve(m_size + 1);
+		T* pElement = &m_chunks[m_size / CHUNK_SIZE][m_size % CHUNK_SIZE];
+		new(pElement) T(std::forward<Args>(args)...);
+		m_size++;
+		return *pElement;
+	}
+
+	size_t Find(const T& value) const
+	{
+		for(size_t i = 0; i < m_size; ++i)
+		{
+			if(GetAt(i) == value)
+			{
+				return i;
+			}
+		}
+
+		return SIZE_MAX;
+	}
+
+	// Removes an element by moving the last element into its place and calling RemoveLast()
+	// Note: This function does not preserve the order of elements
+	bool RemoveFast(const T& value)
+	{
+		const size_t idx = Find(value);
+		if(idx != SIZE_MAX)
+		{
+			RemoveFastAt(idx);
+			return true;
+		}
+
+		return false;
+	}
+
+	void RemoveFastAt(size_t idx)
+	{
+		if(idx != m_size - 1)
+		{
+			GetAt(idx) = std::move(GetLast());
+		}
+
+		RemoveLast();
+	}
+
+	void RemoveLast()
+	{
+		if(!IsEmpty())
+		{
+			GetLast().~T();
+			m_size--;
+		}
+	}
+
+	void Swap(ChunkedArray& otherArray)
+	{
+		m_chunks.Swap(otherArray.m_chunks);
+		std::swap(m_size, otherArray.m_size);
+	}
+
+	ChunkedArray(const ChunkedArray&) = delete;
+	ChunkedArray& operator =(const ChunkedArray&) = delete;
+
+private:
+	Array<T*> m_chunks;
+	size_t m_size = 0;
+};
@@ -1,11 +1,14 @@
 #pragma once
 
-#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Math/math.h"
+#include "Engine/Core/Memory/MemorySystem.h"
 #include "Engine/Core/String/HashedString.h"
 
 // --------------------------------------------------------------------------------------------------------------------
-//	HashedStringMap is a sorted associative container that contains key-value pairs with unique HashedString keys.
-//  Note: In case of a collision, the element is dropped
+//	HashedStringMap is an associative container that contains key-value pairs with unique HashedString keys.
+//	It is a flat open addressing hash table with linear probing where each slot has a control byte (empty or 7 bits of
+//	the hash). The lookup compares the control bytes of 16 slots at once with SIMD, so the keys are compared only for
+//	the slots where the 7 bits match. Removal shifts the following elements backwards, so there are no tombstones.
 // --------------------------------------------------------------------------------------------------------------------
 
 template<typename T>
@@ -18,74 +21,312 @@ public:
 
 	HashedStringMap(HashedStringMap&& otherMap)
 	{
-		m_elements.Swap(otherMap.m_elements);
+		Swap(otherMap);
 	}
 
 	HashedStringMap(std::initializer_list<std::pair<HashedString, T>> initList)
 	{
+		Reserve(initList.size());
 		for(const std::pair<HashedString, T>& pair : initList)
 		{
 			Insert(pair.first, pair.second);
 		}
 	}
 
+	~HashedStringMap()
+	{
+		Clear();
+		MemorySystem::Free(m_pControlBytes);
+		MemorySystem::Free(m_pSlots);
+	}
+
 	HashedStringMap& operator =(HashedStringMap&& otherMap)
 	{
-		m_elements.Swap(otherMap.m_elements);
+		Swap(otherMap);
 		return *this;
 	}
 
 	T& Insert(HashedString key, const T& value)
 	{
-		ASSERT(Find(key) == nullptr && "An other value is already added with this key");
-		return m_elements.BinaryFindOrInsert(KeyValuePair(key, value)).value;
+		return Emplace(key, value);
+	}
+
+	T& Insert(HashedString key, T&& value)
+	{
+		return Emplace(key, std::move(value));
 	}
 
 	T* Find(HashedString key)
 	{
-		const size_t idx = m_elements.BinaryFind(key);
-		return (idx != SIZE_MAX) ? &m_elements[idx].value : nullptr;
+		const size_t idx = FindSlot(key);
+		return (idx != SIZE_MAX) ? &m_pSlots[idx].value : nullptr;
 	}
 
 	const T* Find(HashedString key) const
 	{
-		const size_t idx = m_elements.BinaryFind(key);
-		return (idx != SIZE_MAX) ? &m_elements[idx].value : nullptr;
+		const size_t idx = FindSlot(key);
+		return (idx != SIZE_MAX) ? &m_pSlots[idx].value : nullptr;
+	}
+
+	// Returns false if there is no element with the key
+	bool Remove(HashedString key)
+	{
+		size_t holeIdx = FindSlot(key);
+		if(holeIdx == SIZE_MAX)
+		{
+			return false;
+		}
+
+		m_pSlots[holeIdx].~KeyValuePair();
+		m_numElements--;
+
+		// Shift back the following elements of the probe sequence which can be found from the hole
+		const size_t mask = m_capacity - 1;
+		for(size_t idx = (holeIdx + 1) & mask; m_pControlBytes[idx] != kEmpty; idx = (idx + 1) & mask)
+		{
+			const size_t homeIdx = GetHomeIdx(m_pSlots[idx].key);
+			if(((idx - homeIdx) & mask) >= ((idx - holeIdx) & mask))
+			{
+				new(&m_pSlots[holeIdx]) KeyValuePair(std::move(m_pSlots[idx]));
+				m_pSlots[idx].~KeyValuePair();
+				SetControlByte(holeIdx, m_pControlBytes[idx]);
+				holeIdx = idx;
+			}
+		}
+
+		SetControlByte(holeIdx, kEmpty);
+		return true;
+	}
+
+	// Makes room for 'numElements' without rehashing
+	void Reserve(size_t numElements)
+	{
+		const size_t capacity = std::max(Math::RoundUpToPowerOfTwo(numElements + numElements / 7 + 1), kGroupSize);
+		if(capacity > m_capacity)
+		{
+			Rehash(capacity);
+		}
+	}
+
+	// Calls 'func' for every element in an unspecified order
+	template<typename Func>
+	void ForEach(const Func& func)
+	{
+		for(size_t i = 0; i < m_capacity; ++i)
+		{
+			if(m_pControlBytes[i] != kEmpty)
+			{
+				func(m_pSlots[i].value);
+			}
+		}
 	}
 
 	bool IsEmpty() const
 	{
-		return m_elements.IsEmpty();
+		return (m_numElements == 0);
 	}
 
 	size_t Size() const
 	{
-		return m_elements.Size();
+		return m_numElements;
 	}
 
+	// Removes all the elements, but keeps the allocated memory
 	void Clear()
 	{
-		m_elements.Clear();
+		for(size_t i = 0; i < m_capacity; ++i)
+		{
+			if(m_pControlBytes[i] != kEmpty)
+			{
+				m_pSlots[i].~KeyValuePair();
+			}
+		}
+
+		if(m_pControlBytes != nullptr)
+		{
+			memset(m_pControlBytes, kEmpty, m_capacity + kGroupSize - 1);
+		}
+
+		m_numElements = 0;
 	}
 
+	HashedStringMap(const HashedStringMap&) = delete;
+	HashedStringMap& operator =(const HashedStringMap&) = delete;
+
 private:
+	static constexpr size_t kGroupSize = 16;
+	static constexpr uint8_t kEmpty = 0x80;		// The full slots have the highest bit cleared
+
 	struct KeyValuePair
 	{
 		HashedString key;
 		T value;
 
-		KeyValuePair(HashedString key, const T& value)
+		template<typename V>
+		KeyValuePair(HashedString key, V&& value)
 			: key(key)
-			, value(value)
+			, value(std::forward<V>(value))
 		{
 		}
+	};
 
-		bool operator <(const KeyValuePair& other) const		{ return (key < other.key); }
-		bool operator ==(const KeyValuePair& other) const		{ return (key == other.key); }
+	// Returns the bitmasks of the matching control bytes in the 16 slots starting at 'pControlBytes'
+	struct Group
+	{
+#if DESIRE_USE_SSE
+		__m128i controlBytes;
+
+		Group(const uint8_t* pControlBytes)
+			: controlBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pControlBytes)))
+		{
+		}
+
+		uint32_t Match(uint8_t h2) const	{ return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(controlBytes, _mm_set1_epi8(static_cast<char>(h2))))); }
+		uint32_t MatchEmpty() const			{ return static_cast<uint32_t>(_mm_movemask_epi8(controlBytes)); }
+#else
+		const uint8_t* pControlBytes;
+
+		Group(const uint8_t* pControlBytes)
+			: pControlBytes(pControlBytes)
+		{
+		}
+
+		uint32_t Match(uint8_t h2) const
+		{
+			uint32_t mask = 0;
+			for(uint32_t i = 0; i < kGroupSize; ++i)
+			{
+				mask |= static_cast<uint32_t>(pControlBytes[i] == h2) << i;
+			}
+			return mask;
+		}
 
-		bool operator <(const HashedString& otherKey) const		{ return (key < otherKey); }
-		bool operator ==(const HashedString& otherKey) const	{ return (key == otherKey); }
+		uint32_t MatchEmpty() const			{ return Match(kEmpty); }
+#endif
 	};
 
-	Array<KeyValuePair> m_elements;
+	template<typename V>
+	T& Emplace(HashedString key, V&& value)
+	{
+		const size_t existingIdx = FindSlot(key);
+		if(existingIdx != SIZE_MAX)
+		{
+			ASSERT(false && "An other value is already added with this key");
+			return m_pSlots[existingIdx].value;
+		}
+
+		// Keep the load factor below 7/8
+		if((m_numElements + 1) * 8 > m_capacity * 7)
+		{
+			Rehash(std::max(m_capacity * 2, kGroupSize));
+		}
+
+		const size_t idx = FindEmptySlot(key);
+		new(&m_pSlots[idx]) KeyValuePair(key, std::forward<V>(value));
+		SetControlByte(idx, GetH2(key));
+		m_numElements++;
+		return m_pSlots[idx].value;
+	}
+
+	size_t FindSlot(HashedString key) const
+	{
+		if(m_numElements == 0)
+		{
+			return SIZE_MAX;
+		}
+
+		const uint8_t h2 = GetH2(key);
+		const size_t mask = m_capacity - 1;
+		for(size_t groupIdx = GetHomeIdx(key);; groupIdx = (groupIdx + kGroupSize) & mask)
+		{
+			const Group group(&m_pControlBytes[groupIdx]);
+			for(uint32_t matches = group.Match(h2); matches != 0; matches &= matches - 1)
+			{
+				const size_t idx = (groupIdx + Math::CountTrailingZeros(matches)) & mask;
+				if(m_pSlots[idx].key == key)
+				{
+					return idx;
+				}
+			}
+
+			if(group.MatchEmpty() != 0)
+			{
+				return SIZE_MAX;
+			}
+		}
+	}
+
+	size_t FindEmptySlot(HashedString key) const
+	{
+		const size_t mask = m_capacity - 1;
+		for(size_t groupIdx = GetHomeIdx(key);; groupIdx = (groupIdx + kGroupSize) & mask)
+		{
+			const uint32_t emptySlots = Group(&m_pControlBytes[groupIdx]).MatchEmpty();
+			if(emptySlots != 0)
+			{
+				return (groupIdx + Math::CountTrailingZeros(emptySlots)) & mask;
+			}
+		}
+	}
+
+	void Rehash(size_t newCapacity)
+	{
+		ASSERT(Math::IsPowerOfTwo(newCapacity) && newCapacity >= kGroupSize);
+
+		uint8_t* pOldControlBytes = m_pControlBytes;
+		KeyValuePair* pOldSlots = m_pSlots;
+		const size_t oldCapacity = m_capacity;
+
+		// The first kGroupSize - 1 control bytes are mirrored after the end, so a group can be loaded from any slot
+		m_capacity = newCapacity;
+		m_pControlBytes = static_cast<uint8_t*>(MemorySystem::Alloc(m_capacity + kGroupSize - 1));
+		memset(m_pControlBytes, kEmpty, m_capacity + kGroupSize - 1);
+		m_pSlots = static_cast<KeyValuePair*>(MemorySystem::Alloc(m_capacity * sizeof(KeyValuePair), std::max(alignof(KeyValuePair), MemorySystem::kDefaultAlignment)));
+
+		for(size_t i = 0; i < oldCapacity; ++i)
+		{
+			if(pOldControlBytes[i] != kEmpty)
+			{
+				const size_t idx = FindEmptySlot(pOldSlots[i].key);
+				new(&m_pSlots[idx]) KeyValuePair(std::move(pOldSlots[i]));
+				pOldSlots[i].~KeyValuePair();
+				SetControlByte(idx, pOldControlBytes[i]);
+			}
+		}
+
+		MemorySystem::Free(pOldControlBytes);
+		MemorySystem::Free(pOldSlots);
+	}
+
+	void SetControlByte(size_t idx, uint8_t value)
+	{
+		m_pControlBytes[idx] = value;
+		if(idx < kGroupSize - 1)
+		{
+			m_pControlBytes[m_capacity + idx] = value;
+		}
+	}
+
+	size_t GetHomeIdx(HashedString key) const
+	{
+		return static_cast<size_t>(key.GetHash() >> 7) & (m_capacity - 1);
+	}
+
+	static uint8_t GetH2(HashedString key)
+	{
+		return static_cast<uint8_t>(key.GetHash() & 0x7F);
+	}
+
+	void Swap(HashedStringMap& otherMap)
+	{
+		std::swap(m_pControlBytes, otherMap.m_pControlBytes);
+		std::swap(m_pSlots, otherMap.m_pSlots);
+		std::swap(m_capacity, otherMap.m_capacity);
+		std::swap(m_numElements, otherMap.m_numElements);
+	}
+
+	uint8_t* m_pControlBytes = nullptr;
+	KeyValuePair* m_pSlots = nullptr;
+	size_t m_capacity = 0;
+	size_t m_numElements = 0;
 };
@@ -0,0 +1,355 @@
+#pragma once
+
+#include "Engine/Core/Memory/MemorySystem.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	InlineArray has the same interface as Array, but it stores the first N elements in place and only allocates
+//	memory from the heap when it grows beyond that.
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename T, size_t N>
+class InlineArray
+{
+	static_assert(N > 0, "Use Array instead");
+
+public:
+	InlineArray()
+	{
+	}
+
+	InlineArray(const InlineArray& otherArray)
+	{
+		Reserve(otherArray.Size());
+		for(const T& value : otherArray)
+		{
+			new(&m_pData[m_size++]) T(value);
+		}
+	}
+
+	InlineArray(InlineArray&& otherArray)
+	{
+		MoveFrom(otherArray);
+	}
+
+	InlineArray(std::initializer_list<T> initList)
+	{
+		Reserve(initList.size());
+		for(const T& value : initList)
+		{
+			new(&m_pData[m_size++]) T(value);
+		}
+	}
+
+	~InlineArray()
+	{
+		Clear();
+		FreeHeapMemory();
+	}
+
+	InlineArray& operator =(const InlineArray& otherArray)
+	{
+		if(this != &otherArray)
+		{
+			Clear();
+			Reserve(otherArray.Size());
+			for(const T& value : otherArray)
+			{
+				new(&m_pData[m_size++]) T(value);
+			}
+		}
+
+		return *this;
+	}
+
+	InlineArray& operator =(InlineArray&& otherArray)
+	{
+		if(this != &otherArray)
+		{
+			Clear();
+			FreeHeapMemory();
+			MoveFrom(otherArray);
+		}
+
+		return *this;
+	}
+
+	// Element access
+	T& operator [](size_t idx)					{ ASSERT(idx < m_size); return m_pData[idx]; }
+	const T& operator [](size_t idx) const		{ ASSERT(idx < m_size); return m_pData[idx]; }
+
+	T& GetAt(size_t idx)						{ ASSERT(idx < m_size); return m_pData[idx]; }
+	const T& GetAt(size_t idx) const			{ ASSERT(idx < m_size); return m_pData[idx]; }
+
+	T& GetFirst()								{ return GetAt(0); }
+	const T& GetFirst() const					{ return GetAt(0); }
+
+	T& GetLast()								{ return GetAt(m_size - 1); }
+	const T& GetLast() const					{ return GetAt(m_size - 1); }
+
+	T* Data()									{ return m_pData; }
+	const T* Data() const						{ return m_pData; }
+
+	// Iterators for supporting range-based for loop
+	T* begin()									{ return m_pData; }
+	const T* begin() const						{ return m_pData; }
+	T* end()									{ return m_pData + m_size; }
+	const T* end() const						{ return m_pData + m_size; }
+
+	// Capacity
+	bool IsEmpty() const						{ return (m_size == 0); }
+	size_t Size() const							{ return m_size; }
+	size_t GetReservedSize() const				{ return m_reservedSize; }
+	bool IsUsingInlineStorage() const			{ return (m_pData == GetInlineStorage()); }
+
+	void SetSize(size_t newSize)
+	{
+		Reserve(newSize);
+
+		while(m_size < newSize)
+		{
+			new(&m_pData[m_size++]) T();
+		}
+
+		while(m_size > newSize)
+		{
+			m_pData[--m_size].~T();
+		}
+	}
+
+	void Reserve(size_t newReservedSize)
+	{
+		if(newReservedSize <= m_reservedSize)
+		{
+			return;
+		}
+
+		T* pNewData = static_cast<T*>(MemorySystem::Alloc(newReservedSize * sizeof(T), std::max(alignof(T), MemorySystem::kDefaultAlignment)));
+		for(size_t i = 0; i < m_size; ++i)
+		{
+			new(&pNewData[i]) T(std::move(m_pData[i]));
+			m_pData[i].~T();
+		}
+
+		FreeHeapMemory();
+		m_pData = pNewData;
+		m_reservedSize = newReservedSize;
+	}
+
+	// Erases all elements from the InlineArray, but doesn't free its memory
+	void Clear()
+	{
+		for(size_t i = 0; i < m_size; ++i)
+		{
+			m_pData[i].~T();
+		}
+
+		m_size = 0;
+	}
+
+	void Add(const T& value)
+	{
+		EmplaceAdd(value);
+	}
+
+	void Add(T&& value)
+	{
+		EmplaceAdd(std::move(value));
+	}
+
+	template<class... Args>
+	T& EmplaceAdd(Args&&... args)
+	{
+		GrowIfNecessary();
+		return *new(&m_pData[m_size++]) T(std::forward<Args>(args)...);
+	}
+
+	T& Insert(size_t pos, const T& value)
+	{
+		return Insert(pos, T(value));
+	}
+
+	T& Insert(size_t pos, T&& value)
+	{
+		ASSERT(pos <= m_size);
+
+		EmplaceAdd(std::move(value));
+		std::rotate(begin() + pos, end() - 1, end());
+		return m_pData[pos];
+	}
+
+	size_t Find(const T& value) const
+	{
+		for(size_t i = 0; i < m_size; ++i)
+		{
+			if(m_pData[i] == value)
+			{
+				return i;
+			}
+		}
+
+		return SIZE_MAX;
+	}
+
+	size_t SpecializedFind(std::function<bool(const T&)> compareFunc) const
+	{
+		for(size_t i = 0; i < m_size; ++i)
+		{
+			if(compareFunc(m_pData[i]))
+			{
+				return i;
+			}
+		}
+
+		return SIZE_MAX;
+	}
+
+	// Do a binary search to find the index of a given element. The type U has to be comparable to type T.
+	template<class U>
+	size_t BinaryFind(const U& value) const
+	{
+		const T* pIter = std::lower_bound(begin(), end(), value);
+		return (pIter != end() && *pIter == value) ? (pIter - begin()) : SIZE_MAX;
+	}
+
+	// Do a binary search to find an element by value or insert it into a sorted array
+	T& BinaryFindOrInsert(T&& value)
+	{
+		T* pIter = std::lower_bound(begin(), end(), value);
+		return (pIter != end() && *pIter == value) ? *pIter : Insert(pIter - begin(), std::move(value));
+	}
+
+	T& BinaryFindOrInsert(T&& value, bool(*compareFunc)(const T&, const T&))
+	{
+		T* pIter = std::lower_bound(begin(), end(), value, compareFunc);
+		return (pIter != end() && !compareFunc(value, *pIter)) ? *pIter : Insert(pIter - begin(), std::move(value));
+	}
+
+	bool Remove(const T& value)
+	{
+		const size_t idx = Find(value);
+		if(idx != SIZE_MAX)
+		{
+			RemoveAt(idx);
+			return true;
+		}
+
+		return false;
+	}
+
+	void RemoveAt(size_t idx)
+	{
+		RemoveRangeAt(idx, 1);
+	}
+
+	void RemoveRangeAt(size_t idx, size_t count)
+	{
+		ASSERT(idx < Size());
+
+		count = std::min(count, Size() - idx);
+		std::move(begin() + idx + count, end(), begin() + idx);
+		for(size_t i = m_size - count; i < m_size; ++i)
+		{
+			m_pData[i].~T();
+		}
+		m_size -= count;
+	}
+
+	// Removes an element by replacing it with the last element in the array and calling RemoveLast()
+	// Note: This function does not preserve the order of elements
+	bool RemoveFast(const T& value)
+	{
+		const size_t idx = Find(value);
+		if(idx != SIZE_MAX)
+		{
+			RemoveFastAt(idx);
+			return true;
+		}
+
+		return false;
+	}
+
+	void RemoveFastAt(size_t idx)
+	{
+		std::swap(GetAt(idx), GetLast());
+		RemoveLast();
+	}
+
+	void RemoveLast()
+	{
+		if(!IsEmpty())
+		{
+			m_pData[--m_size].~T();
+		}
+	}
+
+	void Swap(InlineArray& otherArray)
+	{
+		if(!IsUsingInlineStorage() && !otherArray.IsUsingInlineStorage())
+		{
+			std::swap(m_pData, otherArray.m_pData);
+			std::swap(m_size, otherArray.m_size);
+			std::swap(m_reservedSize, otherArray.m_reservedSize);
+			return;
+		}
+
+		InlineArray tmp(std::move(otherArray));
+		otherArray = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+private:
+	static constexpr size_t kMaxReservedSizeIncrement = 1024;
+
+	void GrowIfNecessary()
+	{
+		if(m_size == m_reservedSize)
+		{
+			const size_t newReservedSize = (m_reservedSize < kMaxReservedSizeIncrement) ? (m_reservedSize << 1) : (m_reservedSize + kMaxReservedSizeIncrement);
+			Reserve(newReservedSize);
+		}
+	}
+
+	// Takes over the heap memory of 'otherArray' or moves its inline elements, leaving it empty
+	void MoveFrom(InlineArray& otherArray)
+	{
+		if(otherArray.IsUsingInlineStorage())
+		{
+			m_pData = GetInlineStorage();
+			m_reservedSize = N;
+			m_size = 0;
+			for(T& value : otherArray)
+			{
+				new(&m_pData[m_size++]) T(std::move(value));
+			}
+			otherArray.Clear();
+		}
+		else
+		{
+			m_pData = otherArray.m_pData;
+			m_size = otherArray.m_size;
+			m_reservedSize = otherArray.m_reservedSize;
+
+			otherArray.m_pData = otherArray.GetInlineStorage();
+			otherArray.m_size = 0;
+			otherArray.m_reservedSize = N;
+		}
+	}
+
+	void FreeHeapMemory()
+	{
+		if(!IsUsingInlineStorage())
+		{
+			MemorySystem::Free(m_pData);
+			m_pData = GetInlineStorage();
+			m_reservedSize = N;
+		}
+	}
+
+	T* GetInlineStorage()						{ return reinterpret_cast<T*>(m_inlineStorage); }
+	const T* GetInlineStorage() const			{ return reinterpret_cast<const T*>(m_inlineStorage); }
+
+	T* m_pData = GetInlineStorage();
+	size_t m_size = 0;
+	size_t m_reservedSize = N;
+	alignas(T) uint8_t m_inlineStorage[N * sizeof(T)];
+};
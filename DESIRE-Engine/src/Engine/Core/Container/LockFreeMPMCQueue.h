@@ -0,0 +1,127 @@
+#pragma once
+
+// --------------------------------------------------------------------------------------------------------------------
+//	LockFreeMPMCQueue is a bounded multiple producer and multiple consumer queue without locks.
+//	Every slot has a sequence number which tells whether it is ready to be written or read in the current lap.
+//	Note that SIZE has to be a power of two.
+//	https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename T, uint32_t SIZE>
+class LockFreeMPMCQueue
+{
+public:
+	LockFreeMPMCQueue()
+	{
+		static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SIZE has to be a power of two");
+
+		for(size_t i = 0; i < SIZE; ++i)
+		{
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// Add new element at the end of the queue
+	// The content of value is copied to the new element
+	bool Push(const T& value)
+	{
+		return PushInternal(value);
+	}
+
+	// Add new element at the end of the queue
+	// The content of value is moved to the new element
+	bool Push(T&& value)
+	{
+		return PushInternal(std::move(value));
+	}
+
+	// Remove the next element in the queue by moving it to the given variable
+	bool Pop(T& value)
+	{
+		size_t pos = m_readPos.load(std::memory_order_relaxed);
+		Cell* pCell = nullptr;
+		for(;;)
+		{
+			pCell = &m_cells[pos & kIndexMask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+			if(diff == 0)
+			{
+				if(m_readPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if(diff < 0)
+			{
+				// The queue is empty
+				return false;
+			}
+			else
+			{
+				// An other consumer was faster
+				pos = m_readPos.load(std::memory_order_relaxed);
+			}
+		}
+
+		value = std::move(pCell->data);
+		pCell->sequence.store(pos + SIZE, std::memory_order_release);
+		return true;
+	}
+
+	// Returns true if there is no element in the queue (the result is only a snapshot when other threads are accessing the queue)
+	bool IsEmpty() const
+	{
+		return m_readPos.load(std::memory_order_relaxed) >= m_writePos.load(std::memory_order_relaxed);
+	}
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(LockFreeMPMCQueue)
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	template<typename U>
+	bool PushInternal(U&& value)
+	{
+		size_t pos = m_writePos.load(std::memory_order_relaxed);
+		Cell* pCell = nullptr;
+		for(;;)
+		{
+			pCell = &m_cells[pos & kIndexMask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+			if(diff == 0)
+			{
+				if(m_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if(diff < 0)
+			{
+				// The queue is full
+				return false;
+			}
+			else
+			{
+				// An other producer was faster
+				pos = m_writePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		pCell->data = std::forward<U>(value);
+		pCell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	static constexpr size_t kIndexMask = SIZE - 1;
+
+	// The positions are on separate cache lines as they are written by different threads
+	alignas(DESIRE_CACHE_LINE_SIZE) Cell m_cells[SIZE];
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<size_t> m_writePos = 0;
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<size_t> m_readPos = 0;
+};
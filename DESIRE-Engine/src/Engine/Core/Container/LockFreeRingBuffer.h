@@ -3,6 +3,8 @@
 // --------------------------------------------------------------------------------------------------------------------
 //	LockFreeRingBuffer is a one producer and one consumer queue without locks.
 //	Note that the number of element slots in the buffer is actually (SIZE - 1).
+//	Both sides keep a cached copy of the other side's index, so the shared cache lines are only touched when the buffer
+//	looks full (producer) or empty (consumer).
 // --------------------------------------------------------------------------------------------------------------------
 
 template<typename T, uint32_t SIZE>
@@ -10,8 +12,6 @@ class LockFreeRingBuffer
 {
 public:
 	LockFreeRingBuffer()
-		: m_readIdx(0)
-		, m_writeIdx(0)
 	{
 		static_assert(SIZE >= 2);
 	}
@@ -21,14 +21,19 @@ public:
 
 	// Add new element at the end of the buffer, after its current last element
 	// The content of value is copied to the new element
-	bool push(const T& value)
+	bool Push(const T& value)
 	{
 		const uint32_t currWrite = m_writeIdx.load(std::memory_order_relaxed);
-		const uint32_t nextIdx = (currWrite + 1) % SIZE;
-		if(nextIdx == m_readIdx.load(std::memory_order_acquire))
+		const uint32_t nextIdx = GetNextIdx(currWrite);
+		if(nextIdx == m_cachedReadIdx)
 		{
-			// The buffer is full
-			return false;
+			// The buffer looked full the last time, refresh the read index from the consumer
+			m_cachedReadIdx = m_readIdx.load(std::memory_order_acquire);
+			if(nextIdx == m_cachedReadIdx)
+			{
+				// The buffer is full
+				return false;
+			}
 		}
 
 		m_data[currWrite] = value;
@@ -38,14 +43,19 @@ public:
 
 	// Add new element at the end of the buffer, after its current last element
 	// The content of value is moved to the new element
-	bool push(T&& value)
+	bool Push(T&& value)
 	{
 		const uint32_t currWrite = m_writeIdx.load(std::memory_order_relaxed);
-		const uint32_t nextIdx = (currWrite + 1) % SIZE;
-		if(nextIdx == m_readIdx.load(std::memory_order_acquire))
+		const uint32_t nextIdx = GetNextIdx(currWrite);
+		if(nextIdx == m_cachedReadIdx)
 		{
-			// The buffer is full
-			return false;
+			// The buffer looked full the last time, refresh the read index from the consumer
+			m_cachedReadIdx = m_readIdx.load(std::memory_order_acquire);
+			if(nextIdx == m_cachedReadIdx)
+			{
+				// The buffer is full
+				return false;
+			}
 		}
 
 		m_data[currWrite] = std::move(value);
@@ -54,23 +64,28 @@ public:
 	}
 
 	// Remove the next element in the buffer by moving it to the given variable
-	bool pop(T& value)
+	bool Pop(T& value)
 	{
 		const uint32_t currRead = m_readIdx.load(std::memory_order_relaxed);
-		if(currRead == m_writeIdx.load(std::memory_order_acquire))
+		if(currRead == m_cachedWriteIdx)
 		{
-			// The buffer is empty
-			return false;
+			// The buffer looked empty the last time, refresh the write index from the producer
+			m_cachedWriteIdx = m_writeIdx.load(std::memory_order_acquire);
+			if(currRead == m_cachedWriteIdx)
+			{
+				// The buffer is empty
+				return false;
+			}
 		}
 
-		const uint32_t nextIdx = (currRead + 1) % SIZE;
+		const uint32_t nextIdx = GetNextIdx(currRead);
 		value = std::move(m_data[currRead]);
 		m_readIdx.store(nextIdx, std::memory_order_release);
 		return true;
 	}
 
 	// Returns true if there is no element in the buffer
-	bool empty() const
+	bool IsEmpty() const
 	{
 		return m_readIdx.load(std::memory_order_consume) == m_writeIdx.load(std::memory_order_consume);
 	}
@@ -78,8 +93,18 @@ public:
 private:
 	DESIRE_NO_COPY_AND_MOVE(LockFreeRingBuffer)
 
+	static uint32_t GetNextIdx(uint32_t idx)
+	{
+		return (idx + 1 == SIZE) ? 0 : idx + 1;
+	}
+
 	T m_data[SIZE];
 
-	std::atomic<uint32_t> m_readIdx;
-	std::atomic<uint32_t> m_writeIdx;
+	// Consumer side
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<uint32_t> m_readIdx = 0;
+	uint32_t m_cachedWriteIdx = 0;
+
+	// Producer side
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<uint32_t> m_writeIdx = 0;
+	uint32_t m_cachedReadIdx = 0;
 };
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	SlotMap is a container with O(1) insertion, removal and lookup through stable handles.
+//	The elements are stored densely in an Array, so iterating them is as fast as iterating an Array. Each element has
+//	a slot which stores its current index and a generation counter, so a handle to a removed element is detected even
+//	when its slot has been reused.
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename T>
+class SlotMap
+{
+public:
+	struct Handle
+	{
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator ==(const Handle& other) const	{ return index == other.index && generation == other.generation; }
+		bool operator !=(const Handle& other) const	{ return !(*this == other); }
+	};
+
+	SlotMap()
+	{
+	}
+
+	Handle Add(const T& value)
+	{
+		return Emplace(value);
+	}
+
+	Handle Add(T&& value)
+	{
+		return Emplace(std::move(value));
+	}
+
+	template<class... Args>
+	Handle Emplace(Args&&... args)
+	{
+		uint32_t slotIdx = m_firstFreeSlotIdx;
+		if(slotIdx != UINT32_MAX)
+		{
+			m_firstFreeSlotIdx = m_slots[slotIdx].elementIdx;
+		}
+		else
+		{
+			slotIdx = static_cast<uint32_t>(m_slots.Size());
+			m_slots.Add(Slot());
+		}
+
+		Slot& slot = m_slots[slotIdx];
+		slot.elementIdx = static_cast<uint32_t>(m_elements.Size());
+		slot.generation++;
+		ASSERT(IsAlive(slot));
+
+		m_elements.EmplaceAdd(std::forward<Args>(args)...);
+		m_elementSlotIndices.Add(slotIdx);
+
+		return Handle{ slotIdx, slot.generation };
+	}
+
+	// Removes the element by moving the last element into its place
+	// Note: This function does not preserve the order of elements
+	bool Remove(Handle handle)
+	{
+		const uint32_t elementIdx = ReleaseSlot(handle);
+		if(elementIdx == UINT32_MAX)
+		{
+			return false;
+		}
+
+		const uint32_t lastElementIdx = static_cast<uint32_t>(m_elements.Size() - 1);
+		if(elementIdx != lastElementIdx)
+		{
+			m_slots[m_elementSlotIndices[lastElementIdx]].elementIdx = elementIdx;
+		}
+
+		m_elements.RemoveFastAt(elementIdx);
+		m_elementSlotIndices.RemoveFastAt(elementIdx);
+		return true;
+	}
+
+	// Removes the element by shifting down the elements after it, so the iteration order is preserved (this is O(n))
+	bool RemoveKeepOrder(Handle handle)
+	{
+		const uint32_t elementIdx = ReleaseSlot(handle);
+		if(elementIdx == UINT32_MAX)
+		{
+			return false;
+		}
+
+		m_elements.RemoveAt(elementIdx);
+		m_elementSlotIndices.RemoveAt(elementIdx);
+
+		const size_t numElements = m_elements.Size();
+		for(size_t i = elementIdx; i < numElements; ++i)
+		{
+			m_slots[m_elementSlotIndices[i]].elementIdx--;
+		}
+
+		return true;
+	}
+
+	// Returns nullptr if the handle is invalid or its element has been removed
+	T* Get(Handle handle)
+	{
+		const uint32_t elementIdx = GetElementIdx(handle);
+		return (elementIdx != UINT32_MAX) ? &m_elements[elementIdx] : nullptr;
+	}
+
+	const T* Get(Handle handle) const
+	{
+		const uint32_t elementIdx = GetElementIdx(handle);
+		return (elementIdx != UINT32_MAX) ? &m_elements[elementIdx] : nullptr;
+	}
+
+	bool IsValid(Handle handle) const
+	{
+		return (GetElementIdx(handle) != UINT32_MAX);
+	}
+
+	// Iterators for supporting range-based for loop
+	T* begin()									{ return m_elements.begin(); }
+	const T* begin() const						{ return m_elements.begin(); }
+	T* end()									{ return m_elements.end(); }
+	const T* end() const						{ return m_elements.end(); }
+
+	// Capacity
+	bool IsEmpty() const						{ return m_elements.IsEmpty(); }
+	size_t Size() const							{ return m_elements.Size(); }
+
+	void Reserve(size_t numElements)
+	{
+		m_elements.Reserve(numElements);
+		m_elementSlotIndices.Reserve(numElements);
+		m_slots.Reserve(numElements);
+	}
+
+	// Removes all the elements and invalidates all the handles, but doesn't free the memory
+	void Clear()
+	{
+		for(uint32_t slotIdx : m_elementSlotIndices)
+		{
+			Slot& slot = m_slots[slotIdx];
+			slot.generation++;
+			slot.elementIdx = m_firstFreeSlotIdx;
+			m_firstFreeSlotIdx = slotIdx;
+		}
+
+		m_elements.Clear();
+		m_elementSlotIndices.Clear();
+	}
+
+private:
+	struct Slot
+	{
+		uint32_t elementIdx = UINT32_MAX;	// Index of the element, or the next free slot when the slot is not used
+		uint32_t generation = 0;			// Odd generations mark the slots which are in use
+	};
+
+	static bool IsAlive(const Slot& slot)
+	{
+		return (slot.generation & 1) != 0;
+	}
+
+	uint32_t GetElementIdx(Handle handle) const
+	{
+		if(handle.index >= m_slots.Size())
+		{
+			return UINT32_MAX;
+		}
+
+		const Slot& slot = m_slots[handle.index];
+		return (slot.generation == handle.generation && IsAlive(slot)) ? slot.elementIdx : UINT32_MAX;
+	}
+
+	// Puts the slot of the handle into the free list and returns the index of its element
+	uint32_t ReleaseSlot(Handle handle)
+	{
+		const uint32_t elementIdx = GetElementIdx(handle);
+		if(elementIdx == UINT32_MAX)
+		{
+			return UINT32_MAX;
+		}
+
+		Slot& slot = m_slots[handle.index];
+		slot.generation++;
+		slot.elementIdx = m_firstFreeSlotIdx;
+		m_firstFreeSlotIdx = handle.index;
+		return elementIdx;
+	}
+
+	Array<T> m_elements;
+	Array<uint32_t> m_elementSlotIndices;
+	Array<Slot> m_slots;
+	uint32_t m_firstFreeSlotIdx = UINT32_MAX;
+};
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "Engine/Core/Memory/MemorySystem.h"
+
+#include <tuple>
+
+// --------------------------------------------------------------------------------------------------------------------
+//	SoAArray is a structure-of-arrays container where each field is stored in its own stream.
+//	The streams are 32 byte aligned and their reserved size is always a multiple of kNumLanes, so a SIMD kernel can
+//	process GetPaddedSize() elements in full 8-wide batches without handling a remainder. The values in the padding
+//	after Size() are undefined.
+//	Note: Only trivially copyable field types are supported as the streams are moved with memcpy()
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename... Fields>
+class SoAArray
+{
+	static_assert(sizeof...(Fields) > 0, "SoAArray needs at least one field");
+	static_assert((std::is_trivially_copyable_v<Fields> && ...), "SoAArray fields must be trivially copyable");
+
+public:
+	static constexpr size_t kStreamAlignment = 32;
+	static constexpr size_t kNumLanes = 8;
+
+	template<size_t I>
+	using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+	SoAArray()
+	{
+	}
+
+	SoAArray(SoAArray&& otherArray)
+	{
+		Swap(otherArray);
+	}
+
+	~SoAArray()
+	{
+		FreeStreams(m_streams, std::index_sequence_for<Fields...>());
+	}
+
+	SoAArray& operator =(SoAArray&& otherArray)
+	{
+		Swap(otherArray);
+		return *this;
+	}
+
+	// Returns the index of the added element
+	size_t Add(const Fields&... values)
+	{
+		if(m_size == m_reservedSize)
+		{
+			Reserve(m_reservedSize < kMaxReservedSizeIncrement ? std::max(m_reservedSize * 2, kNumLanes) : m_reservedSize + kMaxReservedSizeIncrement);
+		}
+
+		const size_t idx = m_size++;
+		Set(idx, values...);
+		return idx;
+	}
+
+	void Set(size_t idx, const Fields&... values)
+	{
+		ASSERT(idx < m_size);
+		SetElement(idx, std::index_sequence_for<Fields...>(), values...);
+	}
+
+	// Removes an element by replacing it with the last element
+	// Note: This function does not preserve the order of elements
+	void RemoveFastAt(size_t idx)
+	{
+		ASSERT(idx < m_size);
+
+		m_size--;
+		if(idx != m_size)
+		{
+			CopyElement(m_size, idx, std::index_sequence_for<Fields...>());
+		}
+	}
+
+	void RemoveLast()
+	{
+		if(!IsEmpty())
+		{
+			m_size--;
+		}
+	}
+
+	// Stream access
+	template<size_t I>
+	FieldType<I>* GetStream()					{ return std::get<I>(m_streams); }
+	template<size_t I>
+	const FieldType<I>* GetStream() const		{ return std::get<I>(m_streams); }
+
+	// Element access
+	template<size_t I>
+	FieldType<I>& Get(size_t idx)				{ ASSERT(idx < m_size); return std::get<I>(m_streams)[idx]; }
+	template<size_t I>
+	const FieldType<I>& Get(size_t idx) const	{ ASSERT(idx < m_size); return std::get<I>(m_streams)[idx]; }
+
+	// Calls 'func' with a reference to each field of every element
+	template<typename Func>
+	void ForEach(const Func& func)
+	{
+		for(size_t i = 0; i < m_size; ++i)
+		{
+			CallWithElement(func, i, std::index_sequence_for<Fields...>());
+		}
+	}
+
+	// Capacity
+	bool IsEmpty() const						{ return (m_size == 0); }
+	size_t Size() const							{ return m_size; }
+	size_t GetPaddedSize() const				{ return (m_size + kNumLanes - 1) & ~(kNumLanes - 1); }
+	size_t GetReservedSize() const				{ return m_reservedSize; }
+
+	void Reserve(size_t newReservedSize)
+	{
+		newReservedSize = (newReservedSize + kNumLanes - 1) & ~(kNumLanes - 1);
+		if(newReservedSize <= m_reservedSize)
+		{
+			return;
+		}
+
+		std::tuple<Fields*...> newStreams;
+		ReallocateStreams(newStreams, newReservedSize, std::index_sequence_for<Fields...>());
+		FreeStreams(m_streams, std::index_sequence_for<Fields...>());
+		m_streams = newStreams;
+		m_reservedSize = newReservedSize;
+	}
+
+	// Erases all elements from the SoAArray, but doesn't free its memory
+	void Clear()
+	{
+		m_size = 0;
+	}
+
+	void Swap(SoAArray& otherArray)
+	{
+		std::swap(m_streams, otherArray.m_streams);
+		std::swap(m_size, otherArray.m_size);
+		std::swap(m_reservedSize, otherArray.m_reservedSize);
+	}
+
+	SoAArray(const SoAArray&) = delete;
+	SoAArray& operator =(const SoAArray&) = delete;
+
+private:
+	static constexpr size_t kMaxReservedSizeIncrement = 1024;
+
+	template<size_t... I>
+	void SetElement(size_t idx, std::index_sequence<I...>, const Fields&... values)
+	{
+		((std::get<I>(m_streams)[idx] = values), ...);
+	}
+
+	template<size_t... I>
+	void CopyElement(size_t srcIdx, size_t dstIdx, std::index_sequence<I...>)
+	{
+		((std::get<I>(m_streams)[dstIdx] = std::get<I>(m_streams)[srcIdx]), ...);
+	}
+
+	template<typename Func, size_t... I>
+	void CallWithElement(const Func& func, size_t idx, std::index_sequence<I...>)
+	{
+		func(std::get<I>(m_streams)[idx]...);
+	}
+
+	template<size_t... I>
+	void ReallocateStreams(std::tuple<Fields*...>& newStreams, size_t newReservedSize, std::index_sequence<I...>)
+	{
+		((std::get<I>(newStreams) = static_cast<FieldType<I>*>(MemorySystem::Alloc(newReservedSize * sizeof(FieldType<I>), std::max(kStreamAlignment, alignof(FieldType<I>))))), ...);
+		((m_size != 0 ? memcpy(std::get<I>(newStreams), std::get<I>(m_streams), m_size * sizeof(FieldType<I>)) : nullptr), ...);
+	}
+
+	template<size_t... I>
+	static void FreeStreams(std::tuple<Fields*...>& streams, std::index_sequence<I...>)
+	{
+		(MemorySystem::Free(std::get<I>(streams)), ...);
+	}
+
+	std::tuple<Fields*...> m_streams = {};
+	size_t m_size = 0;
+	size_t m_reservedSize = 0;
+};
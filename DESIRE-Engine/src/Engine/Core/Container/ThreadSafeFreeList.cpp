@@ -0,0 +1,124 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Container/ThreadSafeFreeList.h"
+
+static constexpr uint32_t kTagShift = 48;
+static constexpr uint64_t kPtrMask = (1ull << kTagShift) - 1;
+
+void ThreadSafeFreeList::Push(void* pElement)
+{
+	ASSERT(pElement != nullptr);
+
+	ListElement* pListElement = new(pElement) ListElement;
+	PushList(pListElement, pListElement);
+}
+
+void* ThreadSafeFreeList::Pop()
+{
+	uint64_t taggedHead = m_taggedHead.load(std::memory_order_acquire);
+	for(;;)
+	{
+		ListElement* pElement = GetPtr(taggedHead);
+		if(pElement == nullptr)
+		{
+			return nullptr;
+		}
+
+		// The element can be popped and reused by an other thread before the CAS, but then the tag has changed and the CAS fails
+		ListElement* pNext = pElement->pNext.load(std::memory_order_relaxed);
+		if(m_taggedHead.compare_exchange_weak(taggedHead, MakeTaggedPtr(pNext, taggedHead), std::memory_order_acquire, std::memory_order_acquire))
+		{
+			return pElement;
+		}
+	}
+}
+
+void ThreadSafeFreeList::PushList(ListElement* pFirst, ListElement* pLast)
+{
+	uint64_t taggedHead = m_taggedHead.load(std::memory_order_relaxed);
+	do
+	{
+		pLast->pNext.store(GetPtr(taggedHead), std::memory_order_relaxed);
+	} while(!m_taggedHead.compare_exchange_weak(taggedHead, MakeTaggedPtr(pFirst, taggedHead), std::memory_order_release, std::memory_order_relaxed));
+}
+
+ThreadSafeFreeList::ListElement* ThreadSafeFreeList::GetPtr(uint64_t taggedPtr)
+{
+	return reinterpret_cast<ListElement*>(taggedPtr & kPtrMask);
+}
+
+uint64_t ThreadSafeFreeList::MakeTaggedPtr(ListElement* pElement, uint64_t prevTaggedPtr)
+{
+	static_assert(sizeof(void*) == sizeof(uint64_t), "Tagged pointers require a 64-bit platform");
+
+	const uint64_t ptr = reinterpret_cast<uint64_t>(pElement);
+	ASSERT((ptr & ~kPtrMask) == 0);
+
+	const uint64_t nextTag = (prevTaggedPtr >> kTagShift) + 1;
+	return (nextTag << kTagShift) | ptr;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//	ThreadSafeFreeList::Magazine
+// --------------------------------------------------------------------------------------------------------------------
+
+ThreadSafeFreeList::Magazine::Magazine(ThreadSafeFreeList& freeList)
+	: m_freeList(freeList)
+{
+}
+
+ThreadSafeFreeList::Magazine::~Magazine()
+{
+	while(m_numElements > 0)
+	{
+		m_freeList.Push(m_elements[--m_numElements]);
+	}
+}
+
+void ThreadSafeFreeList::Magazine::Push(void* pElement)
+{
+	ASSERT(pElement != nullptr);
+
+	if(m_numElements == kMaxNumElements)
+	{
+		// Link the upper half together and give it back to the shared list with a single operation
+		constexpr uint32_t kNumElementsToKeep = kMaxNumElements / 2;
+		ListElement* pFirst = new(m_elements[kNumElementsToKeep]) ListElement;
+		ListElement* pLast = pFirst;
+		for(uint32_t i = kNumElementsToKeep + 1; i < kMaxNumElements; ++i)
+		{
+			ListElement* pListElement = new(m_elements[i]) ListElement;
+			pLast->pNext.store(pListElement, std::memory_order_relaxed);
+			pLast = pListElement;
+		}
+
+		m_freeList.PushList(pFirst, pLast);
+		m_numElements = kNumElementsToKeep;
+	}
+
+	m_elements[m_numElements++] = pElement;
+}
+
+void* ThreadSafeFreeList::Magazine::Pop()
+{
+	if(m_numElements == 0)
+	{
+		// Refill half of the cache from the shared list
+		while(m_numElements < kMaxNumElements / 2)
+		{
+			void* pElement = m_freeList.Pop();
+			if(pElement == nullptr)
+			{
+				break;
+			}
+
+			m_elements[m_numElements++] = pElement;
+		}
+
+		if(m_numElements == 0)
+		{
+			return nullptr;
+		}
+	}
+
+	return m_elements[--m_numElements];
+}
@@ -1,24 +1,54 @@
 #pragma once
 
-#include "Engine/Core/Container/FreeList.h"
-#include "Engine/Core/SpinLock.h"
+// --------------------------------------------------------------------------------------------------------------------
+//	ThreadSafeFreeList is a lock-free version of FreeList (a Treiber stack).
+//	To avoid the ABA problem the head pointer is stored together with a tag which is incremented on every modification,
+//	using the upper 16 bits of the pointer which are unused on 64-bit platforms.
+//	https://en.wikipedia.org/wiki/Treiber_stack
+// --------------------------------------------------------------------------------------------------------------------
 
 class ThreadSafeFreeList
 {
 public:
-	void Push(void* pElement)
-	{
-		DESIRE_SCOPED_SPINLOCK(m_spinLock);
-		m_freeList.Push(pElement);
-	}
+	void Push(void* pElement);
+	void* Pop();
+
+	// ----------------------------------------------------------------------------------------------------------------
+	//	Magazine is a small cache in front of a ThreadSafeFreeList which should be owned by a single thread.
+	//	Most of the pushes and pops are served from the cache and the shared list is only accessed when the cache is
+	//	empty or full, then half of the cache is moved at once.
+	// ----------------------------------------------------------------------------------------------------------------
 
-	void* Pop()
+	class Magazine
 	{
-		DESIRE_SCOPED_SPINLOCK(m_spinLock);
-		return m_freeList.Pop();
-	}
+	public:
+		Magazine(ThreadSafeFreeList& freeList);
+		~Magazine();
+
+		void Push(void* pElement);
+		void* Pop();
+
+	private:
+		DESIRE_NO_COPY_AND_MOVE(Magazine)
+
+		static constexpr uint32_t kMaxNumElements = 32;
+
+		ThreadSafeFreeList& m_freeList;
+		void* m_elements[kMaxNumElements];
+		uint32_t m_numElements = 0;
+	};
 
 private:
-	SpinLock m_spinLock;
-	FreeList m_freeList;
+	struct ListElement
+	{
+		std::atomic<ListElement*> pNext;
+	};
+
+	// Push a list of elements which are already linked together with a single atomic operation
+	void PushList(ListElement* pFirst, ListElement* pLast);
+
+	static ListElement* GetPtr(uint64_t taggedPtr);
+	static uint64_t MakeTaggedPtr(ListElement* pElement, uint64_t prevTaggedPtr);
+
+	std::atomic<uint64_t> m_taggedHead = 0;
 };
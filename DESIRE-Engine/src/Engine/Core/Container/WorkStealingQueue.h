@@ -0,0 +1,95 @@
+#pragma once
+
+// --------------------------------------------------------------------------------------------------------------------
+//	WorkStealingQueue is a fixed size Chase-Lev deque without locks.
+//	The owner thread pushes and pops at the bottom (LIFO), while any other thread can steal from the top (FIFO).
+//	Note that T has to be trivially copyable (typically a pointer) and SIZE has to be a power of two.
+//	https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename T, uint32_t SIZE>
+class WorkStealingQueue
+{
+public:
+	WorkStealingQueue()
+	{
+		static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SIZE has to be a power of two");
+		static_assert(std::is_trivially_copyable<T>::value);
+	}
+
+	// Add new element at the bottom of the queue (only the owner thread is allowed to call this)
+	bool Push(T value)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_top.load(std::memory_order_acquire);
+		if(bottom - top >= static_cast<int64_t>(SIZE))
+		{
+			// The queue is full
+			return false;
+		}
+
+		m_data[bottom & kIndexMask].store(value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Remove the most recently pushed element from the bottom of the queue (only the owner thread is allowed to call this)
+	bool Pop(T& value)
+	{
+		const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_top.load(std::memory_order_relaxed);
+
+		if(top > bottom)
+		{
+			// The queue is empty
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		value = m_data[bottom & kIndexMask].load(std::memory_order_relaxed);
+		if(top == bottom)
+		{
+			// This is the last element, race against the stealing threads
+			const bool successful = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return successful;
+		}
+
+		return true;
+	}
+
+	// Remove the oldest element from the top of the queue (any thread is allowed to call this)
+	bool Steal(T& value)
+	{
+		int64_t top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+		if(top >= bottom)
+		{
+			// The queue is empty
+			return false;
+		}
+
+		value = m_data[top & kIndexMask].load(std::memory_order_relaxed);
+		return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	// Returns true if there is no element in the queue (the result is only a snapshot when other threads are accessing the queue)
+	bool IsEmpty() const
+	{
+		return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+	}
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(WorkStealingQueue)
+
+	static constexpr int64_t kIndexMask = SIZE - 1;
+
+	// The two ends are on separate cache lines as they are written by different threads
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<int64_t> m_top = 0;
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<int64_t> m_bottom = 0;
+	alignas(DESIRE_CACHE_LINE_SIZE) std::atomic<T> m_data[SIZE];
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+struct FiberImpl;
+
+// --------------------------------------------------------------------------------------------------------------------
+//	Fiber is an execution context with its own stack which runs until it explicitly switches to an other fiber.
+//	A thread has to be converted to a fiber before it can switch to any other fiber.
+//	Note: A fiber can be resumed on a different thread than it was suspended on, so values derived from thread_local
+//	variables must not be kept across SwitchTo() calls.
+// --------------------------------------------------------------------------------------------------------------------
+
+class Fiber
+{
+public:
+	typedef void(*EntryPoint_t)(void* pUserData);
+
+	// Converts the calling thread to a fiber (the thread has to be converted back by destroying the fiber on the same thread)
+	Fiber();
+	// Creates a new fiber which starts executing the entry point when it is switched to for the first time
+	// The entry point must never return, it has to switch to an other fiber instead
+	Fiber(EntryPoint_t pEntryPoint, void* pUserData, size_t stackSize);
+	~Fiber();
+
+	// Returns false if the creation of the fiber has failed (the system was out of memory), such fiber can't be switched to
+	bool IsValid() const;
+
+	// Suspends this fiber and continues the execution on the other fiber (has to be called from this fiber)
+	void SwitchTo(Fiber& other);
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(Fiber)
+
+	std::unique_ptr<FiberImpl> m_spImpl;
+};
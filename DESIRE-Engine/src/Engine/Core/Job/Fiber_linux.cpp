@@ -0,0 +1,96 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Job/Fiber.h"
+
+#if DESIRE_PLATFORM_LINUX
+
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <errno.h>
+
+struct FiberImpl
+{
+	ucontext_t context = {};
+	void* pStack = nullptr;
+	size_t stackSize = 0;
+
+	Fiber::EntryPoint_t pEntryPoint = nullptr;
+	void* pUserData = nullptr;
+
+	// makecontext() can only pass int arguments, so the pointer is split into two halves
+	static void EntryPoint(uint32_t implPtrLow, uint32_t implPtrHigh)
+	{
+		const FiberImpl* pImpl = reinterpret_cast<const FiberImpl*>((static_cast<uintptr_t>(implPtrHigh) << 32) | implPtrLow);
+		pImpl->pEntryPoint(pImpl->pUserData);
+
+		ASSERT(false && "The entry point of a fiber must not return");
+		std::abort();
+	}
+};
+
+Fiber::Fiber()
+	: m_spImpl(std::make_unique<FiberImpl>())
+{
+	// The context of the thread is saved by the first SwitchTo() call
+}
+
+Fiber::Fiber(EntryPoint_t pEntryPoint, void* pUserData, size_t stackSize)
+	: m_spImpl(std::make_unique<FiberImpl>())
+{
+	ASSERT(pEntryPoint != nullptr);
+
+	m_spImpl->pEntryPoint = pEntryPoint;
+	m_spImpl->pUserData = pUserData;
+
+	// The stack is allocated with an inaccessible guard page at the bottom to catch stack overflows
+	const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	m_spImpl->stackSize = (stackSize + pageSize - 1) / pageSize * pageSize + pageSize;
+	void* pStack = mmap(nullptr, m_spImpl->stackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(pStack == MAP_FAILED)
+	{
+		LOG_ERROR("Failed to allocate the stack of a fiber: %s", strerror(errno));
+		m_spImpl->stackSize = 0;
+		return;
+	}
+
+	m_spImpl->pStack = pStack;
+	if(mprotect(m_spImpl->pStack, pageSize, PROT_NONE) != 0)
+	{
+		LOG_ERROR("Failed to protect the stack of a fiber: %s", strerror(errno));
+		munmap(m_spImpl->pStack, m_spImpl->stackSize);
+		m_spImpl->pStack = nullptr;
+		m_spImpl->stackSize = 0;
+		return;
+	}
+
+	getcontext(&m_spImpl->context);
+	m_spImpl->context.uc_stack.ss_sp = m_spImpl->pStack;
+	m_spImpl->context.uc_stack.ss_size = m_spImpl->stackSize;
+	m_spImpl->context.uc_link = nullptr;
+
+	const uintptr_t implPtr = reinterpret_cast<uintptr_t>(m_spImpl.get());
+	makecontext(&m_spImpl->context, reinterpret_cast<void(*)()>(&FiberImpl::EntryPoint), 2, static_cast<uint32_t>(implPtr), static_cast<uint32_t>(implPtr >> 32));
+}
+
+Fiber::~Fiber()
+{
+	if(m_spImpl->pStack != nullptr)
+	{
+		munmap(m_spImpl->pStack, m_spImpl->stackSize);
+	}
+}
+
+bool Fiber::IsValid() const
+{
+	// The fiber of a converted thread has no stack of its own
+	return (m_spImpl->pStack != nullptr || m_spImpl->pEntryPoint == nullptr);
+}
+
+void Fiber::SwitchTo(Fiber& other)
+{
+	ASSERT(&other != this);
+	ASSERT(other.IsValid());
+	swapcontext(&m_spImpl->context, &other.m_spImpl->context);
+}
+
+#endif	// #if DESIRE_PLATFORM_LINUX
@@ -0,0 +1,63 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Job/Fiber.h"
+
+#if DESIRE_PLATFORM_WINDOWS
+
+#include "Engine/Core/WINDOWS/os.h"
+
+struct FiberImpl
+{
+	void* pFiber = nullptr;
+	bool isConvertedThread = false;
+};
+
+Fiber::Fiber()
+	: m_spImpl(std::make_unique<FiberImpl>())
+{
+	m_spImpl->pFiber = ConvertThreadToFiber(nullptr);
+	if(m_spImpl->pFiber == nullptr)
+	{
+		LOG_ERROR_WITH_WIN32_ERRORCODE("Failed to convert the thread to a fiber");
+		return;
+	}
+
+	m_spImpl->isConvertedThread = true;
+}
+
+Fiber::Fiber(EntryPoint_t pEntryPoint, void* pUserData, size_t stackSize)
+	: m_spImpl(std::make_unique<FiberImpl>())
+{
+	ASSERT(pEntryPoint != nullptr);
+
+	m_spImpl->pFiber = CreateFiber(stackSize, reinterpret_cast<LPFIBER_START_ROUTINE>(pEntryPoint), pUserData);
+	if(m_spImpl->pFiber == nullptr)
+	{
+		LOG_ERROR_WITH_WIN32_ERRORCODE("Failed to create a fiber");
+	}
+}
+
+Fiber::~Fiber()
+{
+	if(m_spImpl->isConvertedThread)
+	{
+		ConvertFiberToThread();
+	}
+	else if(m_spImpl->pFiber != nullptr)
+	{
+		DeleteFiber(m_spImpl->pFiber);
+	}
+}
+
+bool Fiber::IsValid() const
+{
+	return (m_spImpl->pFiber != nullptr);
+}
+
+void Fiber::SwitchTo(Fiber& other)
+{
+	ASSERT(&other != this);
+	ASSERT(other.IsValid());
+	SwitchToFiber(other.m_spImpl->pFiber);
+}
+
+#endif	// #if DESIRE_PLATFORM_WINDOWS
@@ -0,0 +1,300 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Job/FrameTaskGraph.h"
+
+#include "Engine/Core/Job/JobSystem.h"
+#include "Engine/Core/Time.h"
+
+struct FrameTaskGraph::Stage
+{
+	DynamicString name;
+	ResourceMask_t reads = 0;
+	ResourceMask_t writes = 0;
+	std::function<void()> func;
+	bool isMainThreadOnly = false;
+
+	Array<uint32_t> dependencies;
+	Array<uint32_t> successors;
+	std::atomic<uint32_t> numRemainingDependencies = 0;
+
+	uint64_t startTime = 0;
+	uint64_t endTime = 0;
+};
+
+FrameTaskGraph::FrameTaskGraph()
+{
+}
+
+FrameTaskGraph::~FrameTaskGraph()
+{
+}
+
+uint32_t FrameTaskGraph::AddStage(const String& name, ResourceMask_t reads, ResourceMask_t writes, std::function<void()> func)
+{
+	return AddStage_Internal(name, reads, writes, std::move(func), false);
+}
+
+uint32_t FrameTaskGraph::AddMainThreadStage(const String& name, ResourceMask_t reads, ResourceMask_t writes, std::function<void()> func)
+{
+	return AddStage_Internal(name, reads, writes, std::move(func), true);
+}
+
+uint32_t FrameTaskGraph::AddStage_Internal(const String& name, ResourceMask_t reads, ResourceMask_t writes, std::function<void()> func, bool isMainThreadOnly)
+{
+	ASSERT(func != nullptr);
+
+	std::unique_ptr<Stage>& spStage = m_stages.EmplaceAdd(std::make_unique<Stage>());
+	spStage->name = name;
+	spStage->reads = reads;
+	spStage->writes = writes;
+	spStage->func = std::move(func);
+	spStage->isMainThreadOnly = isMainThreadOnly;
+
+	m_isDependencyInfoDirty = true;
+	return static_cast<uint32_t>(m_stages.Size() - 1);
+}
+
+void FrameTaskGraph::Clear()
+{
+	m_stages.Clear();
+	m_rootStages.Clear();
+	m_criticalPath.Clear();
+	m_frameDuration = 0;
+	m_isDependencyInfoDirty = false;
+}
+
+void FrameTaskGraph::Execute(JobSystem* pJobSystem)
+{
+	if(m_isDependencyInfoDirty)
+	{
+		BuildDependencies();
+	}
+
+	m_frameStartTime = Time::GetMicroTime();
+
+	if(pJobSystem == nullptr || pJobSystem->GetNumThreads() <= 1)
+	{
+		// The stages are in a valid execution order
+		for(uint32_t stageIdx = 0; stageIdx < m_stages.Size(); ++stageIdx)
+		{
+			ExecuteStage(stageIdx);
+		}
+	}
+	else
+	{
+		for(std::unique_ptr<Stage>& spStage : m_stages)
+		{
+			spStage->numRemainingDependencies = static_cast<uint32_t>(spStage->dependencies.Size());
+		}
+		m_numFinishedStages = 0;
+
+		JobCounter counter;
+		for(uint32_t stageIdx : m_rootStages)
+		{
+			ScheduleStage(stageIdx, pJobSystem, &counter);
+		}
+
+		// Execute the main thread stages when they become ready and help with the jobs in the meantime
+		while(m_numFinishedStages < m_stages.Size())
+		{
+			uint32_t stageIdx = UINT32_MAX;
+			{
+				DESIRE_SCOPED_SPINLOCK(m_readyMainThreadStagesSpinLock);
+				if(!m_readyMainThreadStages.IsEmpty())
+				{
+					stageIdx = m_readyMainThreadStages.GetLast();
+					m_readyMainThreadStages.RemoveLast();
+				}
+			}
+
+			if(stageIdx != UINT32_MAX)
+			{
+				ExecuteStageAndScheduleSuccessors(stageIdx, pJobSystem, &counter);
+			}
+			else if(!pJobSystem->TryExecuteJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		pJobSystem->WaitForCounter(counter);
+	}
+
+	UpdateCriticalPath();
+
+	if(m_criticalPathCallback)
+	{
+		m_criticalPathCallback(*this);
+	}
+}
+
+uint32_t FrameTaskGraph::GetNumStages() const
+{
+	return static_cast<uint32_t>(m_stages.Size());
+}
+
+const String& FrameTaskGraph::GetStageName(uint32_t stageIdx) const
+{
+	return m_stages[stageIdx]->name;
+}
+
+const Array<uint32_t>& FrameTaskGraph::GetStageDependencies(uint32_t stageIdx) const
+{
+	ASSERT(!m_isDependencyInfoDirty && "The dependencies are built by Execute()");
+	return m_stages[stageIdx]->dependencies;
+}
+
+const Array<FrameTaskGraph::StageTiming>& FrameTaskGraph::GetCriticalPath() const
+{
+	return m_criticalPath;
+}
+
+uint64_t FrameTaskGraph::GetFrameDuration() const
+{
+	return m_frameDuration;
+}
+
+void FrameTaskGraph::LogCriticalPath() const
+{
+	LOG_MESSAGE("Frame critical path (%llu us):", static_cast<unsigned long long>(m_frameDuration));
+	for(const StageTiming& timing : m_criticalPath)
+	{
+		LOG_MESSAGE("  %-24s start: %6llu us  duration: %6llu us", m_stages[timing.stageIdx]->name.Str(), static_cast<unsigned long long>(timing.startTime), static_cast<unsigned long long>(timing.duration));
+	}
+}
+
+void FrameTaskGraph::SetCriticalPathCallback(const CriticalPathCallback_t& callback)
+{
+	m_criticalPathCallback = callback;
+}
+
+void FrameTaskGraph::BuildDependencies()
+{
+	m_rootStages.Clear();
+	for(std::unique_ptr<Stage>& spStage : m_stages)
+	{
+		spStage->dependencies.Clear();
+		spStage->successors.Clear();
+	}
+
+	for(uint32_t stageIdx = 0; stageIdx < m_stages.Size(); ++stageIdx)
+	{
+		Stage& stage = *m_stages[stageIdx];
+
+		// Scan backwards to skip the dependencies which are already implied by an other dependency
+		ResourceMask_t unresolvedReads = stage.reads;
+		ResourceMask_t unresolvedWrites = stage.writes;
+		ResourceMask_t resourcesOrderedByReaders = 0;
+		for(uint32_t prevIdx = stageIdx; prevIdx-- > 0;)
+		{
+			Stage& prevStage = *m_stages[prevIdx];
+
+			// The previous writer doesn't need to be waited for when we already wait for a reader which comes after it
+			const bool isAccessAfterWrite = ((prevStage.writes & ~resourcesOrderedByReaders) & (unresolvedReads | unresolvedWrites)) != 0;
+			const bool isWriteAfterRead = (prevStage.reads & unresolvedWrites) != 0;
+			if(isAccessAfterWrite || isWriteAfterRead)
+			{
+				stage.dependencies.Add(prevIdx);
+				prevStage.successors.Add(stageIdx);
+				resourcesOrderedByReaders |= prevStage.reads & unresolvedWrites;
+			}
+
+			// Everything before the previous writer is ordered by it for the resources it writes
+			unresolvedReads &= ~prevStage.writes;
+			unresolvedWrites &= ~prevStage.writes;
+			if((unresolvedReads | unresolvedWrites) == 0)
+			{
+				break;
+			}
+		}
+
+		if(stage.dependencies.IsEmpty())
+		{
+			m_rootStages.Add(stageIdx);
+		}
+	}
+
+	m_isDependencyInfoDirty = false;
+}
+
+void FrameTaskGraph::ExecuteStage(uint32_t stageIdx)
+{
+	Stage& stage = *m_stages[stageIdx];
+	stage.startTime = Time::GetMicroTime();
+	stage.func();
+	stage.endTime = Time::GetMicroTime();
+}
+
+void FrameTaskGraph::ExecuteStageAndScheduleSuccessors(uint32_t stageIdx, JobSystem* pJobSystem, JobCounter* pCounter)
+{
+	ExecuteStage(stageIdx);
+
+	for(uint32_t successorIdx : m_stages[stageIdx]->successors)
+	{
+		if(--m_stages[successorIdx]->numRemainingDependencies == 0)
+		{
+			ScheduleStage(successorIdx, pJobSystem, pCounter);
+		}
+	}
+
+	// Counted only after the successors are scheduled, so Execute() cannot miss a main thread stage
+	m_numFinishedStages++;
+}
+
+void FrameTaskGraph::ScheduleStage(uint32_t stageIdx, JobSystem* pJobSystem, JobCounter* pCounter)
+{
+	if(m_stages[stageIdx]->isMainThreadOnly)
+	{
+		DESIRE_SCOPED_SPINLOCK(m_readyMainThreadStagesSpinLock);
+		m_readyMainThreadStages.Add(stageIdx);
+		return;
+	}
+
+	pJobSystem->Run([this, stageIdx, pJobSystem, pCounter]()
+	{
+		ExecuteStageAndScheduleSuccessors(stageIdx, pJobSystem, pCounter);
+	}, pCounter);
+}
+
+void FrameTaskGraph::UpdateCriticalPath()
+{
+	m_criticalPath.Clear();
+	m_frameDuration = 0;
+	if(m_stages.IsEmpty())
+	{
+		return;
+	}
+
+	// Start from the stage which finished last and walk back through the dependency which finished last
+	// On equal timestamps the later stage is chosen, as it can only come after the earlier one
+	uint32_t stageIdx = 0;
+	for(uint32_t i = 1; i < m_stages.Size(); ++i)
+	{
+		if(m_stages[i]->endTime >= m_stages[stageIdx]->endTime)
+		{
+			stageIdx = i;
+		}
+	}
+
+	m_frameDuration = m_stages[stageIdx]->endTime - m_frameStartTime;
+
+	while(stageIdx != UINT32_MAX)
+	{
+		const Stage& stage = *m_stages[stageIdx];
+		m_criticalPath.Add(StageTiming{ stageIdx, stage.startTime - m_frameStartTime, stage.endTime - stage.startTime });
+
+		uint32_t criticalDependencyIdx = UINT32_MAX;
+		for(uint32_t dependencyIdx : stage.dependencies)
+		{
+			if(criticalDependencyIdx == UINT32_MAX ||
+				m_stages[dependencyIdx]->endTime > m_stages[criticalDependencyIdx]->endTime ||
+				(m_stages[dependencyIdx]->endTime == m_stages[criticalDependencyIdx]->endTime && dependencyIdx > criticalDependencyIdx))
+			{
+				criticalDependencyIdx = dependencyIdx;
+			}
+		}
+
+		stageIdx = criticalDependencyIdx;
+	}
+
+	std::reverse(m_criticalPath.begin(), m_criticalPath.end());
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/SpinLock.h"
+#include "Engine/Core/String/DynamicString.h"
+
+class JobCounter;
+class JobSystem;
+
+// --------------------------------------------------------------------------------------------------------------------
+//	FrameTaskGraph runs the stages of a frame on the JobSystem based on the resources they read and write.
+//	A stage depends on every previously added stage which writes something it accesses or reads something it writes,
+//	so the result is the same as running the stages one after the other in the order they were added, while stages
+//	without conflicting accesses can run concurrently.
+//	Stages added with AddMainThreadStage() are executed on the thread which calls Execute(), the others are jobs.
+//	After each frame the critical path (the chain of stages which bounded the frame time) is available for profiling.
+// --------------------------------------------------------------------------------------------------------------------
+
+class FrameTaskGraph
+{
+public:
+	typedef uint64_t ResourceMask_t;
+
+	// Bit flags for the data which the stages are accessing, applications can define their own resources starting from USER_RESOURCE
+	enum EResource : ResourceMask_t
+	{
+		TIMER			= 1ull << 0,
+		INPUT			= 1ull << 1,
+		SCENE			= 1ull << 2,	// The objects and their transforms
+		SCRIPTS			= 1ull << 3,
+		PHYSICS			= 1ull << 4,
+		USER_INTERFACE	= 1ull << 5,
+		SOUND			= 1ull << 6,
+		RENDER			= 1ull << 7,
+		USER_RESOURCE	= 1ull << 16,
+		ALL_RESOURCES	= UINT64_MAX
+	};
+
+	struct StageTiming
+	{
+		uint32_t stageIdx;
+		uint64_t startTime;		// In microseconds relative to the start of the frame
+		uint64_t duration;		// In microseconds
+	};
+
+	// Called at the end of each Execute() when the critical path of the frame is available
+	typedef std::function<void(const FrameTaskGraph& taskGraph)> CriticalPathCallback_t;
+
+	FrameTaskGraph();
+	~FrameTaskGraph();
+
+	// Adds a stage and returns its index
+	uint32_t AddStage(const String& name, ResourceMask_t reads, ResourceMask_t writes, std::function<void()> func);
+	// Adds a stage which has to be executed on the thread calling Execute() (for example because of a thread-bound API)
+	uint32_t AddMainThreadStage(const String& name, ResourceMask_t reads, ResourceMask_t writes, std::function<void()> func);
+	void Clear();
+
+	// Runs all the stages and waits for them to finish (runs them serially when there is no JobSystem or it has only one thread)
+	void Execute(JobSystem* pJobSystem);
+
+	uint32_t GetNumStages() const;
+	const String& GetStageName(uint32_t stageIdx) const;
+	// Returns the indices of the stages which the given stage has to wait for
+	const Array<uint32_t>& GetStageDependencies(uint32_t stageIdx) const;
+
+	// Returns the stages of the critical path of the last frame in execution order
+	const Array<StageTiming>& GetCriticalPath() const;
+	// Returns the time between the start of the first stage and the end of the last one in the last frame
+	uint64_t GetFrameDuration() const;
+	void LogCriticalPath() const;
+	void SetCriticalPathCallback(const CriticalPathCallback_t& callback);
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(FrameTaskGraph)
+
+	struct Stage;
+
+	uint32_t AddStage_Internal(const String& name, ResourceMask_t reads, ResourceMask_t writes, std::function<void()> func, bool isMainThreadOnly);
+	void BuildDependencies();
+	void ExecuteStage(uint32_t stageIdx);
+	void ExecuteStageAndScheduleSuccessors(uint32_t stageIdx, JobSystem* pJobSystem, JobCounter* pCounter);
+	void ScheduleStage(uint32_t stageIdx, JobSystem* pJobSystem, JobCounter* pCounter);
+	void UpdateCriticalPath();
+
+	Array<std::unique_ptr<Stage>> m_stages;
+	Array<uint32_t> m_rootStages;
+	bool m_isDependencyInfoDirty = false;
+
+	// The main thread stages which are ready to be executed
+	SpinLock m_readyMainThreadStagesSpinLock;
+	Array<uint32_t> m_readyMainThreadStages;
+	std::atomic<uint32_t> m_numFinishedStages = 0;
+
+	uint64_t m_frameStartTime = 0;
+	uint64_t m_frameDuration = 0;
+	Array<StageTiming> m_criticalPath;
+	CriticalPathCallback_t m_criticalPathCallback;
+};
@@ -0,0 +1,498 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Job/JobSystem.h"
+
+#include "Engine/Core/Container/WorkStealingQueue.h"
+#include "Engine/Core/Job/Fiber.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+static constexpr uint32_t kMaxJobsPerThread = 4096;
+static constexpr uint32_t kMaxIdleSpinCount = 256;
+static constexpr size_t kFiberStackSize = 64 * 1024;
+
+static thread_local JobSystem* s_pCurrentJobSystem = nullptr;
+static thread_local uint32_t s_currentThreadIdx = UINT32_MAX;
+static thread_local uint32_t s_randomState = 0;
+static thread_local void* s_pCurrentFiberData = nullptr;
+
+struct alignas(DESIRE_CACHE_LINE_SIZE) JobSystem::ThreadData
+{
+	WorkStealingQueue<Job*, kMaxJobsPerThread> jobQueue;
+	// The jobs resuming the fibers which were suspended on this thread (these can't be stolen, so the fibers keep their thread-local state)
+	LockFreeMPMCQueue<Job*, kMaxNumFibers> resumeQueue;
+	uint32_t numSuspendedFibers = 0;	// Only accessed by the owner thread
+	std::thread thread;
+	std::unique_ptr<Fiber> spThreadFiber;
+};
+
+struct JobSystem::FiberData
+{
+	std::unique_ptr<Fiber> spFiber;
+	JobSystem* pJobSystem = nullptr;
+	Job* pJob = nullptr;
+	JobCounter* pWaitCounter = nullptr;
+	uint32_t threadIdx = UINT32_MAX;		// The thread which started the job, the fiber is always resumed there
+	MemorySystem::ScopeStacks scopeStacks;	// The allocator and memory tag scopes of the job while it is not running
+};
+
+// Xorshift random number generator for picking the thread to steal from
+static uint32_t GetNextRandom()
+{
+	if(s_randomState == 0)
+	{
+		s_randomState = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+	}
+
+	s_randomState ^= s_randomState << 13;
+	s_randomState ^= s_randomState >> 17;
+	s_randomState ^= s_randomState << 5;
+	return s_randomState;
+}
+
+JobSystem::JobSystem(uint32_t numWorkerThreads, bool isFiberModeEnabled)
+	: m_isFiberModeEnabled(isFiberModeEnabled)
+{
+	ASSERT(s_pCurrentJobSystem == nullptr && "The thread is already owned by an other JobSystem");
+
+	if(numWorkerThreads == UINT32_MAX)
+	{
+		const uint32_t numHardwareThreads = std::thread::hardware_concurrency();
+		numWorkerThreads = (numHardwareThreads > 1) ? numHardwareThreads - 1 : 0;
+	}
+
+	// The data for all threads has to be created before starting the workers as they are stealing from each other
+	m_threads.Reserve(numWorkerThreads + 1);
+	for(uint32_t i = 0; i <= numWorkerThreads; ++i)
+	{
+		m_threads.Add(std::make_unique<ThreadData>());
+	}
+
+	if(m_isFiberModeEnabled)
+	{
+		// When a fiber can't be created the pool stays smaller, and without free fibers the jobs are executed on the stack of the threads
+		m_fibers.Reserve(kMaxNumFibers);
+		for(uint32_t i = 0; i < kMaxNumFibers; ++i)
+		{
+			std::unique_ptr<FiberData> spFiberData = std::make_unique<FiberData>();
+			spFiberData->pJobSystem = this;
+			spFiberData->spFiber = std::make_unique<Fiber>(&JobSystem::FiberEntryPoint, spFiberData.get(), kFiberStackSize);
+			if(!spFiberData->spFiber->IsValid())
+			{
+				break;
+			}
+
+			m_freeFibers.Push(spFiberData.get());
+			m_fibers.Add(std::move(spFiberData));
+		}
+	}
+
+	s_pCurrentJobSystem = this;
+	s_currentThreadIdx = 0;
+
+	for(uint32_t i = 1; i <= numWorkerThreads; ++i)
+	{
+		m_threads[i]->thread = std::thread(&JobSystem::WorkerThreadFunc, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	m_isShuttingDown = true;
+	{
+		std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+		m_wakeUpCondition.notify_all();
+	}
+
+	for(size_t i = 1; i < m_threads.Size(); ++i)
+	{
+		m_threads[i]->thread.join();
+	}
+
+	// Execute the remaining jobs on the calling thread
+	for(Job* pJob = FindJob(0); pJob != nullptr; pJob = FindJob(0))
+	{
+		Execute(pJob);
+	}
+
+	ASSERT(m_fibers.Size() == 0 || GetThreadIdx() == 0);
+	m_fibers.Clear();
+
+	if(s_pCurrentJobSystem == this)
+	{
+		s_pCurrentJobSystem = nullptr;
+		s_currentThreadIdx = UINT32_MAX;
+	}
+}
+
+void JobSystem::Run(std::function<void()> func, JobCounter* pCounter)
+{
+	ASSERT(func != nullptr);
+
+	if(pCounter)
+	{
+		pCounter->m_value++;
+	}
+
+	Submit(new Job{ std::move(func), pCounter });
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> func, JobCounter* pCounter)
+{
+	ASSERT(func != nullptr);
+
+	if(pCounter)
+	{
+		pCounter->m_value++;
+	}
+
+	SubmitAfter(dependency, new Job{ std::move(func), pCounter });
+}
+
+void JobSystem::WaitForCounter(JobCounter& counter)
+{
+	FiberData* pFiberData = GetCurrentFiberData();
+	if(pFiberData != nullptr && pFiberData->pJobSystem == this)
+	{
+		if(counter.m_value.load(std::memory_order_acquire) != 0)
+		{
+			// Suspend the job, the thread fiber will register it to the counter
+			pFiberData->pWaitCounter = &counter;
+			SwitchToThreadFiber(pFiberData);
+		}
+
+		// Make sure the thread which decremented the counter has finished accessing it
+		DESIRE_SCOPED_SPINLOCK(counter.m_spinLock);
+		return;
+	}
+
+	const uint32_t threadIdx = GetThreadIdx();
+
+	uint32_t spinCount = 0;
+	while(counter.m_value.load(std::memory_order_acquire) != 0)
+	{
+		Job* pJob = FindJob(threadIdx);
+		if(pJob)
+		{
+			Execute(pJob);
+			spinCount = 0;
+		}
+		else if(spinCount < kMaxIdleSpinCount)
+		{
+			_mm_pause();
+			spinCount++;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Make sure the thread which decremented the counter has finished accessing it
+	DESIRE_SCOPED_SPINLOCK(counter.m_spinLock);
+}
+
+bool JobSystem::TryExecuteJob()
+{
+	Job* pJob = FindJob(GetThreadIdx());
+	if(pJob == nullptr)
+	{
+		return false;
+	}
+
+	Execute(pJob);
+	return true;
+}
+
+uint32_t JobSystem::GetNumThreads() const
+{
+	return static_cast<uint32_t>(m_threads.Size());
+}
+
+uint32_t JobSystem::GetCurrentThreadIdx()
+{
+	return s_currentThreadIdx;
+}
+
+void JobSystem::Submit(Job* pJob)
+{
+	if(pJob->pSuspendedFiber != nullptr)
+	{
+		// The queue has room for all the fibers, so this can't fail
+		const bool isPushed = m_threads[pJob->pSuspendedFiber->threadIdx]->resumeQueue.Push(pJob);
+		ASSERT(isPushed);
+		DESIRE_UNUSED(isPushed);
+
+		// Only the thread of the fiber can resume it, but notify_one() might wake up an other one
+		if(m_numSleepingThreads > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+			m_wakeUpCondition.notify_all();
+		}
+		return;
+	}
+
+	m_numPendingJobs++;
+
+	const uint32_t threadIdx = GetThreadIdx();
+	if(threadIdx == UINT32_MAX || !m_threads[threadIdx]->jobQueue.Push(pJob))
+	{
+		if(!m_globalQueue.Push(pJob))
+		{
+			// All the queues are full, execute the job right away on the calling thread
+			m_numPendingJobs--;
+			ExecuteJob(pJob);
+			return;
+		}
+	}
+
+	WakeUpWorker();
+}
+
+void JobSystem::SubmitAfter(JobCounter& dependency, Job* pJob)
+{
+	{
+		DESIRE_SCOPED_SPINLOCK(dependency.m_spinLock);
+		if(dependency.m_value != 0)
+		{
+			// The job will be submitted when the dependency reaches zero
+			dependency.m_dependentJobs.Add(pJob);
+			return;
+		}
+	}
+
+	Submit(pJob);
+}
+
+JobSystem::Job* JobSystem::FindJob(uint32_t threadIdx)
+{
+	Job* pJob = nullptr;
+
+	if(threadIdx != UINT32_MAX)
+	{
+		// Resume the suspended fibers first (this is only possible from the thread fiber)
+		if(GetCurrentFiberData() == nullptr && m_threads[threadIdx]->resumeQueue.Pop(pJob))
+		{
+			return pJob;
+		}
+
+		// Try our own queue
+		if(m_threads[threadIdx]->jobQueue.Pop(pJob))
+		{
+			m_numPendingJobs--;
+			return pJob;
+		}
+	}
+
+	// Try the global queue
+	if(m_globalQueue.Pop(pJob))
+	{
+		m_numPendingJobs--;
+		return pJob;
+	}
+
+	// Try to steal from an other thread
+	const uint32_t numThreads = GetNumThreads();
+	const uint32_t startIdx = GetNextRandom() % numThreads;
+	for(uint32_t i = 0; i < numThreads; ++i)
+	{
+		const uint32_t victimIdx = (startIdx + i) % numThreads;
+		if(victimIdx != threadIdx && m_threads[victimIdx]->jobQueue.Steal(pJob))
+		{
+			m_numPendingJobs--;
+			return pJob;
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::Execute(Job* pJob)
+{
+	const uint32_t threadIdx = GetThreadIdx();
+	FiberData* pFiberData = pJob->pSuspendedFiber;
+	if(pFiberData != nullptr)
+	{
+		// Resume the suspended job
+		ASSERT(threadIdx == pFiberData->threadIdx && GetCurrentFiberData() == nullptr);
+		m_threads[threadIdx]->numSuspendedFibers--;
+		delete pJob;
+	}
+	else
+	{
+		// The main thread doesn't start fibers, because a fiber suspended on it could only be resumed when it waits for a counter again
+		if(threadIdx == 0 || threadIdx == UINT32_MAX || m_threads[threadIdx]->spThreadFiber == nullptr || GetCurrentFiberData() != nullptr || !m_freeFibers.Pop(pFiberData))
+		{
+			// Execute the job on the stack of the calling thread, waiting inside it blocks the thread
+			ExecuteJob(pJob);
+			return;
+		}
+
+		pFiberData->pJob = pJob;
+		pFiberData->threadIdx = threadIdx;
+	}
+
+	SwitchToFiber(threadIdx, pFiberData);
+}
+
+void JobSystem::ExecuteJob(Job* pJob)
+{
+	pJob->func();
+
+	JobCounter* pCounter = pJob->pCounter;
+	delete pJob;
+
+	if(pCounter)
+	{
+		Array<Job*> readyJobs;
+		{
+			// The counter is decremented while holding the lock, because the waiting thread can destroy it as soon as the lock is released
+			DESIRE_SCOPED_SPINLOCK(pCounter->m_spinLock);
+			if(--pCounter->m_value == 0)
+			{
+				readyJobs.Swap(pCounter->m_dependentJobs);
+			}
+		}
+
+		for(Job* pReadyJob : readyJobs)
+		{
+			Submit(pReadyJob);
+		}
+	}
+}
+
+void JobSystem::WakeUpWorker()
+{
+	if(m_numSleepingThreads > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+		m_wakeUpCondition.notify_one();
+	}
+}
+
+void JobSystem::SwitchToFiber(uint32_t threadIdx, FiberData* pFiberData)
+{
+	ASSERT(threadIdx != UINT32_MAX);
+	SetCurrentFiberData(pFiberData);
+	MemorySystem::SwapScopeStacks(pFiberData->scopeStacks);
+	m_threads[threadIdx]->spThreadFiber->SwitchTo(*pFiberData->spFiber);
+	MemorySystem::SwapScopeStacks(pFiberData->scopeStacks);
+	SetCurrentFiberData(nullptr);
+
+	// The fiber has either finished its job or it is waiting for a counter
+	if(pFiberData->pWaitCounter != nullptr)
+	{
+		JobCounter* pWaitCounter = pFiberData->pWaitCounter;
+		pFiberData->pWaitCounter = nullptr;
+
+		m_threads[threadIdx]->numSuspendedFibers++;
+		SubmitAfter(*pWaitCounter, new Job{ nullptr, nullptr, pFiberData });
+	}
+	else
+	{
+		m_freeFibers.Push(pFiberData);
+	}
+}
+
+void JobSystem::SwitchToThreadFiber(FiberData* pFiberData)
+{
+	ASSERT(pFiberData->threadIdx == GetThreadIdx());
+	pFiberData->spFiber->SwitchTo(*m_threads[pFiberData->threadIdx]->spThreadFiber);
+}
+
+void JobSystem::FiberEntryPoint(void* pUserData)
+{
+	FiberData* pFiberData = static_cast<FiberData*>(pUserData);
+	for(;;)
+	{
+		pFiberData->pJobSystem->ExecuteJob(pFiberData->pJob);
+		pFiberData->pJob = nullptr;
+		pFiberData->pJobSystem->SwitchToThreadFiber(pFiberData);
+	}
+}
+
+DESIRE_NO_INLINE uint32_t JobSystem::GetThreadIdx() const
+{
+	return (s_pCurrentJobSystem == this) ? s_currentThreadIdx : UINT32_MAX;
+}
+
+DESIRE_NO_INLINE JobSystem::FiberData* JobSystem::GetCurrentFiberData()
+{
+	return static_cast<FiberData*>(s_pCurrentFiberData);
+}
+
+DESIRE_NO_INLINE void JobSystem::SetCurrentFiberData(FiberData* pFiberData)
+{
+	s_pCurrentFiberData = pFiberData;
+}
+
+void JobSystem::WorkerThreadFunc(uint32_t threadIdx)
+{
+	s_pCurrentJobSystem = this;
+	s_currentThreadIdx = threadIdx;
+
+	if(m_isFiberModeEnabled && m_fibers.Size() > 0)
+	{
+		m_threads[threadIdx]->spThreadFiber = std::make_unique<Fiber>();
+		if(!m_threads[threadIdx]->spThreadFiber->IsValid())
+		{
+			// The thread executes the jobs on its own stack
+			m_threads[threadIdx]->spThreadFiber = nullptr;
+		}
+	}
+
+	ThreadData& threadData = *m_threads[threadIdx];
+
+	// The fibers suspended on this thread have to be finished before exiting
+	uint32_t spinCount = 0;
+	while(!m_isShuttingDown || threadData.numSuspendedFibers > 0)
+	{
+		Job* pJob = FindJob(threadIdx);
+		if(pJob)
+		{
+			Execute(pJob);
+			spinCount = 0;
+			continue;
+		}
+
+		// Spin for a while before going to sleep
+		if(spinCount < kMaxIdleSpinCount)
+		{
+			_mm_pause();
+			spinCount++;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+		m_numSleepingThreads++;
+		m_wakeUpCondition.wait(lock, [this, &threadData]()
+		{
+			return (m_numPendingJobs > 0 || !threadData.resumeQueue.IsEmpty() || m_isShuttingDown);
+		});
+		m_numSleepingThreads--;
+		spinCount = 0;
+	}
+
+	threadData.spThreadFiber = nullptr;
+
+	s_pCurrentJobSystem = nullptr;
+	s_currentThreadIdx = UINT32_MAX;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//	JobCounter
+// --------------------------------------------------------------------------------------------------------------------
+
+JobCounter::~JobCounter()
+{
+	ASSERT(IsDone() && "The counter is destroyed while it still has unfinished jobs");
+	ASSERT(m_dependentJobs.IsEmpty());
+}
+
+uint32_t JobCounter::GetValue() const
+{
+	return m_value.load(std::memory_order_acquire);
+}
+
+bool JobCounter::IsDone() const
+{
+	return (GetValue() == 0);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/LockFreeMPMCQueue.h"
+#include "Engine/Core/SpinLock.h"
+
+class JobCounter;
+
+// --------------------------------------------------------------------------------------------------------------------
+//	JobSystem runs jobs on a pool of worker threads sized to the number of hardware threads.
+//	Each thread has its own work-stealing queue, idle threads steal jobs from the others.
+//	The thread which created the JobSystem is the main thread and it only executes jobs while it is waiting for a counter.
+//	In fiber mode the jobs of the worker threads run on fibers from a pool, so a job waiting for a counter is suspended and
+//	its thread continues with other jobs. The job is resumed on the same thread when the counter reaches zero, and its
+//	allocator and memory tag scopes are restored. The main thread executes the jobs on its own stack, as do the worker
+//	threads when the fibers could not be created.
+// --------------------------------------------------------------------------------------------------------------------
+
+class JobSystem
+{
+public:
+	// Passing UINT32_MAX creates one worker thread for every hardware thread except the calling one
+	JobSystem(uint32_t numWorkerThreads = UINT32_MAX, bool isFiberModeEnabled = false);
+	~JobSystem();
+
+	// Schedule a job for execution. The counter is incremented right away and decremented when the job has finished.
+	void Run(std::function<void()> func, JobCounter* pCounter = nullptr);
+	// Schedule a job which is only started after the dependency counter has reached zero
+	void RunAfter(JobCounter& dependency, std::function<void()> func, JobCounter* pCounter = nullptr);
+
+	// Execute other jobs on the calling thread until the counter reaches zero (a job running on a fiber is suspended instead)
+	void WaitForCounter(JobCounter& counter);
+
+	// Execute one pending job on the calling thread. Returns false if there was no job to execute
+	bool TryExecuteJob();
+
+	// Returns the number of threads executing jobs (including the main thread)
+	uint32_t GetNumThreads() const;
+
+	// Returns the index of the calling thread inside its JobSystem (0 is the main thread) or UINT32_MAX for other threads
+	static uint32_t GetCurrentThreadIdx();
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(JobSystem)
+
+	struct FiberData;
+
+	struct Job
+	{
+		std::function<void()> func;
+		JobCounter* pCounter = nullptr;
+		FiberData* pSuspendedFiber = nullptr;	// When set, the job resumes this fiber instead of calling func
+	};
+
+	struct ThreadData;
+
+	void Submit(Job* pJob);
+	void SubmitAfter(JobCounter& dependency, Job* pJob);
+	Job* FindJob(uint32_t threadIdx);
+	void Execute(Job* pJob);
+	void ExecuteJob(Job* pJob);
+	void WakeUpWorker();
+
+	void SwitchToFiber(uint32_t threadIdx, FiberData* pFiberData);
+	void SwitchToThreadFiber(FiberData* pFiberData);
+	static void FiberEntryPoint(void* pUserData);
+
+	// These are not inlined, because the compiler could cache the thread-local addresses across the fiber switches
+	uint32_t GetThreadIdx() const;
+	static FiberData* GetCurrentFiberData();
+	static void SetCurrentFiberData(FiberData* pFiberData);
+
+	void WorkerThreadFunc(uint32_t threadIdx);
+
+	Array<std::unique_ptr<ThreadData>> m_threads;
+
+	// Jobs submitted from threads which don't belong to the JobSystem (or when the queue of the thread is full)
+	LockFreeMPMCQueue<Job*, 4096> m_globalQueue;
+
+	std::mutex m_wakeUpMutex;
+	std::condition_variable m_wakeUpCondition;
+	std::atomic<int32_t> m_numPendingJobs = 0;
+	std::atomic<uint32_t> m_numSleepingThreads = 0;
+	std::atomic<bool> m_isShuttingDown = false;
+
+	static constexpr uint32_t kMaxNumFibers = 128;
+	const bool m_isFiberModeEnabled;
+	Array<std::unique_ptr<FiberData>> m_fibers;
+	LockFreeMPMCQueue<FiberData*, kMaxNumFibers> m_freeFibers;
+
+	friend class JobCounter;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+//	JobCounter tracks the number of unfinished jobs which were scheduled with it.
+//	Jobs scheduled with JobSystem::RunAfter() are kept in the counter until it reaches zero.
+// --------------------------------------------------------------------------------------------------------------------
+
+class JobCounter
+{
+public:
+	JobCounter() {}
+	~JobCounter();
+
+	uint32_t GetValue() const;
+	bool IsDone() const;
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(JobCounter)
+
+	std::atomic<uint32_t> m_value = 0;
+	SpinLock m_spinLock;
+	Array<JobSystem::Job*> m_dependentJobs;
+
+	friend class JobSystem;
+};
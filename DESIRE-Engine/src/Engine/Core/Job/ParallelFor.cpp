@@ -0,0 +1,64 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Job/ParallelFor.h"
+
+#include "Engine/Core/Job/JobSystem.h"
+
+// The number of chunks created for each thread to balance the load when some chunks are more expensive than others
+static constexpr size_t kNumChunksPerThread = 4;
+
+size_t ParallelFor_CalculateChunkSize(size_t numElements, size_t grainSize, size_t elementSize)
+{
+	size_t chunkSize = std::max<size_t>(grainSize, 1);
+
+	const uint32_t numThreads = Modules::JobSystem ? Modules::JobSystem->GetNumThreads() : 1;
+	if(numThreads > 1)
+	{
+		chunkSize = std::max(chunkSize, numElements / (numThreads * kNumChunksPerThread));
+
+		// Round up to a multiple of the cache line size
+		const size_t numElementsInCacheLine = std::max<size_t>(DESIRE_CACHE_LINE_SIZE / std::max<size_t>(elementSize, 1), 1);
+		chunkSize = (chunkSize + numElementsInCacheLine - 1) / numElementsInCacheLine * numElementsInCacheLine;
+	}
+	else
+	{
+		chunkSize = std::max(chunkSize, numElements);
+	}
+
+	return chunkSize;
+}
+
+void ParallelFor_Internal(size_t numElements, size_t chunkSize, const ParallelForChunkFunc_t& chunkFunc)
+{
+	if(numElements == 0)
+	{
+		return;
+	}
+
+	ASSERT(chunkSize != 0);
+	const size_t numChunks = (numElements + chunkSize - 1) / chunkSize;
+	if(numChunks == 1 || Modules::JobSystem == nullptr || Modules::JobSystem->GetNumThreads() <= 1)
+	{
+		// Serial fallback
+		for(size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+		{
+			const size_t beginIdx = chunkIdx * chunkSize;
+			chunkFunc(chunkIdx, beginIdx, std::min(beginIdx + chunkSize, numElements));
+		}
+		return;
+	}
+
+	JobCounter counter;
+	for(size_t chunkIdx = 1; chunkIdx < numChunks; ++chunkIdx)
+	{
+		const size_t beginIdx = chunkIdx * chunkSize;
+		const size_t endIdx = std::min(beginIdx + chunkSize, numElements);
+		Modules::JobSystem->Run([&chunkFunc, chunkIdx, beginIdx, endIdx]()
+		{
+			chunkFunc(chunkIdx, beginIdx, endIdx);
+		}, &counter);
+	}
+
+	// The calling thread processes the first chunk and helps with the rest while waiting
+	chunkFunc(0, 0, chunkSize);
+	Modules::JobSystem->WaitForCounter(counter);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	ParallelFor and ParallelReduce split an Array into chunks and process them on the threads of Modules::JobSystem.
+//	Each chunk contains at least 'grainSize' elements and the chunk sizes are rounded up to a multiple of the cache line
+//	size so different threads are not writing the same cache line. Arrays which fit into a single chunk are processed
+//	serially on the calling thread (as well as everything when there is no JobSystem).
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef std::function<void(size_t chunkIdx, size_t beginIdx, size_t endIdx)> ParallelForChunkFunc_t;
+
+size_t ParallelFor_CalculateChunkSize(size_t numElements, size_t grainSize, size_t elementSize);
+void ParallelFor_Internal(size_t numElements, size_t chunkSize, const ParallelForChunkFunc_t& chunkFunc);
+
+// Calls 'func' for every element of the array
+template<typename T, typename Func>
+void ParallelFor(Array<T>& array, size_t grainSize, const Func& func)
+{
+	const size_t chunkSize = ParallelFor_CalculateChunkSize(array.Size(), grainSize, sizeof(T));
+	T* pData = array.Data();
+	ParallelFor_Internal(array.Size(), chunkSize, [pData, &func](size_t /*chunkIdx*/, size_t beginIdx, size_t endIdx)
+	{
+		for(size_t i = beginIdx; i < endIdx; ++i)
+		{
+			func(pData[i]);
+		}
+	});
+}
+
+// Returns the result of 'reduceFunc' over the values returned by 'mapFunc' for every element of the array
+// The chunks contain exactly 'grainSize' elements regardless of the number of threads and the partial results are combined
+// in the order of the elements, so the result is deterministic for the same grain size
+template<typename R, typename T, typename MapFunc, typename ReduceFunc>
+R ParallelReduce(const Array<T>& array, size_t grainSize, const R& identity, const MapFunc& mapFunc, const ReduceFunc& reduceFunc)
+{
+	struct alignas(DESIRE_CACHE_LINE_SIZE) PartialResult
+	{
+		R value;
+	};
+
+	const size_t chunkSize = std::max<size_t>(grainSize, 1);
+	const size_t numChunks = (array.Size() + chunkSize - 1) / chunkSize;
+	Array<PartialResult> partialResults;
+	partialResults.SetSize(numChunks);
+
+	const T* pData = array.Data();
+	ParallelFor_Internal(array.Size(), chunkSize, [pData, &partialResults, &identity, &mapFunc, &reduceFunc](size_t chunkIdx, size_t beginIdx, size_t endIdx)
+	{
+		R result = identity;
+		for(size_t i = beginIdx; i < endIdx; ++i)
+		{
+			result = reduceFunc(result, mapFunc(pData[i]));
+		}
+		partialResults[chunkIdx].value = result;
+	});
+
+	R result = identity;
+	for(const PartialResult& partialResult : partialResults)
+	{
+		result = reduceFunc(result, partialResult.value);
+	}
+
+	return result;
+}
@@ -146,14 +146,26 @@ const Matrix4& Transform::GetWorldMatrix() const
 {
 	if(m_flags & WORLD_MATRIX_DIRTY)
 	{
-		m_worldMatrix = ConstructLocalMatrix();
 		if(m_pParent)
 		{
-			m_worldMatrix = m_pParent->GetWorldMatrix() * m_worldMatrix;
+			m_pParent->GetWorldMatrix();
 		}
 
-		m_flags &= ~WORLD_MATRIX_DIRTY;
+		UpdateWorldMatrix();
 	}
 
 	return m_worldMatrix;
 }
+
+void Transform::UpdateWorldMatrix() const
+{
+	ASSERT(m_pParent == nullptr || (m_pParent->m_flags & WORLD_MATRIX_DIRTY) == 0);
+
+	m_worldMatrix = ConstructLocalMatrix();
+	if(m_pParent)
+	{
+		m_worldMatrix = m_pParent->m_worldMatrix * m_worldMatrix;
+	}
+
+	m_flags &= ~WORLD_MATRIX_DIRTY;
+}
@@ -47,9 +47,13 @@ private:
 		POSITION_CHANGED	= 0x01,
 		ROTATION_CHANGED	= 0x02,
 		SCALE_CHANGED		= 0x04,
-		WORLD_MATRIX_DIRTY	= (POSITION_CHANGED | ROTATION_CHANGED | SCALE_CHANGED)
+		WORLD_MATRIX_DIRTY	= (POSITION_CHANGED | ROTATION_CHANGED | SCALE_CHANGED),
+		CHILDREN_DIRTY		= 0x08		// Some transforms below in the hierarchy have a dirty world matrix
 	};
 
+	// Computes the world matrix from the local one and the parent's world matrix, which has to be up-to-date
+	void UpdateWorldMatrix() const;
+
 	Vector3 m_localPosition = Vector3::Zero();
 	Quat m_localRotation = Quat::Identity();
 	Vector3 m_localScale = Vector3::One();
@@ -30,6 +30,17 @@ bool IsPowerOfTwo(size_t x)
 	return (x & (x - 1)) == 0;
 }
 
+size_t RoundUpToPowerOfTwo(size_t x)
+{
+	size_t result = 1;
+	while(result < x)
+	{
+		result <<= 1;
+	}
+
+	return result;
+}
+
 uint32_t SafeSizeToUint32(size_t value)
 {
 	ASSERT(value <= UINT32_MAX);
@@ -1,5 +1,9 @@
 #pragma once
 
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
 namespace Math
 {
 
@@ -14,6 +18,8 @@ int32_t RoundUp(float x, int32_t roundFactor);
 float Sqrt(float x);
 
 bool IsPowerOfTwo(size_t x);
+// Returns the smallest power of two which is greater than or equal to 'x'
+size_t RoundUpToPowerOfTwo(size_t x);
 uint32_t SafeSizeToUint32(size_t value);
 
 // Efficient computation of integer powers. Computes a^e (mod UINT32_MAX)
@@ -38,6 +44,38 @@ constexpr T RadToDeg(T rad)
 	return rad * 57.2957795130f;		// rad * (180.0f / Pi)
 }
 
+// Returns the index of the lowest set bit (undefined for 0)
+inline uint32_t CountTrailingZeros(uint32_t x)
+{
+#if defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanForward(&idx, x);
+	return idx;
+#else
+	return __builtin_ctz(x);
+#endif
+}
+
+// Returns the index of the highest set bit (undefined for 0)
+inline uint32_t FindLastSetBit(uint32_t x)
+{
+#if defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanReverse(&idx, x);
+	return idx;
+#else
+	return 31 - __builtin_clz(x);
+#endif
+}
+
+// Returns the number of set bits
+inline uint32_t CountSetBits(uint32_t x)
+{
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
 // Returns linear interpolation of 'x' and 'y' with ratio 't'
 // NOTE: Does not clamp 't' between 0 and 1
 template<typename T>
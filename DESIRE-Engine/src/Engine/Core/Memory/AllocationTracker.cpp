@@ -0,0 +1,287 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Memory/AllocationTracker.h"
+
+#include "Engine/Core/Memory/MemorySystem.h"
+#include "Engine/Core/SpinLock.h"
+
+#include <unordered_map>
+
+// The internal containers use the system allocator directly to avoid recursion into the MemorySystem
+template<typename T>
+struct TrackerStdAllocator
+{
+	typedef T value_type;
+
+	TrackerStdAllocator() = default;
+	template<typename U> TrackerStdAllocator(const TrackerStdAllocator<U>&) {}
+
+	T* allocate(size_t n)				{ return static_cast<T*>(MemorySystem::SystemAlloc(n * sizeof(T))); }
+	void deallocate(T* p, size_t)		{ MemorySystem::SystemFree(p); }
+
+	template<typename U> bool operator ==(const TrackerStdAllocator<U>&) const	{ return true; }
+	template<typename U> bool operator !=(const TrackerStdAllocator<U>&) const	{ return false; }
+};
+
+template<typename K, typename V>
+using TrackerHashMap = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, TrackerStdAllocator<std::pair<const K, V>>>;
+
+template<typename T>
+using TrackerVector = std::vector<T, TrackerStdAllocator<T>>;
+
+struct TrackedAllocation
+{
+	uint32_t callSiteIdx;
+	size_t size;
+};
+
+// Counts the tracked allocations by the hash of their address, so the frees of the not sampled allocations can skip
+// the lock and the lookup when their bucket is empty
+static constexpr uint32_t kTrackedAddressBucketsShift = 18;
+
+static size_t GetTrackedAddressBucketIdx(const void* pMemory)
+{
+	return (reinterpret_cast<uint64_t>(pMemory) * 0x9E3779B97F4A7C15ULL) >> (64 - kTrackedAddressBucketsShift);
+}
+
+struct AllocationTrackerData
+{
+	SpinLock spinLock;
+	TrackerVector<AllocationTracker::CallSite> callSites;
+	TrackerVector<uint64_t> numAllocationsInCurrentFrame;
+	TrackerHashMap<uint64_t, uint32_t> callSiteIndices;		// Call stack hash -> index into 'callSites'
+	TrackerHashMap<const void*, TrackedAllocation> trackedAllocations;
+	std::atomic<uint32_t> trackedAddressBuckets[size_t(1) << kTrackedAddressBucketsShift] = {};
+};
+
+std::atomic<uint32_t> AllocationTracker::s_samplingRate = 0;
+std::atomic<size_t> AllocationTracker::s_numTrackedAllocations = 0;
+
+// Created on the first use and never destroyed, because memory can be freed during the static destruction as well
+static std::atomic<AllocationTrackerData*> s_pTrackerData = nullptr;
+static SpinLock s_trackerDataCreationSpinLock;
+static thread_local uint32_t s_numAllocationsSinceLastSample = 0;
+
+static AllocationTrackerData& GetTrackerData()
+{
+	AllocationTrackerData* pData = s_pTrackerData.load(std::memory_order_acquire);
+	if(pData == nullptr)
+	{
+		DESIRE_SCOPED_SPINLOCK(s_trackerDataCreationSpinLock);
+		pData = s_pTrackerData.load(std::memory_order_relaxed);
+		if(pData == nullptr)
+		{
+			alignas(AllocationTrackerData) static uint8_t s_trackerDataStorage[sizeof(AllocationTrackerData)];
+			pData = new(s_trackerDataStorage) AllocationTrackerData();
+			s_pTrackerData.store(pData, std::memory_order_release);
+		}
+	}
+
+	return *pData;
+}
+
+static uint64_t CalculateStackHash(void* const* ppFrames, uint32_t numFrames)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ULL;
+	for(uint32_t i = 0; i < numFrames; ++i)
+	{
+		hash ^= reinterpret_cast<uint64_t>(ppFrames[i]);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+template<typename Compare>
+static Array<AllocationTracker::CallSite> CollectCallSites(size_t maxNumCallSites, bool(*pFilter)(const AllocationTracker::CallSite&), Compare compare)
+{
+	// Copy under the lock to the internal vector, because an Array allocation would call back into the tracker
+	TrackerVector<AllocationTracker::CallSite> callSites;
+	AllocationTrackerData& data = GetTrackerData();
+	{
+		DESIRE_SCOPED_SPINLOCK(data.spinLock);
+		callSites.reserve(data.callSites.size());
+		for(const AllocationTracker::CallSite& callSite : data.callSites)
+		{
+			if(pFilter(callSite))
+			{
+				callSites.push_back(callSite);
+			}
+		}
+	}
+
+	const size_t numCallSites = std::min(maxNumCallSites, callSites.size());
+	std::partial_sort(callSites.begin(), callSites.begin() + numCallSites, callSites.end(), compare);
+
+	Array<AllocationTracker::CallSite> result;
+	result.SetSize(numCallSites);
+	std::copy(callSites.begin(), callSites.begin() + numCallSites, result.begin());
+	return result;
+}
+
+void AllocationTracker::SetSamplingRate(uint32_t samplingRate)
+{
+	if(samplingRate != 0)
+	{
+		GetTrackerData();
+	}
+
+	s_samplingRate.store(samplingRate, std::memory_order_relaxed);
+}
+
+uint32_t AllocationTracker::GetSamplingRate()
+{
+	return s_samplingRate.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::EndFrame()
+{
+	AllocationTrackerData* pData = s_pTrackerData.load(std::memory_order_acquire);
+	if(pData == nullptr)
+	{
+		return;
+	}
+
+	DESIRE_SCOPED_SPINLOCK(pData->spinLock);
+	for(size_t i = 0; i < pData->callSites.size(); ++i)
+	{
+		pData->callSites[i].numAllocationsInLastFrame = pData->numAllocationsInCurrentFrame[i];
+		pData->numAllocationsInCurrentFrame[i] = 0;
+	}
+}
+
+Array<AllocationTracker::CallSite> AllocationTracker::GetLeakedCallSites()
+{
+	return CollectCallSites(SIZE_MAX,
+		[](const CallSite& callSite) { return callSite.numLiveAllocations != 0; },
+		[](const CallSite& a, const CallSite& b) { return a.liveBytes > b.liveBytes; });
+}
+
+Array<AllocationTracker::CallSite> AllocationTracker::GetTopCallSitesInLastFrame(size_t maxNumCallSites)
+{
+	return CollectCallSites(maxNumCallSites,
+		[](const CallSite& callSite) { return callSite.numAllocationsInLastFrame != 0; },
+		[](const CallSite& a, const CallSite& b) { return a.numAllocationsInLastFrame > b.numAllocationsInLastFrame; });
+}
+
+void AllocationTracker::LogLeakReport()
+{
+	if(s_pTrackerData.load(std::memory_order_acquire) == nullptr)
+	{
+		return;
+	}
+
+	const uint64_t samplingRate = std::max(GetSamplingRate(), 1u);
+	const Array<CallSite> callSites = GetLeakedCallSites();
+	if(callSites.IsEmpty())
+	{
+		LOG_MESSAGE("AllocationTracker: No leaks detected (sampling rate: %u)", static_cast<uint32_t>(samplingRate));
+		return;
+	}
+
+	LOG_WARNING("AllocationTracker: Leaks detected at %zu call sites (sampling rate: %u)", callSites.Size(), static_cast<uint32_t>(samplingRate));
+	for(const CallSite& callSite : callSites)
+	{
+		LogCallSite_Internal(callSite, callSite.numLiveAllocations * samplingRate, callSite.liveBytes * samplingRate);
+	}
+}
+
+void AllocationTracker::LogChurnReport(size_t maxNumCallSites)
+{
+	if(s_pTrackerData.load(std::memory_order_acquire) == nullptr)
+	{
+		return;
+	}
+
+	const uint64_t samplingRate = std::max(GetSamplingRate(), 1u);
+	const Array<CallSite> callSites = GetTopCallSitesInLastFrame(maxNumCallSites);
+	LOG_MESSAGE("AllocationTracker: Top %zu call sites in the last frame (sampling rate: %u)", callSites.Size(), static_cast<uint32_t>(samplingRate));
+	for(const CallSite& callSite : callSites)
+	{
+		LogCallSite_Internal(callSite, callSite.numAllocationsInLastFrame * samplingRate, 0);
+	}
+}
+
+void AllocationTracker::OnAlloc_Internal(void* pMemory, size_t size)
+{
+	const uint32_t samplingRate = s_samplingRate.load(std::memory_order_relaxed);
+	if(++s_numAllocationsSinceLastSample < samplingRate)
+	{
+		return;
+	}
+	s_numAllocationsSinceLastSample = 0;
+
+	void* frames[kMaxStackDepth];
+	const uint32_t numFrames = CaptureStackTrace_Internal(frames, kMaxStackDepth);
+	const uint64_t stackHash = CalculateStackHash(frames, numFrames);
+
+	AllocationTrackerData& data = GetTrackerData();
+	DESIRE_SCOPED_SPINLOCK(data.spinLock);
+
+	auto it = data.callSiteIndices.find(stackHash);
+	if(it == data.callSiteIndices.end())
+	{
+		CallSite callSite = {};
+		std::copy(frames, frames + numFrames, callSite.frames);
+		callSite.numFrames = numFrames;
+
+		it = data.callSiteIndices.emplace(stackHash, static_cast<uint32_t>(data.callSites.size())).first;
+		data.callSites.push_back(callSite);
+		data.numAllocationsInCurrentFrame.push_back(0);
+	}
+
+	const uint32_t callSiteIdx = it->second;
+	CallSite& callSite = data.callSites[callSiteIdx];
+	callSite.numAllocations++;
+	callSite.numLiveAllocations++;
+	callSite.liveBytes += size;
+	data.numAllocationsInCurrentFrame[callSiteIdx]++;
+
+	if(data.trackedAllocations.emplace(pMemory, TrackedAllocation{ callSiteIdx, size }).second)
+	{
+		data.trackedAddressBuckets[GetTrackedAddressBucketIdx(pMemory)].fetch_add(1, std::memory_order_relaxed);
+		s_numTrackedAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void AllocationTracker::OnFree_Internal(void* pMemory)
+{
+	AllocationTrackerData& data = GetTrackerData();
+
+	// The memory can only be freed after its allocation has returned, so the bucket already counts it if it was sampled
+	std::atomic<uint32_t>& trackedAddressBucket = data.trackedAddressBuckets[GetTrackedAddressBucketIdx(pMemory)];
+	if(trackedAddressBucket.load(std::memory_order_relaxed) == 0)
+	{
+		return;
+	}
+
+	DESIRE_SCOPED_SPINLOCK(data.spinLock);
+
+	auto it = data.trackedAllocations.find(pMemory);
+	if(it == data.trackedAllocations.end())
+	{
+		return;
+	}
+
+	CallSite& callSite = data.callSites[it->second.callSiteIdx];
+	callSite.numLiveAllocations--;
+	callSite.liveBytes -= it->second.size;
+
+	data.trackedAllocations.erase(it);
+	trackedAddressBucket.fetch_sub(1, std::memory_order_relaxed);
+	s_numTrackedAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void AllocationTracker::LogCallSite_Internal(const CallSite& callSite, uint64_t estimatedCount, uint64_t estimatedBytes)
+{
+	if(estimatedBytes != 0)
+	{
+		LOG_MESSAGE("  ~%llu allocations, ~%llu bytes", static_cast<unsigned long long>(estimatedCount), static_cast<unsigned long long>(estimatedBytes));
+	}
+	else
+	{
+		LOG_MESSAGE("  ~%llu allocations", static_cast<unsigned long long>(estimatedCount));
+	}
+
+	LogStackTrace_Internal(callSite.frames, callSite.numFrames);
+}
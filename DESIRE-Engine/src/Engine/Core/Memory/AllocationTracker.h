@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	AllocationTracker records the call stack of sampled MemorySystem allocations to find leaks and allocation churn.
+//	Every N-th allocation of each thread is recorded (N is the sampling rate), so the counts are estimates which can
+//	be scaled back by the sampling rate. The call stacks are stored once in a database keyed by their hash.
+//	The tracking is disabled by default and costs only an atomic load per allocation in that case. While it is enabled,
+//	the frees of the not sampled allocations are filtered out by an address hash, without taking the lock.
+// --------------------------------------------------------------------------------------------------------------------
+
+class AllocationTracker
+{
+public:
+	static constexpr uint32_t kMaxStackDepth = 16;
+
+	struct CallSite
+	{
+		void* frames[kMaxStackDepth];
+		uint32_t numFrames;
+		uint64_t numAllocations;				// The number of sampled allocations since the tracking was enabled
+		uint64_t numAllocationsInLastFrame;		// The number of sampled allocations in the last frame
+		uint64_t numLiveAllocations;
+		uint64_t liveBytes;
+	};
+
+	// Every 'samplingRate'-th allocation is recorded on each thread, 0 disables the tracking
+	static void SetSamplingRate(uint32_t samplingRate);
+	static uint32_t GetSamplingRate();
+
+	// Called by the MemorySystem
+	static void OnAlloc(void* pMemory, size_t size)
+	{
+		if(s_samplingRate.load(std::memory_order_relaxed) != 0 && pMemory != nullptr)
+		{
+			OnAlloc_Internal(pMemory, size);
+		}
+	}
+
+	static void OnFree(void* pMemory)
+	{
+		if(s_numTrackedAllocations.load(std::memory_order_relaxed) != 0)
+		{
+			OnFree_Internal(pMemory);
+		}
+	}
+
+	// Closes the current frame for the churn statistics (this should happen once per frame)
+	static void EndFrame();
+
+	// Returns the call sites with live allocations sorted by the live bytes
+	static Array<CallSite> GetLeakedCallSites();
+	// Returns the call sites with the most allocations in the last frame
+	static Array<CallSite> GetTopCallSitesInLastFrame(size_t maxNumCallSites);
+
+	static void LogLeakReport();
+	static void LogChurnReport(size_t maxNumCallSites);
+
+private:
+	static void OnAlloc_Internal(void* pMemory, size_t size);
+	static void OnFree_Internal(void* pMemory);
+	static void LogCallSite_Internal(const CallSite& callSite, uint64_t estimatedCount, uint64_t estimatedBytes);
+
+	// Platform specific
+	static uint32_t CaptureStackTrace_Internal(void** ppFrames, uint32_t maxFrames);
+	static void LogStackTrace_Internal(void* const* ppFrames, uint32_t numFrames);
+
+	static std::atomic<uint32_t> s_samplingRate;
+	static std::atomic<size_t> s_numTrackedAllocations;
+};
@@ -0,0 +1,36 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Memory/AllocationTracker.h"
+
+#if DESIRE_PLATFORM_LINUX
+
+#include <execinfo.h>
+
+// Skip the frames of the tracker and the MemorySystem
+static constexpr int kNumFramesToSkip = 3;
+
+uint32_t AllocationTracker::CaptureStackTrace_Internal(void** ppFrames, uint32_t maxFrames)
+{
+	void* frames[kNumFramesToSkip + kMaxStackDepth];
+	const int numFrames = backtrace(frames, static_cast<int>(std::min<uint32_t>(kNumFramesToSkip + maxFrames, DESIRE_ASIZEOF(frames))));
+	if(numFrames <= kNumFramesToSkip)
+	{
+		return 0;
+	}
+
+	std::copy(frames + kNumFramesToSkip, frames + numFrames, ppFrames);
+	return static_cast<uint32_t>(numFrames - kNumFramesToSkip);
+}
+
+void AllocationTracker::LogStackTrace_Internal(void* const* ppFrames, uint32_t numFrames)
+{
+	char** ppSymbols = backtrace_symbols(ppFrames, static_cast<int>(numFrames));
+	for(uint32_t i = 0; i < numFrames; ++i)
+	{
+		LOG_MESSAGE("    %s", (ppSymbols != nullptr) ? ppSymbols[i] : "?");
+	}
+
+	// backtrace_symbols() allocates with malloc()
+	free(ppSymbols);
+}
+
+#endif	// #if DESIRE_PLATFORM_LINUX
@@ -0,0 +1,25 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Memory/AllocationTracker.h"
+
+#if DESIRE_PLATFORM_WINDOWS
+
+#include "Engine/Core/WINDOWS/os.h"
+
+// Skip the frames of the tracker and the MemorySystem
+static constexpr DWORD kNumFramesToSkip = 3;
+
+uint32_t AllocationTracker::CaptureStackTrace_Internal(void** ppFrames, uint32_t maxFrames)
+{
+	return RtlCaptureStackBackTrace(kNumFramesToSkip, maxFrames, ppFrames, nullptr);
+}
+
+void AllocationTracker::LogStackTrace_Internal(void* const* ppFrames, uint32_t numFrames)
+{
+	// Only the addresses are logged, they can be resolved with the PDB
+	for(uint32_t i = 0; i < numFrames; ++i)
+	{
+		LOG_MESSAGE("    0x%p", ppFrames[i]);
+	}
+}
+
+#endif	// #if DESIRE_PLATFORM_WINDOWS
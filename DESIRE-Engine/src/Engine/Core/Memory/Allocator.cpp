@@ -1,7 +1,7 @@
 #include "Engine/stdafx.h"
 #include "Engine/Core/Memory/Allocator.h"
 
-#include "Engine/Core/Memory/SystemAllocator.h"
+#include "Engine/Core/Memory/SmallObjectAllocator.h"
 
 void* Allocator::Realloc(void* pMemory, size_t newSize, size_t oldSize)
 {
@@ -11,6 +11,32 @@ void* Allocator::Realloc(void* pMemory, size_t newSize, size_t oldSize)
 	return pNewMemory;
 }
 
+void* Allocator::AllocWithoutHeader(size_t /*size*/, size_t /*alignment*/)
+{
+	return nullptr;
+}
+
+size_t Allocator::GetMaxSizeWithoutHeader() const
+{
+	return 0;
+}
+
+bool Allocator::IsAllocationWithoutHeader(const void* /*pMemory*/) const
+{
+	return true;
+}
+
+size_t Allocator::GetAllocationSize(const void* /*pMemory*/) const
+{
+	ASSERT(false && "The allocator doesn't support allocations without header");
+	return 0;
+}
+
+EMemoryTag Allocator::GetAllocationTag(const void* /*pMemory*/) const
+{
+	return EMemoryTag::Untagged;
+}
+
 uint64_t Allocator::GetAllocatedBytes() const
 {
 	return m_allocatedBytes;
@@ -18,6 +44,8 @@ uint64_t Allocator::GetAllocatedBytes() const
 
 Allocator& Allocator::GetDefaultAllocator()
 {
-	static SystemAllocator s_defaultAllocator;
-	return s_defaultAllocator;
+	// The default allocator is never destroyed as memory can be freed from destructors of other static objects
+	alignas(SmallObjectAllocator) static uint8_t s_defaultAllocatorStorage[sizeof(SmallObjectAllocator)];
+	static SmallObjectAllocator* s_pDefaultAllocator = new(s_defaultAllocatorStorage) SmallObjectAllocator();
+	return *s_pDefaultAllocator;
 }
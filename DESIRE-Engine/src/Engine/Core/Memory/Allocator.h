@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Core/Memory/MemoryTag.h"
+
 // --------------------------------------------------------------------------------------------------------------------
 //	Base class for memory allocators
 // --------------------------------------------------------------------------------------------------------------------
@@ -14,6 +16,18 @@ public:
 	virtual void* Realloc(void* pMemory, size_t newSize, size_t oldSize);
 	virtual void Free(void* pMemory, size_t size) = 0;
 
+	// Allocators which register their memory with MemorySystem::RegisterHeaderlessPages() can serve the MemorySystem without an allocation header
+	// Returns nullptr if the allocation can't be done this way (the MemorySystem falls back to Alloc() with a header)
+	virtual void* AllocWithoutHeader(size_t size, size_t alignment);
+	// Returns the largest size which can be allocated by AllocWithoutHeader() (0 if the allocator doesn't support it)
+	virtual size_t GetMaxSizeWithoutHeader() const;
+	// Returns whether the memory on a registered page was returned by AllocWithoutHeader() (the memory of Alloc() can be on the same pages)
+	virtual bool IsAllocationWithoutHeader(const void* pMemory) const;
+	// Returns the usable size of an allocation made by AllocWithoutHeader()
+	virtual size_t GetAllocationSize(const void* pMemory) const;
+	// Returns the memory tag which was active when the allocation was made by AllocWithoutHeader()
+	virtual EMemoryTag GetAllocationTag(const void* pMemory) const;
+
 	uint64_t GetAllocatedBytes() const;
 
 	static Allocator& GetDefaultAllocator();
@@ -1,13 +1,251 @@
 #include "Engine/stdafx.h"
 #include "Engine/Core/Memory/MemorySystem.h"
 
+#include "Engine/Core/Container/Array.h"
 #include "Engine/Core/Math/math.h"
-#include "Engine/Core/Memory/LinearAllocator.h"
+#include "Engine/Core/Memory/AllocationTracker.h"
+#include "Engine/Core/Memory/VirtualArenaAllocator.h"
+#include "Engine/Core/SpinLock.h"
 
-static constexpr size_t kAllocatorStackSize = 16;
+static constexpr size_t kAllocatorStackSize = MemorySystem::ScopeStacks::kMaxDepth;
 static thread_local Allocator* s_allocatorStack[kAllocatorStackSize] = {};
 static thread_local size_t s_allocatorStackIndex = 0;
 
+// Two-level page map from the addresses of the headerless pages to their allocators (covering a 48-bit address space)
+static constexpr size_t kPageMapPageShift = 16;
+static constexpr size_t kPageMapLeafShift = 16;
+static constexpr size_t kPageMapNumLeaves = size_t(1) << (48 - kPageMapPageShift - kPageMapLeafShift);
+static_assert(MemorySystem::kHeaderlessPageSize == size_t(1) << kPageMapPageShift);
+
+struct PageMapLeaf
+{
+	std::atomic<Allocator*> allocators[size_t(1) << kPageMapLeafShift];
+};
+
+static std::atomic<PageMapLeaf*> s_pageMap[kPageMapNumLeaves] = {};
+
+static constexpr size_t kMemoryTagStackSize = MemorySystem::ScopeStacks::kMaxDepth;
+static thread_local EMemoryTag s_memoryTagStack[kMemoryTagStackSize] = {};
+static thread_local size_t s_memoryTagStackIndex = 0;
+
+static constexpr size_t kNumMemoryTags = static_cast<size_t>(EMemoryTag::Num);
+
+static constexpr const char* kMemoryTagNames[] =
+{
+	"Untagged",
+	"Render",
+	"Physics",
+	"Script",
+	"Resource",
+	"UI",
+	"Sound",
+	"Network",
+	"Application",
+};
+DESIRE_CHECK_ARRAY_SIZE(kMemoryTagNames, EMemoryTag::Num)
+
+struct MemoryTagCounters
+{
+	std::atomic<int64_t> liveBytes;
+	std::atomic<int64_t> numLiveAllocations;
+	std::atomic<uint64_t> numAllocations;
+	std::atomic<uint64_t> allocatedBytes;
+};
+
+// The counters of a thread are only written by the thread itself, so allocations don't need atomic read-modify-write operations
+// They are summed up by SampleMemoryTagStats() and merged into the retired counters when the thread exits
+struct ThreadMemoryTagCounters
+{
+	MemoryTagCounters counters[kNumMemoryTags];
+	ThreadMemoryTagCounters* pNext;
+	bool isRegistered;
+	bool isRetired;
+};
+
+struct ThreadMemoryTagCountersRetirer
+{
+	~ThreadMemoryTagCountersRetirer();
+	bool isActive = false;
+};
+
+static thread_local ThreadMemoryTagCounters s_threadMemoryTagCounters;
+static thread_local ThreadMemoryTagCountersRetirer s_threadMemoryTagCountersRetirer;
+
+static SpinLock s_memoryTagSpinLock;
+static ThreadMemoryTagCounters* s_pFirstThreadMemoryTagCounters = nullptr;
+static MemoryTagCounters s_retiredMemoryTagCounters[kNumMemoryTags] = {};
+static MemorySystem::MemoryTagStats s_memoryTagStats[kNumMemoryTags] = {};
+static uint64_t s_prevNumAllocations[kNumMemoryTags] = {};
+static uint64_t s_prevAllocatedBytes[kNumMemoryTags] = {};
+static MemorySystem::MemoryTagStatsCallback_t s_memoryTagStatsCallback;
+
+ThreadMemoryTagCountersRetirer::~ThreadMemoryTagCountersRetirer()
+{
+	// The thread_local objects of this file are initialized together, so this can exist without the counters being registered
+	if(!isActive)
+	{
+		return;
+	}
+
+	ThreadMemoryTagCounters& threadCounters = s_threadMemoryTagCounters;
+
+	DESIRE_SCOPED_SPINLOCK(s_memoryTagSpinLock);
+	ThreadMemoryTagCounters** ppCounters = &s_pFirstThreadMemoryTagCounters;
+	while(*ppCounters != &threadCounters)
+	{
+		ppCounters = &(*ppCounters)->pNext;
+	}
+	*ppCounters = threadCounters.pNext;
+
+	for(size_t i = 0; i < kNumMemoryTags; ++i)
+	{
+		s_retiredMemoryTagCounters[i].liveBytes += threadCounters.counters[i].liveBytes;
+		s_retiredMemoryTagCounters[i].numLiveAllocations += threadCounters.counters[i].numLiveAllocations;
+		s_retiredMemoryTagCounters[i].numAllocations += threadCounters.counters[i].numAllocations;
+		s_retiredMemoryTagCounters[i].allocatedBytes += threadCounters.counters[i].allocatedBytes;
+	}
+
+	// Memory freed after this point (by destructors of other thread_local objects) goes directly to the retired counters
+	threadCounters.isRetired = true;
+}
+
+static void TrackMemoryTag(EMemoryTag tag, int64_t size)
+{
+	ThreadMemoryTagCounters& threadCounters = s_threadMemoryTagCounters;
+	if(!threadCounters.isRegistered)
+	{
+		threadCounters.isRegistered = true;
+		s_threadMemoryTagCountersRetirer.isActive = true;
+
+		DESIRE_SCOPED_SPINLOCK(s_memoryTagSpinLock);
+		threadCounters.pNext = s_pFirstThreadMemoryTagCounters;
+		s_pFirstThreadMemoryTagCounters = &threadCounters;
+	}
+
+	const int64_t numAllocations = (size >= 0) ? 1 : -1;
+	if(threadCounters.isRetired)
+	{
+		MemoryTagCounters& counters = s_retiredMemoryTagCounters[static_cast<size_t>(tag)];
+		counters.liveBytes += size;
+		counters.numLiveAllocations += numAllocations;
+		if(size >= 0)
+		{
+			counters.numAllocations++;
+			counters.allocatedBytes += size;
+		}
+		return;
+	}
+
+	MemoryTagCounters& counters = threadCounters.counters[static_cast<size_t>(tag)];
+	counters.liveBytes.store(counters.liveBytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+	counters.numLiveAllocations.store(counters.numLiveAllocations.load(std::memory_order_relaxed) + numAllocations, std::memory_order_relaxed);
+	if(size >= 0)
+	{
+		counters.numAllocations.store(counters.numAllocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		counters.allocatedBytes.store(counters.allocatedBytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+	}
+}
+
+// Only the used part of the address range is backed by physical memory, so it can be generous
+static std::atomic<size_t> s_scratchAllocatorReservedSize = 1024 * 1024 * 1024;
+static std::atomic<uint32_t> s_scratchAllocatorGeneration = 0;
+
+// The scratch and frame allocators of all threads for the stats
+struct ScratchAllocatorRegistry
+{
+	SpinLock spinLock;
+	Array<const VirtualArenaAllocator*> allocators;
+
+	static ScratchAllocatorRegistry& GetForScratchAllocators()
+	{
+		static ScratchAllocatorRegistry s_registry;
+		return s_registry;
+	}
+
+	static ScratchAllocatorRegistry& GetForFrameAllocators()
+	{
+		static ScratchAllocatorRegistry s_registry;
+		return s_registry;
+	}
+
+	MemorySystem::ScratchAllocatorStats GetStats()
+	{
+		MemorySystem::ScratchAllocatorStats stats = {};
+
+		DESIRE_SCOPED_SPINLOCK(spinLock);
+		for(const VirtualArenaAllocator* pAllocator : allocators)
+		{
+			stats.highWaterMark = std::max(stats.highWaterMark, pAllocator->GetHighWaterMark());
+			stats.committedBytes += pAllocator->GetCommittedSize();
+			stats.reservedBytes += pAllocator->GetReservedSize();
+		}
+		stats.numThreads = static_cast<uint32_t>(allocators.Size());
+
+		return stats;
+	}
+};
+
+// The committed pages are kept up to the high water mark, so the following frames don't commit them again
+static void ResetKeepingCommittedMemory(VirtualArenaAllocator& allocator)
+{
+	allocator.Reset(allocator.GetHighWaterMark());
+}
+
+struct ThreadScratchAllocator
+{
+	VirtualArenaAllocator allocator;
+	uint32_t generation;
+
+	ThreadScratchAllocator()
+		: allocator(s_scratchAllocatorReservedSize)
+		, generation(s_scratchAllocatorGeneration)
+	{
+		ScratchAllocatorRegistry& registry = ScratchAllocatorRegistry::GetForScratchAllocators();
+		DESIRE_SCOPED_SPINLOCK(registry.spinLock);
+		registry.allocators.Add(&allocator);
+	}
+
+	~ThreadScratchAllocator()
+	{
+		ScratchAllocatorRegistry& registry = ScratchAllocatorRegistry::GetForScratchAllocators();
+		DESIRE_SCOPED_SPINLOCK(registry.spinLock);
+		registry.allocators.RemoveFast(&allocator);
+	}
+};
+
+static std::atomic<uint64_t> s_frameAllocatorFrameIdx = 0;
+
+struct ThreadFrameAllocators
+{
+	std::unique_ptr<VirtualArenaAllocator> spAllocators[MemorySystem::kNumFrameAllocatorBuffers];
+	uint64_t frameIdx;
+
+	ThreadFrameAllocators()
+		: frameIdx(s_frameAllocatorFrameIdx)
+	{
+		ScratchAllocatorRegistry& registry = ScratchAllocatorRegistry::GetForFrameAllocators();
+		DESIRE_SCOPED_SPINLOCK(registry.spinLock);
+		for(std::unique_ptr<VirtualArenaAllocator>& spAllocator : spAllocators)
+		{
+			spAllocator = std::make_unique<VirtualArenaAllocator>(s_scratchAllocatorReservedSize);
+			registry.allocators.Add(spAllocator.get());
+		}
+	}
+
+	~ThreadFrameAllocators()
+	{
+		ScratchAllocatorRegistry& registry = ScratchAllocatorRegistry::GetForFrameAllocators();
+		DESIRE_SCOPED_SPINLOCK(registry.spinLock);
+		for(std::unique_ptr<VirtualArenaAllocator>& spAllocator : spAllocators)
+		{
+			registry.allocators.RemoveFast(spAllocator.get());
+		}
+	}
+};
+
+static thread_local std::unique_ptr<ThreadScratchAllocator> s_spScratchAllocator;
+static thread_local std::unique_ptr<ThreadFrameAllocators> s_spFrameAllocators;
+
 // Helper functions
 static void* OffsetVoidPtr(const void* pMemory, size_t offset)				{ return reinterpret_cast<void*>(reinterpret_cast<size_t>(pMemory) + offset); }
 static void* OffsetVoidPtrBackwards(const void* pMemory, size_t offset)		{ return reinterpret_cast<void*>(reinterpret_cast<size_t>(pMemory) - offset); }
@@ -17,6 +255,53 @@ template<typename T> static T* OffsetVoidPtrBackwards(const void* pMemory)	{ ret
 static size_t Align(size_t value, size_t alignment)							{ alignment--; return (value + alignment) & ~alignment; }
 static void* Align(void* pMemory, size_t alignment)							{ return reinterpret_cast<void*>(Align(reinterpret_cast<size_t>(pMemory), alignment)); }
 
+void* MemorySystem::AllocFromAllocator(Allocator& allocator, size_t size, size_t alignment)
+{
+	void* pMemory = AllocWithoutHeaderFromAllocator(allocator, size, alignment);
+	if(pMemory)
+	{
+		return pMemory;
+	}
+
+	return AllocWithHeaderFromAllocator(allocator, size, alignment);
+}
+
+void* MemorySystem::AllocWithHeaderFromAllocator(Allocator& allocator, size_t size, size_t alignment)
+{
+	const EMemoryTag tag = GetActiveMemoryTag();
+	const size_t totalSize = size + std::max(kDefaultAlignment, alignment);
+	void* pAllocatedMemory = allocator.Alloc(totalSize);
+	if(pAllocatedMemory)
+	{
+		// Make room for the header and apply alignment
+		void* pMemory = Align(OffsetVoidPtr(pAllocatedMemory, sizeof(AllocationHeader)), alignment);
+
+		AllocationHeader* pHeader = OffsetVoidPtrBackwards<AllocationHeader>(pMemory);
+		pHeader->pAllocator = &allocator;
+		pHeader->allocatedSize = Math::SafeSizeToUint32(totalSize);
+		pHeader->offsetBetweenPtrAndAllocatedMemory = Math::SafeSizeToUint32(reinterpret_cast<size_t>(pMemory) - reinterpret_cast<size_t>(pAllocatedMemory));
+		pHeader->tag = static_cast<uint32_t>(tag);
+		ASSERT(pHeader->offsetBetweenPtrAndAllocatedMemory == reinterpret_cast<size_t>(pMemory) - reinterpret_cast<size_t>(pAllocatedMemory) && "Alignment is too big");
+
+		TrackMemoryTag(tag, totalSize);
+		return pMemory;
+	}
+
+	ASSERT(false && "Out of memory");
+	return nullptr;
+}
+
+void* MemorySystem::AllocWithoutHeaderFromAllocator(Allocator& allocator, size_t size, size_t alignment)
+{
+	void* pMemory = allocator.AllocWithoutHeader(size, alignment);
+	if(pMemory)
+	{
+		TrackMemoryTag(allocator.GetAllocationTag(pMemory), allocator.GetAllocationSize(pMemory));
+	}
+
+	return pMemory;
+}
+
 void* MemorySystem::Alloc(size_t size, size_t alignment)
 {
 	ASSERT(Math::IsPowerOfTwo(alignment));
@@ -24,23 +309,9 @@ void* MemorySystem::Alloc(size_t size, size_t alignment)
 
 	if(size != 0)
 	{
-		const size_t totalSize = size + std::max(kDefaultAlignment, alignment);
-		Allocator& allocator = GetActiveAllocator();
-		void* pAllocatedMemory = allocator.Alloc(totalSize);
-		if(pAllocatedMemory)
-		{
-			// Make room for the header and apply alignment
-			void* pMemory = Align(OffsetVoidPtr(pAllocatedMemory, sizeof(AllocationHeader)), alignment);
-
-			AllocationHeader* pHeader = OffsetVoidPtrBackwards<AllocationHeader>(pMemory);
-			pHeader->pAllocator = &allocator;
-			pHeader->allocatedSize = Math::SafeSizeToUint32(totalSize);
-			pHeader->offsetBetweenPtrAndAllocatedMemory = Math::SafeSizeToUint32(reinterpret_cast<size_t>(pMemory) - reinterpret_cast<size_t>(pAllocatedMemory));
-
-			return pMemory;
-		}
-
-		ASSERT(false && "Out of memory");
+		void* pMemory = AllocFromAllocator(GetActiveAllocator(), size, alignment);
+		AllocationTracker::OnAlloc(pMemory, size);
+		return pMemory;
 	}
 
 	return nullptr;
@@ -69,8 +340,64 @@ void* MemorySystem::Realloc(void* pMemory, size_t size)
 		return MemorySystem::Alloc(size);
 	}
 
+	AllocationTracker::OnFree(pMemory);
+	void* pNewMemory = ReallocFromAllocator(pMemory, size);
+	AllocationTracker::OnAlloc(pNewMemory, size);
+	return pNewMemory;
+}
+
+void MemorySystem::Free(void* pMemory)
+{
+	if(pMemory == nullptr)
+	{
+		return;
+	}
+
+	AllocationTracker::OnFree(pMemory);
+
+	Allocator* pHeaderlessAllocator = FindHeaderlessAllocator(pMemory);
+	if(pHeaderlessAllocator && pHeaderlessAllocator->IsAllocationWithoutHeader(pMemory))
+	{
+		const size_t size = pHeaderlessAllocator->GetAllocationSize(pMemory);
+		TrackMemoryTag(pHeaderlessAllocator->GetAllocationTag(pMemory), -static_cast<int64_t>(size));
+		pHeaderlessAllocator->Free(pMemory, size);
+		return;
+	}
+
+	const AllocationHeader* pHeader = OffsetVoidPtrBackwards<AllocationHeader>(pMemory);
+	ASSERT(pHeader->offsetBetweenPtrAndAllocatedMemory != 0xFDFDFD && "Windows Debug Heap's NoMansLand buffer detected. The memory was not allocated by the MemorySystem");
+	void* pAllocatedMemory = OffsetVoidPtrBackwards(pMemory, pHeader->offsetBetweenPtrAndAllocatedMemory);
+
+	TrackMemoryTag(static_cast<EMemoryTag>(pHeader->tag), -static_cast<int64_t>(pHeader->allocatedSize));
+	pHeader->pAllocator->Free(pAllocatedMemory, pHeader->allocatedSize);
+}
+
+void* MemorySystem::ReallocFromAllocator(void* pMemory, size_t size)
+{
+	Allocator* pHeaderlessAllocator = FindHeaderlessAllocator(pMemory);
+	if(pHeaderlessAllocator && pHeaderlessAllocator->IsAllocationWithoutHeader(pMemory))
+	{
+		const size_t oldSize = pHeaderlessAllocator->GetAllocationSize(pMemory);
+		if(size <= oldSize)
+		{
+			return pMemory;
+		}
+
+		// A size which doesn't fit any of the size classes goes straight to the allocation with a header
+		void* pNewMemory = (size <= pHeaderlessAllocator->GetMaxSizeWithoutHeader())
+			? AllocFromAllocator(*pHeaderlessAllocator, size, kDefaultAlignment)
+			: AllocWithHeaderFromAllocator(*pHeaderlessAllocator, size, kDefaultAlignment);
+		if(pNewMemory)
+		{
+			memcpy(pNewMemory, pMemory, oldSize);
+			MemorySystem::Free(pMemory);
+		}
+
+		return pNewMemory;
+	}
+
 	const AllocationHeader oldHeader = *OffsetVoidPtrBackwards<AllocationHeader>(pMemory);
-	ASSERT(oldHeader.offsetBetweenPtrAndAllocatedMemory != 0xFDFDFDFD && "Windows Debug Heap's NoMansLand buffer detected. The memory was not allocated by the MemorySystem");
+	ASSERT(oldHeader.offsetBetweenPtrAndAllocatedMemory != 0xFDFDFD && "Windows Debug Heap's NoMansLand buffer detected. The memory was not allocated by the MemorySystem");
 	void* oldAllocatedMemory = OffsetVoidPtrBackwards(pMemory, oldHeader.offsetBetweenPtrAndAllocatedMemory);
 
 	ASSERT(oldHeader.offsetBetweenPtrAndAllocatedMemory == kDefaultAlignment && "Only default alignment is supported");
@@ -80,6 +407,18 @@ void* MemorySystem::Realloc(void* pMemory, size_t size)
 		return pMemory;
 	}
 
+	// Move to a headerless allocation when it got small enough
+	if(size <= oldHeader.pAllocator->GetMaxSizeWithoutHeader())
+	{
+		void* pNewMemory = AllocWithoutHeaderFromAllocator(*oldHeader.pAllocator, size, kDefaultAlignment);
+		if(pNewMemory)
+		{
+			memcpy(pNewMemory, pMemory, std::min<size_t>(size, oldHeader.allocatedSize - kDefaultAlignment));
+			MemorySystem::Free(pMemory);
+			return pNewMemory;
+		}
+	}
+
 	void* pAllocatedMemory = oldHeader.pAllocator->Realloc(oldAllocatedMemory, totalSize, oldHeader.allocatedSize);
 	if(pAllocatedMemory)
 	{
@@ -89,6 +428,10 @@ void* MemorySystem::Realloc(void* pMemory, size_t size)
 		AllocationHeader* pHeader = OffsetVoidPtrBackwards<AllocationHeader>(pNewPtr);
 		pHeader->allocatedSize = Math::SafeSizeToUint32(totalSize);
 
+		// The allocation stays with its original tag
+		TrackMemoryTag(static_cast<EMemoryTag>(oldHeader.tag), -static_cast<int64_t>(oldHeader.allocatedSize));
+		TrackMemoryTag(static_cast<EMemoryTag>(oldHeader.tag), totalSize);
+
 		return pNewPtr;
 	}
 
@@ -96,18 +439,64 @@ void* MemorySystem::Realloc(void* pMemory, size_t size)
 	return nullptr;
 }
 
-void MemorySystem::Free(void* pMemory)
+void MemorySystem::RegisterHeaderlessPages(void* pMemory, size_t size, Allocator& allocator)
 {
-	if(pMemory == nullptr)
+	const size_t address = reinterpret_cast<size_t>(pMemory);
+	ASSERT(address % kHeaderlessPageSize == 0 && size % kHeaderlessPageSize == 0);
+	ASSERT((address + size - 1) >> kPageMapPageShift >> kPageMapLeafShift < kPageMapNumLeaves);
+
+	for(size_t pageIdx = address >> kPageMapPageShift; pageIdx < (address + size) >> kPageMapPageShift; ++pageIdx)
 	{
-		return;
+		std::atomic<PageMapLeaf*>& leaf = s_pageMap[pageIdx >> kPageMapLeafShift];
+		PageMapLeaf* pLeaf = leaf.load(std::memory_order_acquire);
+		if(pLeaf == nullptr)
+		{
+			// The leaves are never freed
+			PageMapLeaf* pNewLeaf = new(SystemAlloc(sizeof(PageMapLeaf))) PageMapLeaf();
+			if(leaf.compare_exchange_strong(pLeaf, pNewLeaf, std::memory_order_acq_rel))
+			{
+				pLeaf = pNewLeaf;
+			}
+			else
+			{
+				pNewLeaf->~PageMapLeaf();
+				SystemFree(pNewLeaf);
+			}
+		}
+
+		pLeaf->allocators[pageIdx & ((size_t(1) << kPageMapLeafShift) - 1)].store(&allocator, std::memory_order_release);
 	}
+}
 
-	const AllocationHeader* pHeader = OffsetVoidPtrBackwards<AllocationHeader>(pMemory);
-	ASSERT(pHeader->offsetBetweenPtrAndAllocatedMemory != 0xFDFDFDFD && "Windows Debug Heap's NoMansLand buffer detected. The memory was not allocated by the MemorySystem");
-	void* pAllocatedMemory = OffsetVoidPtrBackwards(pMemory, pHeader->offsetBetweenPtrAndAllocatedMemory);
+void MemorySystem::UnregisterHeaderlessPages(void* pMemory, size_t size)
+{
+	const size_t address = reinterpret_cast<size_t>(pMemory);
+	ASSERT(address % kHeaderlessPageSize == 0 && size % kHeaderlessPageSize == 0);
 
-	pHeader->pAllocator->Free(pAllocatedMemory, pHeader->allocatedSize);
+	for(size_t pageIdx = address >> kPageMapPageShift; pageIdx < (address + size) >> kPageMapPageShift; ++pageIdx)
+	{
+		PageMapLeaf* pLeaf = s_pageMap[pageIdx >> kPageMapLeafShift].load(std::memory_order_acquire);
+		ASSERT(pLeaf != nullptr);
+		pLeaf->allocators[pageIdx & ((size_t(1) << kPageMapLeafShift) - 1)].store(nullptr, std::memory_order_release);
+	}
+}
+
+Allocator* MemorySystem::FindHeaderlessAllocator(const void* pMemory)
+{
+	const size_t pageIdx = reinterpret_cast<size_t>(pMemory) >> kPageMapPageShift;
+	const size_t leafIdx = pageIdx >> kPageMapLeafShift;
+	if(leafIdx >= kPageMapNumLeaves)
+	{
+		return nullptr;
+	}
+
+	PageMapLeaf* pLeaf = s_pageMap[leafIdx].load(std::memory_order_acquire);
+	if(pLeaf == nullptr)
+	{
+		return nullptr;
+	}
+
+	return pLeaf->allocators[pageIdx & ((size_t(1) << kPageMapLeafShift) - 1)].load(std::memory_order_acquire);
 }
 
 Allocator& MemorySystem::GetActiveAllocator()
@@ -133,15 +522,165 @@ void MemorySystem::PopAllocator()
 	}
 }
 
+EMemoryTag MemorySystem::GetActiveMemoryTag()
+{
+	return (s_memoryTagStackIndex > 0) ? s_memoryTagStack[s_memoryTagStackIndex - 1] : EMemoryTag::Untagged;
+}
+
+void MemorySystem::PushMemoryTag(EMemoryTag tag)
+{
+	ASSERT(s_memoryTagStackIndex < kMemoryTagStackSize);
+	s_memoryTagStack[s_memoryTagStackIndex++] = tag;
+}
+
+void MemorySystem::PopMemoryTag()
+{
+	if(s_memoryTagStackIndex > 0)
+	{
+		s_memoryTagStackIndex--;
+	}
+	else
+	{
+		ASSERT(false);
+	}
+}
+
+void MemorySystem::SwapScopeStacks(ScopeStacks& scopeStacks)
+{
+	ScopeStacks threadScopeStacks;
+	threadScopeStacks.numAllocators = s_allocatorStackIndex;
+	threadScopeStacks.numMemoryTags = s_memoryTagStackIndex;
+	std::copy_n(s_allocatorStack, s_allocatorStackIndex, threadScopeStacks.allocators);
+	std::copy_n(s_memoryTagStack, s_memoryTagStackIndex, threadScopeStacks.memoryTags);
+
+	s_allocatorStackIndex = scopeStacks.numAllocators;
+	s_memoryTagStackIndex = scopeStacks.numMemoryTags;
+	std::copy_n(scopeStacks.allocators, scopeStacks.numAllocators, s_allocatorStack);
+	std::copy_n(scopeStacks.memoryTags, scopeStacks.numMemoryTags, s_memoryTagStack);
+
+	scopeStacks = threadScopeStacks;
+}
+
+const char* MemorySystem::GetMemoryTagName(EMemoryTag tag)
+{
+	return kMemoryTagNames[static_cast<size_t>(tag)];
+}
+
+void MemorySystem::SampleMemoryTagStats()
+{
+	{
+		DESIRE_SCOPED_SPINLOCK(s_memoryTagSpinLock);
+		for(size_t i = 0; i < kNumMemoryTags; ++i)
+		{
+			int64_t liveBytes = s_retiredMemoryTagCounters[i].liveBytes.load(std::memory_order_relaxed);
+			int64_t numLiveAllocations = s_retiredMemoryTagCounters[i].numLiveAllocations.load(std::memory_order_relaxed);
+			uint64_t numAllocations = s_retiredMemoryTagCounters[i].numAllocations.load(std::memory_order_relaxed);
+			uint64_t allocatedBytes = s_retiredMemoryTagCounters[i].allocatedBytes.load(std::memory_order_relaxed);
+			for(const ThreadMemoryTagCounters* pThreadCounters = s_pFirstThreadMemoryTagCounters; pThreadCounters != nullptr; pThreadCounters = pThreadCounters->pNext)
+			{
+				liveBytes += pThreadCounters->counters[i].liveBytes.load(std::memory_order_relaxed);
+				numLiveAllocations += pThreadCounters->counters[i].numLiveAllocations.load(std::memory_order_relaxed);
+				numAllocations += pThreadCounters->counters[i].numAllocations.load(std::memory_order_relaxed);
+				allocatedBytes += pThreadCounters->counters[i].allocatedBytes.load(std::memory_order_relaxed);
+			}
+
+			MemoryTagStats& stats = s_memoryTagStats[i];
+			stats.liveBytes = liveBytes;
+			stats.peakBytes = std::max(stats.peakBytes, liveBytes);
+			stats.numLiveAllocations = numLiveAllocations;
+			stats.numAllocationsInLastFrame = numAllocations - s_prevNumAllocations[i];
+			stats.allocatedBytesInLastFrame = allocatedBytes - s_prevAllocatedBytes[i];
+			s_prevNumAllocations[i] = numAllocations;
+			s_prevAllocatedBytes[i] = allocatedBytes;
+		}
+	}
+
+	if(s_memoryTagStatsCallback)
+	{
+		s_memoryTagStatsCallback(s_memoryTagStats);
+	}
+}
+
+const MemorySystem::MemoryTagStats& MemorySystem::GetMemoryTagStats(EMemoryTag tag)
+{
+	return s_memoryTagStats[static_cast<size_t>(tag)];
+}
+
+void MemorySystem::SetMemoryTagStatsCallback(const MemoryTagStatsCallback_t& callback)
+{
+	s_memoryTagStatsCallback = callback;
+}
+
 Allocator& MemorySystem::GetScratchAllocator()
 {
-	constexpr size_t kScratchAllocatorSize = 10 * 1024 * 1024;
-	static std::unique_ptr<uint8_t[]> data = std::make_unique<uint8_t[]>(kScratchAllocatorSize);
-	static LinearAllocator s_scratchAllocator(data.get(), kScratchAllocatorSize);
-	return s_scratchAllocator;
+	if(s_spScratchAllocator == nullptr)
+	{
+		// The bookkeeping must not be allocated from the allocator which happens to be active
+		DESIRE_ALLOCATOR_SCOPE(Allocator::GetDefaultAllocator());
+		s_spScratchAllocator = std::make_unique<ThreadScratchAllocator>();
+	}
+
+	const uint32_t generation = s_scratchAllocatorGeneration.load(std::memory_order_acquire);
+	if(s_spScratchAllocator->generation != generation)
+	{
+		ResetKeepingCommittedMemory(s_spScratchAllocator->allocator);
+		s_spScratchAllocator->generation = generation;
+	}
+
+	return s_spScratchAllocator->allocator;
 }
 
 void MemorySystem::ResetScratchAllocator()
 {
-	static_cast<LinearAllocator&>(GetScratchAllocator()).Reset();
+	s_scratchAllocatorGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void MemorySystem::SetScratchAllocatorReservedSize(size_t reservedSize)
+{
+	ASSERT(reservedSize != 0);
+	s_scratchAllocatorReservedSize = reservedSize;
+}
+
+MemorySystem::ScratchAllocatorStats MemorySystem::GetScratchAllocatorStats()
+{
+	return ScratchAllocatorRegistry::GetForScratchAllocators().GetStats();
+}
+
+Allocator& MemorySystem::GetFrameAllocator()
+{
+	if(s_spFrameAllocators == nullptr)
+	{
+		// The bookkeeping must not be allocated from the allocator which happens to be active
+		DESIRE_ALLOCATOR_SCOPE(Allocator::GetDefaultAllocator());
+		s_spFrameAllocators = std::make_unique<ThreadFrameAllocators>();
+	}
+
+	// Reset the buffers of the frames which have been started since the last call, they have been retired
+	const uint64_t frameIdx = s_frameAllocatorFrameIdx.load(std::memory_order_acquire);
+	const uint64_t numNewFrames = std::min<uint64_t>(frameIdx - s_spFrameAllocators->frameIdx, kNumFrameAllocatorBuffers);
+	for(uint64_t i = 0; i < numNewFrames; ++i)
+	{
+		ResetKeepingCommittedMemory(*s_spFrameAllocators->spAllocators[(frameIdx - i) % kNumFrameAllocatorBuffers]);
+	}
+	s_spFrameAllocators->frameIdx = frameIdx;
+
+	return *s_spFrameAllocators->spAllocators[frameIdx % kNumFrameAllocatorBuffers];
+}
+
+void MemorySystem::AdvanceFrameAllocator()
+{
+	s_frameAllocatorFrameIdx.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t MemorySystem::GetFrameAllocatorFrameIdx()
+{
+	return s_frameAllocatorFrameIdx.load(std::memory_order_acquire);
+}
+
+MemorySystem::ScratchAllocatorStats MemorySystem::GetFrameAllocatorStats()
+{
+	// Each thread has multiple allocators in the registry
+	ScratchAllocatorStats stats = ScratchAllocatorRegistry::GetForFrameAllocators().GetStats();
+	stats.numThreads /= kNumFrameAllocatorBuffers;
+	return stats;
 }
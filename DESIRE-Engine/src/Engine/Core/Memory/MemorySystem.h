@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Core/Memory/MemoryTag.h"
+
 class Allocator;
 
 class MemorySystem
@@ -18,14 +20,90 @@ public:
 	static void SystemFree(void* pMemory);
 	static void SystemAlignedFree(void* pMemory);
 
+	// Virtual memory (the address and the size have to be aligned to GetVirtualMemoryGranularity())
+	// With huge pages the reserved range is aligned to kHugePageSize and the system is asked to back it with transparent huge pages (Linux only)
+	static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+	static size_t GetVirtualMemoryGranularity();
+	static void* VirtualReserve(size_t size, bool useHugePages = false);
+	static bool VirtualCommit(void* pMemory, size_t size);
+	static void VirtualDecommit(void* pMemory, size_t size);
+	static void VirtualRelease(void* pMemory, size_t size);
+
+	// Allocators can register 64 KB aligned pages which they serve without allocation headers, so their owner is found by address
+	static constexpr size_t kHeaderlessPageSize = 64 * 1024;
+	static void RegisterHeaderlessPages(void* pMemory, size_t size, Allocator& allocator);
+	static void UnregisterHeaderlessPages(void* pMemory, size_t size);
+	static Allocator* FindHeaderlessAllocator(const void* pMemory);
+
 	static Allocator& GetActiveAllocator();
 	static void PushAllocator(Allocator& allocator);
 	static void PopAllocator();
 
-	// Returns a linear allocator which gets reset at the end of each frame
+	struct ScratchAllocatorStats
+	{
+		size_t highWaterMark;		// The maximum number of bytes used between two resets by any of the threads
+		size_t committedBytes;		// The physical memory committed by all the threads
+		size_t reservedBytes;		// The address space reserved by all the threads
+		uint32_t numThreads;
+	};
+
+	// Returns the linear allocator of the calling thread which gets reset at the end of each frame
 	static Allocator& GetScratchAllocator();
-	// Reset all allocations in the scratch allocator (this should happen at the end of the frame)
+	// Reset all allocations in the scratch allocators of all threads (this should happen at the end of the frame)
+	// The allocators are reset by their own threads when they call GetScratchAllocator() the next time
 	static void ResetScratchAllocator();
+	// Set the address range reserved by each new scratch and frame allocator (the memory is committed as the allocations advance)
+	static void SetScratchAllocatorReservedSize(size_t reservedSize);
+	static ScratchAllocatorStats GetScratchAllocatorStats();
+
+	// The frame allocators are linear allocators like the scratch allocators, but each thread has one for each of the
+	// last kNumFrameAllocatorBuffers frames, so the data built in a frame can be consumed by the later pipeline stages
+	static constexpr uint32_t kNumFrameAllocatorBuffers = 3;
+	// Returns the linear allocator of the calling thread for the current frame
+	static Allocator& GetFrameAllocator();
+	// Start a new frame which reuses the frame allocators of the frame started kNumFrameAllocatorBuffers frames ago
+	// The caller has to ensure that all pipeline stages are done with the allocations of that frame
+	// The allocators are reset by their own threads when they call GetFrameAllocator() the next time
+	static void AdvanceFrameAllocator();
+	static uint64_t GetFrameAllocatorFrameIdx();
+	static ScratchAllocatorStats GetFrameAllocatorStats();
+
+	// The allocations are counted for the active memory tag of the calling thread
+	static EMemoryTag GetActiveMemoryTag();
+	static void PushMemoryTag(EMemoryTag tag);
+	static void PopMemoryTag();
+	static const char* GetMemoryTagName(EMemoryTag tag);
+
+	struct MemoryTagStats
+	{
+		int64_t liveBytes;
+		int64_t peakBytes;						// The maximum of the sampled live bytes
+		int64_t numLiveAllocations;
+		uint64_t numAllocationsInLastFrame;		// The number of allocations since the previous sample
+		uint64_t allocatedBytesInLastFrame;		// The number of bytes allocated since the previous sample
+	};
+
+	// Called after each sample with the stats of all the tags (indexed by EMemoryTag)
+	typedef std::function<void(const MemoryTagStats* pStats)> MemoryTagStatsCallback_t;
+
+	// Collects the statistics of the tags from all threads (this should happen once per frame)
+	static void SampleMemoryTagStats();
+	// Returns the statistics of the last sample
+	static const MemoryTagStats& GetMemoryTagStats(EMemoryTag tag);
+	static void SetMemoryTagStatsCallback(const MemoryTagStatsCallback_t& callback);
+
+	// The allocator and memory tag scopes of a thread, they are swapped in and out by the fibers of the JobSystem
+	struct ScopeStacks
+	{
+		static constexpr size_t kMaxDepth = 16;
+		Allocator* allocators[kMaxDepth];
+		EMemoryTag memoryTags[kMaxDepth];
+		size_t numAllocators = 0;
+		size_t numMemoryTags = 0;
+	};
+
+	// Exchanges the scopes of the calling thread with the given ones
+	static void SwapScopeStacks(ScopeStacks& scopeStacks);
 
 	struct AllocatorScope
 	{
@@ -34,13 +112,26 @@ public:
 		~AllocatorScope()						{ MemorySystem::PopAllocator(); }
 	};
 
+	struct MemoryTagScope
+	{
+		MemoryTagScope(EMemoryTag tag)			{ MemorySystem::PushMemoryTag(tag); }
+		~MemoryTagScope()						{ MemorySystem::PopMemoryTag(); }
+	};
+
 private:
+	static void* AllocFromAllocator(Allocator& allocator, size_t size, size_t alignment);
+	static void* AllocWithHeaderFromAllocator(Allocator& allocator, size_t size, size_t alignment);
+	static void* AllocWithoutHeaderFromAllocator(Allocator& allocator, size_t size, size_t alignment);
+	static void* ReallocFromAllocator(void* pMemory, size_t size);
+
 	struct AllocationHeader
 	{
 		Allocator* pAllocator;
 		uint32_t allocatedSize;
-		uint32_t offsetBetweenPtrAndAllocatedMemory;
+		uint32_t offsetBetweenPtrAndAllocatedMemory : 24;
+		uint32_t tag : 8;
 	};
 };
 
 #define DESIRE_ALLOCATOR_SCOPE(ALLOCATOR)	MemorySystem::AllocatorScope DESIRE_CONCAT_MACRO(allocatorScope, __COUNTER__)(ALLOCATOR)
+#define DESIRE_MEMORY_TAG_SCOPE(TAG)		MemorySystem::MemoryTagScope DESIRE_CONCAT_MACRO(memoryTagScope, __COUNTER__)(TAG)
@@ -0,0 +1,95 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+#if DESIRE_PLATFORM_LINUX
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+void* MemorySystem::SystemAlloc(size_t size)
+{
+	return malloc(size);
+}
+
+void* MemorySystem::SystemRealloc(void* pMemory, size_t size)
+{
+	return realloc(pMemory, size);
+}
+
+void* MemorySystem::SystemAlignedAlloc(size_t size, size_t alignment)
+{
+	void* pMemory = nullptr;
+	if(posix_memalign(&pMemory, std::max(alignment, sizeof(void*)), size) != 0)
+	{
+		return nullptr;
+	}
+
+	return pMemory;
+}
+
+void MemorySystem::SystemFree(void* pMemory)
+{
+	free(pMemory);
+}
+
+void MemorySystem::SystemAlignedFree(void* pMemory)
+{
+	free(pMemory);
+}
+
+size_t MemorySystem::GetVirtualMemoryGranularity()
+{
+	static const size_t s_granularity = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	return s_granularity;
+}
+
+void* MemorySystem::VirtualReserve(size_t size, bool useHugePages)
+{
+	if(!useHugePages)
+	{
+		void* pMemory = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		return (pMemory != MAP_FAILED) ? pMemory : nullptr;
+	}
+
+	// Reserve more to be able to align the range, then unmap the unused parts
+	const size_t reservedSize = size + kHugePageSize;
+	void* pMemory = mmap(nullptr, reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if(pMemory == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	uint8_t* pReservedStart = static_cast<uint8_t*>(pMemory);
+	uint8_t* pReservedEnd = pReservedStart + reservedSize;
+	uint8_t* pAlignedStart = reinterpret_cast<uint8_t*>((reinterpret_cast<size_t>(pReservedStart) + kHugePageSize - 1) & ~(kHugePageSize - 1));
+	if(pAlignedStart != pReservedStart)
+	{
+		munmap(pReservedStart, pAlignedStart - pReservedStart);
+	}
+	if(pAlignedStart + size != pReservedEnd)
+	{
+		munmap(pAlignedStart + size, pReservedEnd - (pAlignedStart + size));
+	}
+
+	madvise(pAlignedStart, size, MADV_HUGEPAGE);
+	return pAlignedStart;
+}
+
+bool MemorySystem::VirtualCommit(void* pMemory, size_t size)
+{
+	return mprotect(pMemory, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void MemorySystem::VirtualDecommit(void* pMemory, size_t size)
+{
+	// Give the physical pages back to the system while keeping the address range reserved
+	madvise(pMemory, size, MADV_DONTNEED);
+	mprotect(pMemory, size, PROT_NONE);
+}
+
+void MemorySystem::VirtualRelease(void* pMemory, size_t size)
+{
+	munmap(pMemory, size);
+}
+
+#endif	// #if DESIRE_PLATFORM_LINUX
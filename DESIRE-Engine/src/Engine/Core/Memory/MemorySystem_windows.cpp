@@ -3,6 +3,8 @@
 
 #if DESIRE_PLATFORM_WINDOWS
 
+#include "Engine/Core/WINDOWS/os.h"
+
 void* MemorySystem::SystemAlloc(size_t size)
 {
 	return malloc(size);
@@ -28,4 +30,36 @@ void MemorySystem::SystemAlignedFree(void* pMemory)
 	_aligned_free(pMemory);
 }
 
+size_t MemorySystem::GetVirtualMemoryGranularity()
+{
+	static const size_t s_granularity = []()
+	{
+		SYSTEM_INFO systemInfo = {};
+		GetSystemInfo(&systemInfo);
+		return static_cast<size_t>(systemInfo.dwAllocationGranularity);
+	}();
+	return s_granularity;
+}
+
+void* MemorySystem::VirtualReserve(size_t size, bool /*useHugePages*/)
+{
+	// Large pages are not used as they need a special privilege and have to be committed at reservation
+	return ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool MemorySystem::VirtualCommit(void* pMemory, size_t size)
+{
+	return ::VirtualAlloc(pMemory, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void MemorySystem::VirtualDecommit(void* pMemory, size_t size)
+{
+	::VirtualFree(pMemory, size, MEM_DECOMMIT);
+}
+
+void MemorySystem::VirtualRelease(void* pMemory, size_t /*size*/)
+{
+	::VirtualFree(pMemory, 0, MEM_RELEASE);
+}
+
 #endif	// #if DESIRE_PLATFORM_WINDOWS
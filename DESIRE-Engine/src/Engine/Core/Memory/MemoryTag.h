@@ -0,0 +1,17 @@
+#pragma once
+
+// Subsystems which own the allocations for the memory statistics
+enum class EMemoryTag : uint8_t
+{
+	Untagged,
+	Render,
+	Physics,
+	Script,
+	Resource,
+	UI,
+	Sound,
+	Network,
+	Application,
+
+	Num
+};
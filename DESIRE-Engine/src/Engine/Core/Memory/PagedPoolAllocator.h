@@ -0,0 +1,262 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	PagedPoolAllocator stores elements of the same type in fixed size pages which are allocated from virtual memory.
+//	The pool grows page by page without moving the elements, and a page is given back to the system when it becomes
+//	empty, except one empty page which is kept so an element count toggling across a page boundary doesn't create and
+//	release a page every time. New elements always go to the first page with a free slot to keep the elements densely packed.
+//	Elements can be referenced with a Handle which contains a generation counter, so a handle to a destroyed element
+//	is detected even when its slot has been reused.
+// --------------------------------------------------------------------------------------------------------------------
+
+template<typename T, size_t PAGE_SIZE = 64 * 1024>
+class PagedPoolAllocator
+{
+	struct Page;
+
+public:
+	struct Handle
+	{
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator ==(const Handle& other) const	{ return index == other.index && generation == other.generation; }
+		bool operator !=(const Handle& other) const	{ return !(*this == other); }
+	};
+
+	PagedPoolAllocator()
+	{
+		ASSERT(PAGE_SIZE % MemorySystem::GetVirtualMemoryGranularity() == 0);
+	}
+
+	~PagedPoolAllocator()
+	{
+		ForEach([](T& element)
+		{
+			element.~T();
+		});
+
+		for(Page* pPage : m_pages)
+		{
+			if(pPage != nullptr)
+			{
+				ReleasePage(pPage);
+			}
+		}
+	}
+
+	// Constructs a new element in the pool
+	template<class... Args>
+	Handle Create(Args&&... args)
+	{
+		uint32_t pageIdx = m_firstNonFullPageIdx;
+		while(pageIdx < m_pages.Size() && m_pages[pageIdx] != nullptr && m_pages[pageIdx]->numElements == kNumElementsPerPage)
+		{
+			pageIdx++;
+		}
+		m_firstNonFullPageIdx = pageIdx;
+
+		if(pageIdx == m_pages.Size())
+		{
+			m_pages.Add(nullptr);
+			m_pageBaseGenerations.Add(0);
+		}
+
+		if(m_pages[pageIdx] == nullptr)
+		{
+			m_pages[pageIdx] = CreatePage(m_pageBaseGenerations[pageIdx]);
+		}
+
+		if(pageIdx == m_emptyPageIdx)
+		{
+			m_emptyPageIdx = kInvalidPageIdx;
+		}
+
+		Page* pPage = m_pages[pageIdx];
+		uint32_t slotIdx = pPage->firstFreeSlotIdx;
+		if(slotIdx != kInvalidSlotIdx)
+		{
+			pPage->firstFreeSlotIdx = *reinterpret_cast<uint32_t*>(pPage->GetSlot(slotIdx));
+		}
+		else
+		{
+			slotIdx = pPage->numUsedSlots++;
+		}
+
+		new(pPage->GetSlot(slotIdx)) T(std::forward<Args>(args)...);
+		pPage->numElements++;
+		m_numElements++;
+
+		// Odd generations mark the used slots
+		uint32_t& generation = pPage->generations[slotIdx];
+		generation++;
+		ASSERT(generation & 1);
+
+		return Handle{ pageIdx * kNumElementsPerPage + slotIdx, generation };
+	}
+
+	// Destroys the element and invalidates all handles to it
+	void Destroy(Handle handle)
+	{
+		if(Get(handle) == nullptr)
+		{
+			ASSERT(false && "Invalid handle");
+			return;
+		}
+
+		const uint32_t pageIdx = handle.index / kNumElementsPerPage;
+		const uint32_t slotIdx = handle.index % kNumElementsPerPage;
+		Page* pPage = m_pages[pageIdx];
+
+		void* pSlot = pPage->GetSlot(slotIdx);
+		static_cast<T*>(pSlot)->~T();
+		pPage->generations[slotIdx]++;
+		*static_cast<uint32_t*>(pSlot) = pPage->firstFreeSlotIdx;
+		pPage->firstFreeSlotIdx = slotIdx;
+		pPage->numElements--;
+		m_numElements--;
+
+		if(pPage->numElements == 0 && m_emptyPageIdx == kInvalidPageIdx)
+		{
+			// Keep the page and fill it from the beginning again (the generations stay, so the old handles remain invalid)
+			pPage->numUsedSlots = 0;
+			pPage->firstFreeSlotIdx = kInvalidSlotIdx;
+			m_emptyPageIdx = pageIdx;
+		}
+		else if(pPage->numElements == 0)
+		{
+			// All the generations in the page are even now, the new page starts above them
+			uint32_t maxGeneration = m_pageBaseGenerations[pageIdx];
+			for(uint32_t i = 0; i < pPage->numUsedSlots; ++i)
+			{
+				maxGeneration = std::max(maxGeneration, pPage->generations[i]);
+			}
+			m_pageBaseGenerations[pageIdx] = maxGeneration;
+
+			ReleasePage(pPage);
+			m_pages[pageIdx] = nullptr;
+		}
+
+		m_firstNonFullPageIdx = std::min(m_firstNonFullPageIdx, pageIdx);
+	}
+
+	// Returns nullptr if the element has been destroyed
+	T* Get(Handle handle) const
+	{
+		const uint32_t pageIdx = handle.index / kNumElementsPerPage;
+		if(pageIdx >= m_pages.Size() || m_pages[pageIdx] == nullptr)
+		{
+			return nullptr;
+		}
+
+		Page* pPage = m_pages[pageIdx];
+		const uint32_t slotIdx = handle.index % kNumElementsPerPage;
+		return (pPage->generations[slotIdx] == handle.generation) ? static_cast<T*>(pPage->GetSlot(slotIdx)) : nullptr;
+	}
+
+	bool IsValid(Handle handle) const
+	{
+		return Get(handle) != nullptr;
+	}
+
+	// Calls 'func' for every element page by page
+	template<typename Func>
+	void ForEach(const Func& func)
+	{
+		for(Page* pPage : m_pages)
+		{
+			if(pPage == nullptr)
+			{
+				continue;
+			}
+
+			for(uint32_t slotIdx = 0; slotIdx < pPage->numUsedSlots; ++slotIdx)
+			{
+				if(pPage->generations[slotIdx] & 1)
+				{
+					func(*static_cast<T*>(pPage->GetSlot(slotIdx)));
+				}
+			}
+		}
+	}
+
+	size_t Size() const
+	{
+		return m_numElements;
+	}
+
+	size_t GetNumPages() const
+	{
+		size_t numPages = 0;
+		for(const Page* pPage : m_pages)
+		{
+			numPages += (pPage != nullptr) ? 1 : 0;
+		}
+		return numPages;
+	}
+
+	static constexpr uint32_t GetNumElementsPerPage()
+	{
+		return kNumElementsPerPage;
+	}
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(PagedPoolAllocator)
+
+	static constexpr uint32_t kInvalidSlotIdx = UINT32_MAX;
+	static constexpr uint32_t kInvalidPageIdx = UINT32_MAX;
+	static constexpr size_t kSlotSize = (sizeof(T) < sizeof(uint32_t)) ? sizeof(uint32_t) : sizeof(T);
+	static constexpr size_t kSlotAlignment = std::max(alignof(T), alignof(uint32_t));
+	static constexpr size_t kPageHeaderSize = 3 * sizeof(uint32_t);
+	static constexpr uint32_t kNumElementsPerPage = static_cast<uint32_t>((PAGE_SIZE - kPageHeaderSize - kSlotAlignment) / (kSlotSize + sizeof(uint32_t)));
+	static_assert(kNumElementsPerPage > 0, "The element doesn't fit into a page");
+
+	struct Page
+	{
+		uint32_t numElements;
+		uint32_t numUsedSlots;			// The slots above this have never been used
+		uint32_t firstFreeSlotIdx;
+		uint32_t generations[kNumElementsPerPage];
+		alignas(kSlotAlignment) uint8_t slots[kNumElementsPerPage * kSlotSize];
+
+		void* GetSlot(uint32_t slotIdx)
+		{
+			return &slots[slotIdx * kSlotSize];
+		}
+	};
+
+	static_assert(sizeof(Page) <= PAGE_SIZE);
+
+	static Page* CreatePage(uint32_t baseGeneration)
+	{
+		void* pMemory = MemorySystem::VirtualReserve(PAGE_SIZE);
+		ASSERT(pMemory != nullptr && "Out of memory");
+		const bool isCommitted = MemorySystem::VirtualCommit(pMemory, PAGE_SIZE);
+		ASSERT(isCommitted && "Out of memory");
+		DESIRE_UNUSED(isCommitted);
+
+		// Only the header needs initialization as the committed memory is zeroed
+		Page* pPage = static_cast<Page*>(pMemory);
+		pPage->firstFreeSlotIdx = kInvalidSlotIdx;
+		if(baseGeneration != 0)
+		{
+			std::fill(std::begin(pPage->generations), std::end(pPage->generations), baseGeneration);
+		}
+
+		return pPage;
+	}
+
+	static void ReleasePage(Page* pPage)
+	{
+		MemorySystem::VirtualRelease(pPage, PAGE_SIZE);
+	}
+
+	Array<Page*> m_pages;
+	Array<uint32_t> m_pageBaseGenerations;
+	uint32_t m_firstNonFullPageIdx = 0;
+	uint32_t m_emptyPageIdx = kInvalidPageIdx;
+	size_t m_numElements = 0;
+};
@@ -1,6 +1,15 @@
 #pragma once
 
+#include "Engine/Core/Container/Array.h"
 #include "Engine/Core/Container/FreeList.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	PoolAllocator serves elements of the same type from an embedded block of NUM_ELEMENTS elements.
+//	When the block is exhausted the pool grows by blocks of the same size, so the elements stay packed in blocks instead
+//	of being scattered over the heap. The additional blocks are kept until the pool is destroyed.
+//	Use PagedPoolAllocator when the unused memory has to be released or the elements are referenced by handles.
+// --------------------------------------------------------------------------------------------------------------------
 
 template<typename T, size_t NUM_ELEMENTS>
 class PoolAllocator
@@ -8,36 +17,62 @@ class PoolAllocator
 public:
 	PoolAllocator()
 	{
-		char* pMemory = static_cast<char*>(data);
-		for(size_t i = 0; i < NUM_ELEMENTS; ++i)
+		AddBlock(m_data);
+	}
+
+	~PoolAllocator()
+	{
+		for(void* pBlock : m_additionalBlocks)
 		{
-			list.Push(pMemory);
-			pMemory += kElementSize;
+			MemorySystem::Free(pBlock);
 		}
 	}
 
 	T* Alloc()
 	{
-		void* pMemory = list.Pop();
-		return pMemory ? new (pMemory) T() : new T();
+		void* pMemory = m_freeList.Pop();
+		if(pMemory == nullptr)
+		{
+			void* pBlock = MemorySystem::Alloc(kBlockSize, kElementAlignment);
+			ASSERT(pBlock != nullptr && "Out of memory");
+			m_additionalBlocks.Add(pBlock);
+			AddBlock(pBlock);
+			pMemory = m_freeList.Pop();
+		}
+
+		return new(pMemory) T();
 	}
 
 	void Free(T* pMemory)
 	{
-		if(data <= reinterpret_cast<char*>(pMemory) && reinterpret_cast<char*>(pMemory) <= data + (NUM_ELEMENTS - 1) * kElementSize)
-		{
-			pMemory->~T();
-			list.Push(pMemory);
-		}
-		else
-		{
-			delete pMemory;
-		}
+		pMemory->~T();
+		m_freeList.Push(pMemory);
+	}
+
+	size_t GetNumBlocks() const
+	{
+		return 1 + m_additionalBlocks.Size();
 	}
 
 private:
+	DESIRE_NO_COPY_AND_MOVE(PoolAllocator)
+
 	static constexpr size_t kElementSize = (sizeof(T) < sizeof(void*)) ? sizeof(void*) : sizeof(T);
+	static constexpr size_t kElementAlignment = std::max(alignof(T), alignof(void*));
+	static constexpr size_t kBlockSize = NUM_ELEMENTS * kElementSize;
+
+	void AddBlock(void* pBlock)
+	{
+		// The elements are pushed backwards, so they are given out in increasing address order
+		char* pMemory = static_cast<char*>(pBlock) + kBlockSize;
+		for(size_t i = 0; i < NUM_ELEMENTS; ++i)
+		{
+			pMemory -= kElementSize;
+			m_freeList.Push(pMemory);
+		}
+	}
 
-	FreeList list;
-	char data[NUM_ELEMENTS * kElementSize] = {};
+	FreeList m_freeList;
+	Array<void*> m_additionalBlocks;
+	alignas(kElementAlignment) char m_data[kBlockSize] = {};
 };
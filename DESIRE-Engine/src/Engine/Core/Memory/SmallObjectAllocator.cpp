@@ -0,0 +1,413 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Memory/SmallObjectAllocator.h"
+
+#include "Engine/Core/Container/FreeList.h"
+#include "Engine/Core/Container/ThreadSafeFreeList.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+static constexpr uint32_t kSizeClasses[] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768, 896, 1024 };
+static constexpr uint32_t kNumSizeClasses = static_cast<uint32_t>(std::size(kSizeClasses));
+static constexpr uint32_t kSizeClassGranularity = 16;
+
+// The slabs are allocated from the system in bigger chunks
+static constexpr size_t kNumSlabsInChunk = 16;
+
+// The allocated bytes are collected per thread and only added to the shared counter when they reach this limit
+static constexpr int64_t kAllocatedBytesFlushLimit = 64 * 1024;
+
+static_assert(kSizeClasses[kNumSizeClasses - 1] == SmallObjectAllocator::kMaxSmallObjectSize);
+static_assert(SmallObjectAllocator::kSlabSize % MemorySystem::kHeaderlessPageSize == 0);
+
+// Lookup table from the size in kSizeClassGranularity units to the index of the smallest size class which fits it
+struct SizeClassLookup
+{
+	uint8_t sizeClassIndices[SmallObjectAllocator::kMaxSmallObjectSize / kSizeClassGranularity + 1];
+
+	constexpr SizeClassLookup()
+		: sizeClassIndices()
+	{
+		uint8_t sizeClassIdx = 0;
+		for(uint32_t i = 0; i < std::size(sizeClassIndices); ++i)
+		{
+			while(kSizeClasses[sizeClassIdx] < i * kSizeClassGranularity)
+			{
+				sizeClassIdx++;
+			}
+			sizeClassIndices[i] = sizeClassIdx;
+		}
+	}
+};
+
+static constexpr SizeClassLookup kSizeClassLookup;
+
+static uint32_t GetSizeClassIdx(size_t size)
+{
+	ASSERT(size <= SmallObjectAllocator::kMaxSmallObjectSize);
+	return kSizeClassLookup.sizeClassIndices[(size + kSizeClassGranularity - 1) / kSizeClassGranularity];
+}
+
+// The header of the slab is at its end, so the blocks are aligned to their size class as well
+// The memory tags of the blocks are stored in a byte array before the header
+struct alignas(DESIRE_CACHE_LINE_SIZE) SmallObjectAllocator::Slab
+{
+	ThreadHeap* pOwnerHeap;
+	uint32_t sizeClassIdx;
+	uint32_t numBlocks;
+	Slab* pNextChunk;		// Only used in the first slab of a chunk
+};
+
+struct SmallObjectAllocator::ThreadHeap
+{
+	struct SizeClass
+	{
+		FreeList freeList;
+		uint8_t* pNextBlockInSlab = nullptr;
+		uint8_t* pSlabEnd = nullptr;
+	};
+
+	// The memory tags share the slabs, each block has its tag stored in the slab
+	SizeClass sizeClasses[kNumSizeClasses];
+	int64_t pendingAllocatedBytes = 0;
+
+	// The unused slabs of the last chunk
+	uint8_t* pNextSlab = nullptr;
+	uint8_t* pChunkEnd = nullptr;
+	Slab* pFirstChunk = nullptr;
+
+	ThreadHeap* pNextHeap = nullptr;
+	ThreadHeap* pNextAbandonedHeap = nullptr;
+
+	// Memory freed by other threads (on a separate cache line as this is written by them)
+	alignas(DESIRE_CACHE_LINE_SIZE) ThreadSafeFreeList remoteFreeLists[kNumSizeClasses];
+};
+
+struct SmallObjectAllocator::ThreadHeapCache
+{
+	static constexpr uint32_t kMaxNumAllocators = 4;
+
+	SmallObjectAllocator* pAllocators[kMaxNumAllocators] = {};
+	ThreadHeap* pHeaps[kMaxNumAllocators] = {};
+	bool isThreadExiting = false;
+
+	~ThreadHeapCache()
+	{
+		// The heaps of the exiting thread are given to the next new threads
+		// Note: Destructors of other thread_local objects can still free memory after this, those are handled as remote frees
+		isThreadExiting = true;
+		for(uint32_t i = 0; i < kMaxNumAllocators; ++i)
+		{
+			if(pAllocators[i] != nullptr)
+			{
+				pAllocators[i]->AbandonThreadHeap(pHeaps[i]);
+				pAllocators[i] = nullptr;
+				pHeaps[i] = nullptr;
+			}
+		}
+	}
+};
+
+thread_local SmallObjectAllocator::ThreadHeapCache SmallObjectAllocator::s_threadHeapCache;
+
+SmallObjectAllocator::SmallObjectAllocator()
+{
+}
+
+SmallObjectAllocator::~SmallObjectAllocator()
+{
+	ThreadHeapCache& cache = s_threadHeapCache;
+	for(uint32_t i = 0; i < ThreadHeapCache::kMaxNumAllocators; ++i)
+	{
+		if(cache.pAllocators[i] == this)
+		{
+			cache.pAllocators[i] = nullptr;
+			cache.pHeaps[i] = nullptr;
+		}
+	}
+
+	ThreadHeap* pHeap = m_pFirstHeap;
+	while(pHeap != nullptr)
+	{
+		Slab* pChunk = pHeap->pFirstChunk;
+		while(pChunk != nullptr)
+		{
+			Slab* pNextChunk = pChunk->pNextChunk;
+			uint8_t* pChunkMemory = GetSlabMemory(pChunk);
+			MemorySystem::UnregisterHeaderlessPages(pChunkMemory, kNumSlabsInChunk * kSlabSize);
+			MemorySystem::SystemAlignedFree(pChunkMemory);
+			pChunk = pNextChunk;
+		}
+
+		ThreadHeap* pNextHeap = pHeap->pNextHeap;
+		pHeap->~ThreadHeap();
+		MemorySystem::SystemAlignedFree(pHeap);
+		pHeap = pNextHeap;
+	}
+}
+
+void* SmallObjectAllocator::Alloc(size_t size)
+{
+	if(size > kMaxSmallObjectSize)
+	{
+		m_allocatedBytes += size;
+		return m_largeObjectAllocator.Alloc(size);
+	}
+
+	return AllocFromSizeClass(GetSizeClassIdx(size));
+}
+
+void* SmallObjectAllocator::AllocWithoutHeader(size_t size, size_t alignment)
+{
+	if(size > kMaxSmallObjectSize || alignment > kMaxSmallObjectSize)
+	{
+		return nullptr;
+	}
+
+	// The blocks are aligned to the largest power of two which divides their size
+	uint32_t sizeClassIdx = GetSizeClassIdx(std::max(size, alignment));
+	while(kSizeClasses[sizeClassIdx] % alignment != 0)
+	{
+		sizeClassIdx++;
+	}
+
+	return AllocFromSizeClass(sizeClassIdx);
+}
+
+size_t SmallObjectAllocator::GetMaxSizeWithoutHeader() const
+{
+	return kMaxSmallObjectSize;
+}
+
+bool SmallObjectAllocator::IsAllocationWithoutHeader(const void* pMemory) const
+{
+	// Alloc() shares the blocks with AllocWithoutHeader(), but the MemorySystem puts a header at the beginning of those
+	const size_t offsetInSlab = reinterpret_cast<uintptr_t>(pMemory) & (kSlabSize - 1);
+	return (offsetInSlab % kSizeClasses[GetSlab(pMemory)->sizeClassIdx] == 0);
+}
+
+size_t SmallObjectAllocator::GetAllocationSize(const void* pMemory) const
+{
+	return kSizeClasses[GetSlab(pMemory)->sizeClassIdx];
+}
+
+EMemoryTag SmallObjectAllocator::GetAllocationTag(const void* pMemory) const
+{
+	Slab* pSlab = GetSlab(pMemory);
+	const size_t offsetInSlab = reinterpret_cast<uintptr_t>(pMemory) & (kSlabSize - 1);
+	return GetBlockTags(pSlab)[offsetInSlab / kSizeClasses[pSlab->sizeClassIdx]];
+}
+
+void* SmallObjectAllocator::AllocFromSizeClass(uint32_t sizeClassIdx)
+{
+	const EMemoryTag tag = MemorySystem::GetActiveMemoryTag();
+	ThreadHeap* pHeap = GetThreadHeap(true);
+	if(pHeap == nullptr)
+	{
+		// The thread is exiting, borrow a heap
+		pHeap = AdoptThreadHeap();
+		void* pMemory = AllocFromHeap(pHeap, sizeClassIdx, tag);
+		AbandonThreadHeap(pHeap);
+		return pMemory;
+	}
+
+	return AllocFromHeap(pHeap, sizeClassIdx, tag);
+}
+
+void* SmallObjectAllocator::Realloc(void* pMemory, size_t newSize, size_t oldSize)
+{
+	if(oldSize <= kMaxSmallObjectSize && newSize <= kMaxSmallObjectSize)
+	{
+		if(GetSizeClassIdx(oldSize) == GetSizeClassIdx(newSize))
+		{
+			// The block is big enough
+			return pMemory;
+		}
+	}
+	else if(oldSize > kMaxSmallObjectSize && newSize > kMaxSmallObjectSize)
+	{
+		m_allocatedBytes -= oldSize;
+		m_allocatedBytes += newSize;
+		return m_largeObjectAllocator.Realloc(pMemory, newSize, oldSize);
+	}
+
+	return Allocator::Realloc(pMemory, newSize, oldSize);
+}
+
+void SmallObjectAllocator::Free(void* pMemory, size_t size)
+{
+	if(size > kMaxSmallObjectSize)
+	{
+		m_allocatedBytes -= size;
+		m_largeObjectAllocator.Free(pMemory, size);
+		return;
+	}
+
+	Slab* pSlab = GetSlab(pMemory);
+	const uint32_t sizeClassIdx = pSlab->sizeClassIdx;
+	ASSERT(MemorySystem::FindHeaderlessAllocator(pMemory) == this && "The memory was not allocated by this allocator");
+	ASSERT(size <= kSizeClasses[sizeClassIdx] && "The size is wrong");
+
+	ThreadHeap* pHeap = GetThreadHeap(false);
+	if(pSlab->pOwnerHeap == pHeap)
+	{
+		pHeap->sizeClasses[sizeClassIdx].freeList.Push(pMemory);
+		AddAllocatedBytes(pHeap, -static_cast<int64_t>(kSizeClasses[sizeClassIdx]));
+	}
+	else
+	{
+		// The block is counted as allocated until the owner heap reuses it
+		pSlab->pOwnerHeap->remoteFreeLists[sizeClassIdx].Push(pMemory);
+	}
+}
+
+size_t SmallObjectAllocator::GetBlockSize(size_t size)
+{
+	return (size <= kMaxSmallObjectSize) ? kSizeClasses[GetSizeClassIdx(size)] : size;
+}
+
+SmallObjectAllocator::ThreadHeap* SmallObjectAllocator::GetThreadHeap(bool createIfNotExists)
+{
+	ThreadHeapCache& cache = s_threadHeapCache;
+	for(uint32_t i = 0; i < ThreadHeapCache::kMaxNumAllocators; ++i)
+	{
+		if(cache.pAllocators[i] == this)
+		{
+			return cache.pHeaps[i];
+		}
+	}
+
+	if(!createIfNotExists || cache.isThreadExiting)
+	{
+		return nullptr;
+	}
+
+	for(uint32_t i = 0; i < ThreadHeapCache::kMaxNumAllocators; ++i)
+	{
+		if(cache.pAllocators[i] == nullptr)
+		{
+			cache.pAllocators[i] = this;
+			cache.pHeaps[i] = AdoptThreadHeap();
+			return cache.pHeaps[i];
+		}
+	}
+
+	ASSERT(false && "Too many SmallObjectAllocators are used on the same thread");
+	std::abort();
+}
+
+SmallObjectAllocator::ThreadHeap* SmallObjectAllocator::AdoptThreadHeap()
+{
+	{
+		DESIRE_SCOPED_SPINLOCK(m_heapsSpinLock);
+		if(m_pFirstAbandonedHeap != nullptr)
+		{
+			ThreadHeap* pHeap = m_pFirstAbandonedHeap;
+			m_pFirstAbandonedHeap = pHeap->pNextAbandonedHeap;
+			pHeap->pNextAbandonedHeap = nullptr;
+			return pHeap;
+		}
+	}
+
+	// The heap can't be allocated with operator new, because it would end up here again
+	void* pMemory = MemorySystem::SystemAlignedAlloc(sizeof(ThreadHeap), alignof(ThreadHeap));
+	ASSERT(pMemory != nullptr && "Out of memory");
+	ThreadHeap* pHeap = new(pMemory) ThreadHeap();
+
+	DESIRE_SCOPED_SPINLOCK(m_heapsSpinLock);
+	pHeap->pNextHeap = m_pFirstHeap;
+	m_pFirstHeap = pHeap;
+	return pHeap;
+}
+
+void SmallObjectAllocator::AbandonThreadHeap(ThreadHeap* pHeap)
+{
+	m_allocatedBytes += pHeap->pendingAllocatedBytes;
+	pHeap->pendingAllocatedBytes = 0;
+
+	DESIRE_SCOPED_SPINLOCK(m_heapsSpinLock);
+	pHeap->pNextAbandonedHeap = m_pFirstAbandonedHeap;
+	m_pFirstAbandonedHeap = pHeap;
+}
+
+void* SmallObjectAllocator::AllocFromHeap(ThreadHeap* pHeap, uint32_t sizeClassIdx, EMemoryTag tag)
+{
+	const uint32_t blockSize = kSizeClasses[sizeClassIdx];
+	ThreadHeap::SizeClass& sizeClass = pHeap->sizeClasses[sizeClassIdx];
+
+	void* pMemory = sizeClass.freeList.Pop();
+	if(pMemory != nullptr)
+	{
+		AddAllocatedBytes(pHeap, blockSize);
+	}
+	else
+	{
+		// Blocks freed on other threads are still counted as allocated, so they are not added again
+		pMemory = pHeap->remoteFreeLists[sizeClassIdx].Pop();
+	}
+
+	if(pMemory == nullptr)
+	{
+		AddAllocatedBytes(pHeap, blockSize);
+
+		if(sizeClass.pNextBlockInSlab + blockSize > sizeClass.pSlabEnd)
+		{
+			// Start a new slab
+			if(pHeap->pNextSlab == pHeap->pChunkEnd)
+			{
+				uint8_t* pChunkMemory = static_cast<uint8_t*>(MemorySystem::SystemAlignedAlloc(kNumSlabsInChunk * kSlabSize, kSlabSize));
+				ASSERT(pChunkMemory != nullptr && "Out of memory");
+				MemorySystem::RegisterHeaderlessPages(pChunkMemory, kNumSlabsInChunk * kSlabSize, *this);
+
+				Slab* pChunk = GetSlab(pChunkMemory);
+				pChunk->pNextChunk = pHeap->pFirstChunk;
+				pHeap->pFirstChunk = pChunk;
+				pHeap->pNextSlab = pChunkMemory;
+				pHeap->pChunkEnd = pChunkMemory + kNumSlabsInChunk * kSlabSize;
+			}
+
+			uint8_t* pSlabMemory = pHeap->pNextSlab;
+			pHeap->pNextSlab += kSlabSize;
+
+			// Every block has a tag byte in the remaining space of the slab
+			Slab* pSlab = GetSlab(pSlabMemory);
+			pSlab->pOwnerHeap = pHeap;
+			pSlab->sizeClassIdx = sizeClassIdx;
+			pSlab->numBlocks = static_cast<uint32_t>((kSlabSize - sizeof(Slab)) / (blockSize + sizeof(EMemoryTag)));
+
+			sizeClass.pNextBlockInSlab = pSlabMemory;
+			sizeClass.pSlabEnd = pSlabMemory + pSlab->numBlocks * blockSize;
+		}
+
+		pMemory = sizeClass.pNextBlockInSlab;
+		sizeClass.pNextBlockInSlab += blockSize;
+	}
+
+	Slab* pSlab = GetSlab(pMemory);
+	const size_t offsetInSlab = reinterpret_cast<uintptr_t>(pMemory) & (kSlabSize - 1);
+	GetBlockTags(pSlab)[offsetInSlab / blockSize] = tag;
+	return pMemory;
+}
+
+SmallObjectAllocator::Slab* SmallObjectAllocator::GetSlab(const void* pMemory)
+{
+	return reinterpret_cast<Slab*>((reinterpret_cast<uintptr_t>(pMemory) & ~(kSlabSize - 1)) + kSlabSize - sizeof(Slab));
+}
+
+uint8_t* SmallObjectAllocator::GetSlabMemory(Slab* pSlab)
+{
+	return reinterpret_cast<uint8_t*>(pSlab) + sizeof(Slab) - kSlabSize;
+}
+
+EMemoryTag* SmallObjectAllocator::GetBlockTags(Slab* pSlab)
+{
+	return reinterpret_cast<EMemoryTag*>(pSlab) - pSlab->numBlocks;
+}
+
+void SmallObjectAllocator::AddAllocatedBytes(ThreadHeap* pHeap, int64_t size)
+{
+	pHeap->pendingAllocatedBytes += size;
+	if(pHeap->pendingAllocatedBytes >= kAllocatedBytesFlushLimit || pHeap->pendingAllocatedBytes <= -kAllocatedBytesFlushLimit)
+	{
+		m_allocatedBytes += pHeap->pendingAllocatedBytes;
+		pHeap->pendingAllocatedBytes = 0;
+	}
+}
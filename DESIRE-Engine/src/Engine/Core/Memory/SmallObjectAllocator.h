@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Engine/Core/Memory/Allocator.h"
+#include "Engine/Core/Memory/SystemAllocator.h"
+#include "Engine/Core/SpinLock.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	SmallObjectAllocator serves small allocations from size classes, bigger ones are forwarded to the system.
+//	Each thread has its own heap with a free list and a slab for every size class, so allocations and frees on the same
+//	thread don't need any synchronization. Memory freed on an other thread is pushed to a lock-free list of the owner
+//	heap, which takes it back when its own free list is empty. The slabs are aligned to their size, so the owner of a
+//	block is found by masking its address.
+//	The slabs are registered as headerless pages in the MemorySystem, so small allocations don't need a header there.
+//	The memory tags share the slabs, the tag of each block is stored in a byte array at the end of its slab to be able to
+//	tell the tag of an allocation without a header.
+//	The heap of an exited thread is adopted by the next new thread.
+//	Note: An allocator can only be destroyed after all the threads which were using it have exited (except the calling one)
+// --------------------------------------------------------------------------------------------------------------------
+
+class SmallObjectAllocator : public Allocator
+{
+public:
+	static constexpr size_t kMaxSmallObjectSize = 1024;
+	static constexpr size_t kSlabSize = 64 * 1024;
+
+	SmallObjectAllocator();
+	~SmallObjectAllocator() override;
+
+	void* Alloc(size_t size) final override;
+	void* Realloc(void* pMemory, size_t newSize, size_t oldSize) final override;
+	void Free(void* pMemory, size_t size) final override;
+
+	void* AllocWithoutHeader(size_t size, size_t alignment) final override;
+	size_t GetMaxSizeWithoutHeader() const final override;
+	bool IsAllocationWithoutHeader(const void* pMemory) const final override;
+	size_t GetAllocationSize(const void* pMemory) const final override;
+	EMemoryTag GetAllocationTag(const void* pMemory) const final override;
+
+	// Returns the size of the block which is used for an allocation of the given size
+	static size_t GetBlockSize(size_t size);
+
+private:
+	struct Slab;
+	struct ThreadHeap;
+	struct ThreadHeapCache;
+
+	ThreadHeap* GetThreadHeap(bool createIfNotExists);
+	ThreadHeap* AdoptThreadHeap();
+	void AbandonThreadHeap(ThreadHeap* pHeap);
+	void* AllocFromSizeClass(uint32_t sizeClassIdx);
+	void* AllocFromHeap(ThreadHeap* pHeap, uint32_t sizeClassIdx, EMemoryTag tag);
+	void AddAllocatedBytes(ThreadHeap* pHeap, int64_t size);
+
+	static Slab* GetSlab(const void* pMemory);
+	static uint8_t* GetSlabMemory(Slab* pSlab);
+	static EMemoryTag* GetBlockTags(Slab* pSlab);
+
+	SystemAllocator m_largeObjectAllocator;
+
+	// The heaps of the calling thread
+	static thread_local ThreadHeapCache s_threadHeapCache;
+
+	SpinLock m_heapsSpinLock;
+	ThreadHeap* m_pFirstHeap = nullptr;
+	ThreadHeap* m_pFirstAbandonedHeap = nullptr;
+};
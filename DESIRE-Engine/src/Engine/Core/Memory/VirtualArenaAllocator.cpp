@@ -0,0 +1,161 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/Memory/VirtualArenaAllocator.h"
+
+#include "Engine/Core/Memory/MemorySystem.h"
+
+// The memory is committed in bigger steps to reduce the number of system calls
+static constexpr size_t kMinCommitGranularity = 64 * 1024;
+
+static size_t AlignSize(size_t size, size_t alignment)
+{
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+VirtualArenaAllocator::VirtualArenaAllocator(size_t reservedSize, bool useHugePages)
+	: m_ownerThreadId(std::this_thread::get_id())
+{
+	m_commitGranularity = useHugePages ? MemorySystem::kHugePageSize : std::max(kMinCommitGranularity, MemorySystem::GetVirtualMemoryGranularity());
+	m_reservedSize = AlignSize(reservedSize, m_commitGranularity);
+	m_pMemoryStart = static_cast<uint8_t*>(MemorySystem::VirtualReserve(m_reservedSize, useHugePages));
+	if(m_pMemoryStart == nullptr)
+	{
+		// All allocations will fail
+		ASSERT(false && "Failed to reserve address space");
+		m_reservedSize = 0;
+	}
+}
+
+VirtualArenaAllocator::~VirtualArenaAllocator()
+{
+	if(m_pMemoryStart != nullptr)
+	{
+		MemorySystem::VirtualRelease(m_pMemoryStart, m_reservedSize);
+	}
+}
+
+void* VirtualArenaAllocator::Alloc(size_t size)
+{
+	ASSERT(std::this_thread::get_id() == m_ownerThreadId);
+
+	const size_t offset = AlignSize(m_allocatedBytes, MemorySystem::kDefaultAlignment);
+	if(!CommitUpTo(offset + size))
+	{
+		ASSERT(false && "Out of reserved memory");
+		return nullptr;
+	}
+
+	m_allocatedBytes = offset + size;
+	UpdateHighWaterMark();
+	return m_pMemoryStart + offset;
+}
+
+void* VirtualArenaAllocator::Realloc(void* pMemory, size_t newSize, size_t oldSize)
+{
+	ASSERT(std::this_thread::get_id() == m_ownerThreadId);
+
+	if(IsTheLastAllocation(pMemory, oldSize))
+	{
+		// Resize the last allocation in place
+		const size_t offset = static_cast<uint8_t*>(pMemory) - m_pMemoryStart;
+		if(CommitUpTo(offset + newSize))
+		{
+			m_allocatedBytes = offset + newSize;
+			UpdateHighWaterMark();
+			return pMemory;
+		}
+
+		return nullptr;
+	}
+
+	void* pNewMemory = Alloc(newSize);
+	if(pNewMemory)
+	{
+		memcpy(pNewMemory, pMemory, std::min(newSize, oldSize));
+	}
+
+	return pNewMemory;
+}
+
+void VirtualArenaAllocator::Free(void* pMemory, size_t size)
+{
+	ASSERT(IsMemoryFromThis(pMemory));
+
+	if(std::this_thread::get_id() != m_ownerThreadId)
+	{
+		return;
+	}
+
+	if(IsTheLastAllocation(pMemory, size))
+	{
+		m_allocatedBytes -= size;
+	}
+}
+
+void VirtualArenaAllocator::Reset(size_t keepCommittedSize)
+{
+	m_allocatedBytes = 0;
+
+	keepCommittedSize = AlignSize(keepCommittedSize, m_commitGranularity);
+	const size_t committedSize = m_committedSize.load(std::memory_order_relaxed);
+	if(committedSize > keepCommittedSize)
+	{
+		MemorySystem::VirtualDecommit(m_pMemoryStart + keepCommittedSize, committedSize - keepCommittedSize);
+		m_committedSize.store(keepCommittedSize, std::memory_order_relaxed);
+	}
+}
+
+bool VirtualArenaAllocator::IsMemoryFromThis(const void* pMemory) const
+{
+	return (m_pMemoryStart <= pMemory && pMemory < m_pMemoryStart + m_reservedSize);
+}
+
+size_t VirtualArenaAllocator::GetReservedSize() const
+{
+	return m_reservedSize;
+}
+
+size_t VirtualArenaAllocator::GetCommittedSize() const
+{
+	return m_committedSize.load(std::memory_order_relaxed);
+}
+
+size_t VirtualArenaAllocator::GetHighWaterMark() const
+{
+	return m_highWaterMark.load(std::memory_order_relaxed);
+}
+
+bool VirtualArenaAllocator::CommitUpTo(size_t size)
+{
+	const size_t committedSize = m_committedSize.load(std::memory_order_relaxed);
+	if(size <= committedSize)
+	{
+		return true;
+	}
+
+	if(size > m_reservedSize)
+	{
+		return false;
+	}
+
+	const size_t newCommittedSize = std::min(AlignSize(size, m_commitGranularity), m_reservedSize);
+	if(!MemorySystem::VirtualCommit(m_pMemoryStart + committedSize, newCommittedSize - committedSize))
+	{
+		return false;
+	}
+
+	m_committedSize.store(newCommittedSize, std::memory_order_relaxed);
+	return true;
+}
+
+void VirtualArenaAllocator::UpdateHighWaterMark()
+{
+	if(m_allocatedBytes > m_highWaterMark.load(std::memory_order_relaxed))
+	{
+		m_highWaterMark.store(m_allocatedBytes, std::memory_order_relaxed);
+	}
+}
+
+bool VirtualArenaAllocator::IsTheLastAllocation(const void* pMemory, size_t size) const
+{
+	return (m_allocatedBytes >= size && pMemory == m_pMemoryStart + m_allocatedBytes - size);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Engine/Core/Memory/Allocator.h"
+
+// --------------------------------------------------------------------------------------------------------------------
+//	A linear memory allocator which reserves a big address range up front and commits the pages on demand as the
+//	allocations advance. The memory never moves and only the used part of the range is backed by physical memory.
+//	Reset() gives the committed pages back to the system above the given size.
+//	The allocator is owned by the thread which created it. Freeing memory on an other thread is ignored, the memory is
+//	reclaimed by the next reset.
+// --------------------------------------------------------------------------------------------------------------------
+
+class VirtualArenaAllocator : public Allocator
+{
+public:
+	VirtualArenaAllocator(size_t reservedSize, bool useHugePages = false);
+	~VirtualArenaAllocator() override;
+
+	void* Alloc(size_t size) final override;
+	void* Realloc(void* pMemory, size_t newSize, size_t oldSize) final override;
+	void Free(void* pMemory, size_t size) final override;
+
+	// Free everything in O(1) and decommit the memory above 'keepCommittedSize'
+	void Reset(size_t keepCommittedSize = 0);
+
+	bool IsMemoryFromThis(const void* pMemory) const;
+
+	size_t GetReservedSize() const;
+	size_t GetCommittedSize() const;
+	// Returns the maximum number of bytes which were allocated since the creation of the allocator
+	size_t GetHighWaterMark() const;
+
+private:
+	bool CommitUpTo(size_t size);
+	void UpdateHighWaterMark();
+	bool IsTheLastAllocation(const void* pMemory, size_t size) const;
+
+	const std::thread::id m_ownerThreadId;
+	uint8_t* m_pMemoryStart = nullptr;
+	size_t m_reservedSize = 0;
+	size_t m_commitGranularity = 0;
+
+	// These can be queried from other threads
+	std::atomic<size_t> m_committedSize = 0;
+	std::atomic<size_t> m_highWaterMark = 0;
+};
@@ -2,18 +2,70 @@
 #include "Engine/Core/Object.h"
 
 #include "Engine/Core/Component.h"
+#include "Engine/Core/Job/ParallelFor.h"
 #include "Engine/Core/Math/Transform.h"
+#include "Engine/Core/Memory/MemorySystem.h"
 
-static constexpr uint32_t kMaxNumTransforms = 10000;
-static Transform s_preallocatedTransforms[kMaxNumTransforms];
+// The transforms are stored in a single array in depth-first order. The address space of the array is reserved for the
+// maximum number of transforms and it is committed as the number of transforms grows, so the transforms never move
+// because of the growth.
+static size_t s_maxNumTransforms = Object::kDefaultMaxNumTransforms;
+static Transform* s_pTransforms = nullptr;
 static size_t s_numTransforms = 0;
+static size_t s_numCommittedTransforms = 0;
+
+// The indices of the transforms grouped by their depth in the hierarchy (rebuilt when the transforms are moved)
+static Array<Array<uint32_t>> s_transformIndicesByDepth;
+static bool s_isTransformDepthIndexDirty = true;
+
+// The minimum number of transforms in a chunk of a level processed by one thread
+static constexpr size_t kParallelUpdateGrainSize = 256;
+
+// The number of transforms marked dirty since the last update (a transform can be counted multiple times)
+static size_t s_numDirtyTransforms = 0;
+// Below this the parallel update falls back to the linear pass as splitting the levels doesn't pay off
+static constexpr size_t kMinNumDirtyTransformsForParallelUpdate = 2048;
+
+static size_t AlignTransformMemorySize(size_t size)
+{
+	// Committing in bigger steps to avoid a system call for every few new objects
+	const size_t granularity = std::max<size_t>(1024 * 1024, MemorySystem::GetVirtualMemoryGranularity());
+	return (size + granularity - 1) / granularity * granularity;
+}
+
+// Makes sure that the memory is committed for the given number of transforms
+static void EnsureTransformCapacity(size_t numTransforms)
+{
+	if(numTransforms <= s_numCommittedTransforms)
+	{
+		return;
+	}
+
+	ASSERT(numTransforms <= s_maxNumTransforms && "Too many transforms, the limit can be raised by Object::SetMaxNumTransforms()");
+
+	const size_t reservedSize = AlignTransformMemorySize(s_maxNumTransforms * sizeof(Transform));
+	if(s_pTransforms == nullptr)
+	{
+		s_pTransforms = static_cast<Transform*>(MemorySystem::VirtualReserve(reservedSize));
+		ASSERT(s_pTransforms != nullptr && "Failed to reserve address space");
+	}
+
+	const size_t committedSize = AlignTransformMemorySize(s_numCommittedTransforms * sizeof(Transform));
+	const size_t newCommittedSize = std::min(AlignTransformMemorySize(numTransforms * sizeof(Transform)), reservedSize);
+	const bool isCommitted = MemorySystem::VirtualCommit(reinterpret_cast<uint8_t*>(s_pTransforms) + committedSize, newCommittedSize - committedSize);
+	ASSERT(isCommitted && "Out of memory");
+	DESIRE_UNUSED(isCommitted);
+
+	s_numCommittedTransforms = std::min(newCommittedSize / sizeof(Transform), s_maxNumTransforms);
+}
 
 Object::Object()
 {
-	ASSERT(s_numTransforms < kMaxNumTransforms);
-	m_pTransform = &s_preallocatedTransforms[s_numTransforms++];
+	EnsureTransformCapacity(s_numTransforms + 1);
+	m_pTransform = new(&s_pTransforms[s_numTransforms++]) Transform();
 	m_pTransform->m_pOwner = this;
 	m_pTransform->ResetToIdentity();
+	s_isTransformDepthIndexDirty = true;
 }
 
 Object::~Object()
@@ -23,6 +75,7 @@ Object::~Object()
 	{
 		SetParent(nullptr);
 		s_numTransforms -= m_numTransformsInHierarchy;
+		s_isTransformDepthIndexDirty = true;
 	}
 
 	for(Object* pChild : m_children)
@@ -100,14 +153,15 @@ void Object::SetParent(Object* pNewParent)
 	}
 	else
 	{
-		m_pTransform = &s_preallocatedTransforms[s_numTransforms];
+		m_pTransform = &s_pTransforms[s_numTransforms];
 	}
 
 	ptrdiff_t numToMove = pOldTransform - m_pTransform;
 	if(numToMove != 0)
 	{
-		Transform* pSavedTransforms = &s_preallocatedTransforms[s_numTransforms];
-		ASSERT(m_numTransformsInHierarchy <= DESIRE_ASIZEOF(s_preallocatedTransforms) - s_numTransforms);
+		// The end of the array is used as a temporary storage
+		EnsureTransformCapacity(s_numTransforms + m_numTransformsInHierarchy);
+		Transform* pSavedTransforms = &s_pTransforms[s_numTransforms];
 		memcpy(pSavedTransforms, pOldTransform, m_numTransformsInHierarchy * sizeof(Transform));
 
 		Transform* pMovedTransformDst = nullptr;
@@ -135,6 +189,7 @@ void Object::SetParent(Object* pNewParent)
 
 	m_pTransform->m_flags |= Transform::WORLD_MATRIX_DIRTY;
 	MarkAllChildrenTransformDirty();
+	s_isTransformDepthIndexDirty = true;
 }
 
 Object* Object::GetParent() const
@@ -150,7 +205,7 @@ Object& Object::CreateChildObject(const String& name)
 	return *pObject;
 }
 
-const Array<Object*>& Object::GetChildren() const
+const InlineArray<Object*, 4>& Object::GetChildren() const
 {
 	return m_children;
 }
@@ -219,7 +274,7 @@ Component* Object::GetComponentByTypeId(int32_t typeId) const
 	return (iter != m_components.end() && (*iter)->GetTypeId() == typeId) ? iter->get() : nullptr;
 }
 
-const Array<std::unique_ptr<Component>>& Object::GetComponents() const
+const InlineArray<std::unique_ptr<Component>, 4>& Object::GetComponents() const
 {
 	return m_components;
 }
@@ -231,12 +286,103 @@ Transform& Object::GetTransform() const
 
 void Object::MarkAllChildrenTransformDirty()
 {
+	s_numDirtyTransforms += m_numTransformsInHierarchy;
+
 	Transform* pChildTransform = m_pTransform + 1;
 	for(size_t i = 1; i < m_numTransformsInHierarchy; ++i)
 	{
 		pChildTransform->m_flags |= Transform::WORLD_MATRIX_DIRTY;
 		pChildTransform++;
 	}
+
+	// Prevent UpdateAllWorldMatrices() from skipping the hierarchies of the parents (when a parent is already marked, its parents are marked as well)
+	for(Object* pObj = m_pParent; pObj != nullptr && (pObj->m_pTransform->m_flags & Transform::CHILDREN_DIRTY) == 0; pObj = pObj->m_pParent)
+	{
+		pObj->m_pTransform->m_flags |= Transform::CHILDREN_DIRTY;
+	}
+}
+
+void Object::SetMaxNumTransforms(size_t maxNumTransforms)
+{
+	ASSERT(s_pTransforms == nullptr && "The maximum number of transforms can only be changed before the first object is created");
+	if(s_pTransforms == nullptr)
+	{
+		s_maxNumTransforms = maxNumTransforms;
+	}
+}
+
+size_t Object::GetMaxNumTransforms()
+{
+	return s_maxNumTransforms;
+}
+
+void Object::UpdateAllWorldMatrices()
+{
+	// The transforms are stored in depth-first order, so the parents are always updated before their children
+	size_t idx = 0;
+	while(idx < s_numTransforms)
+	{
+		const Transform& transform = s_pTransforms[idx];
+		if(transform.m_flags & Transform::WORLD_MATRIX_DIRTY)
+		{
+			transform.UpdateWorldMatrix();
+		}
+		else if((transform.m_flags & Transform::CHILDREN_DIRTY) == 0)
+		{
+			// Skip the whole hierarchy as it is up-to-date
+			idx += transform.m_pOwner->m_numTransformsInHierarchy;
+			continue;
+		}
+
+		transform.m_flags &= ~Transform::CHILDREN_DIRTY;
+		idx++;
+	}
+
+	s_numDirtyTransforms = 0;
+}
+
+void Object::UpdateAllWorldMatricesParallel()
+{
+	if(s_numDirtyTransforms < kMinNumDirtyTransformsForParallelUpdate)
+	{
+		UpdateAllWorldMatrices();
+		return;
+	}
+
+	if(s_isTransformDepthIndexDirty)
+	{
+		RebuildTransformDepthIndex();
+	}
+
+	// All the parents of a level are updated before the next level is started
+	for(Array<uint32_t>& indices : s_transformIndicesByDepth)
+	{
+		std::atomic<bool> hasDirtyChildren = false;
+		ParallelFor(indices, kParallelUpdateGrainSize, [&hasDirtyChildren](uint32_t idx)
+		{
+			const Transform& transform = s_pTransforms[idx];
+			const bool isDirty = (transform.m_flags & Transform::WORLD_MATRIX_DIRTY);
+			if((transform.m_flags & Transform::CHILDREN_DIRTY) || (isDirty && transform.m_pOwner->m_numTransformsInHierarchy > 1))
+			{
+				hasDirtyChildren.store(true, std::memory_order_relaxed);
+			}
+
+			if(isDirty)
+			{
+				transform.UpdateWorldMatrix();
+			}
+
+			transform.m_flags &= ~Transform::CHILDREN_DIRTY;
+		});
+
+		// The levels below are up-to-date
+		if(!hasDirtyChildren)
+		{
+			break;
+		}
+	}
+
+	s_numDirtyTransforms = 0;
 }
 
 Component& Object::AddComponent_Internal(std::unique_ptr<Component>&& spComponent)
@@ -290,3 +436,30 @@ void Object::RefreshParentPointerInTransforms(Transform* pFirstTransform, size_t
 		pTransformTmp++;
 	}
 }
+
+void Object::RebuildTransformDepthIndex()
+{
+	for(Array<uint32_t>& indices : s_transformIndicesByDepth)
+	{
+		indices.Clear();
+	}
+
+	// The parents are before their children in the array, so their depth is already known
+	Array<uint32_t> depths;
+	depths.SetSize(s_numTransforms);
+	for(uint32_t idx = 0; idx < s_numTransforms; ++idx)
+	{
+		const Transform* pParent = s_pTransforms[idx].m_pParent;
+		const uint32_t depth = pParent ? depths[pParent - s_pTransforms] + 1 : 0;
+		depths[idx] = depth;
+
+		if(depth >= s_transformIndicesByDepth.Size())
+		{
+			s_transformIndicesByDepth.SetSize(depth + 1);
+		}
+
+		s_transformIndicesByDepth[depth].Add(idx);
+	}
+
+	s_isTransformDepthIndexDirty = false;
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/InlineArray.h"
 #include "Engine/Core/String/StackString.h"
 
 class Component;
@@ -23,7 +23,7 @@ public:
 	Object* GetParent() const;
 
 	Object& CreateChildObject(const String& name);
-	const Array<Object*>& GetChildren() const;
+	const InlineArray<Object*, 4>& GetChildren() const;
 	Object* FindObjectByName(const String& name, bool isRecursiveSearch = false) const;
 	bool HasObjectInParentHierarchy(const Object* pObject) const;
 
@@ -47,12 +47,25 @@ public:
 	}
 
 	// Get all components
-	const Array<std::unique_ptr<Component>>& GetComponents() const;
+	const InlineArray<std::unique_ptr<Component>, 4>& GetComponents() const;
 
 	Transform& GetTransform() const;
 
 	void MarkAllChildrenTransformDirty();
 
+	// Updates the dirty world matrices of all the transforms in a single linear pass
+	static void UpdateAllWorldMatrices();
+	// Updates the dirty world matrices level by level in the hierarchy, splitting each level across the JobSystem threads
+	// Only pays off for a large number of dirty transforms, below that it falls back to UpdateAllWorldMatrices()
+	// The results are the same as the ones of UpdateAllWorldMatrices()
+	static void UpdateAllWorldMatricesParallel();
+
+	// Sets the maximum number of transforms (which is the number of objects), it can only be called before the first object is created
+	// Only the address space is reserved for the maximum, the memory is committed as the objects are created
+	static void SetMaxNumTransforms(size_t maxNumTransforms);
+	static size_t GetMaxNumTransforms();
+
+	static constexpr size_t kDefaultMaxNumTransforms = 1024 * 1024;
 	static constexpr size_t kMaxObjectNameLength = 32;
 
 private:
@@ -61,13 +74,14 @@ private:
 	void RemoveChild_Internal(Object* pChild);
 
 	static void RefreshParentPointerInTransforms(Transform* pFirstTransform, size_t transformCount);
+	static void RebuildTransformDepthIndex();
 
-	Array<std::unique_ptr<Component>> m_components;
+	InlineArray<std::unique_ptr<Component>, 4> m_components;
 	Transform* m_pTransform = nullptr;
 	size_t m_numTransformsInHierarchy = 1;
 
 	Object* m_pParent = nullptr;
-	Array<Object*> m_children;
+	InlineArray<Object*, 4> m_children;
 
 	bool m_isActive = true;
 
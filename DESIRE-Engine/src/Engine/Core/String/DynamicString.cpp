@@ -3,27 +3,22 @@
 
 #include "Engine/Core/Memory/MemorySystem.h"
 
-static char s_emptyData[] = { '\0' };
-
 DynamicString::DynamicString()
 {
-	m_pData = s_emptyData;
+	m_pData = m_inlineData;
+	m_pData[0] = '\0';
 }
 
 DynamicString::DynamicString(const char* str, size_t size)
+	: DynamicString()
 {
 	Set(str, size);
 }
 
 DynamicString::DynamicString(DynamicString&& string)
+	: DynamicString()
 {
-	m_pData = string.m_pData;
-	m_size = string.m_size;
-	m_preallocatedSize = string.m_preallocatedSize;
-
-	string.m_pData = s_emptyData;
-	string.m_size = 0;
-	string.m_preallocatedSize = 0;
+	MoveFrom(string);
 }
 
 DynamicString::~DynamicString()
@@ -36,14 +31,7 @@ DynamicString& DynamicString::operator =(DynamicString&& string)
 	ASSERT(this != &string);	// It's not allowed to copy from ourself
 
 	Reset();
-
-	m_pData = string.m_pData;
-	m_size = string.m_size;
-	m_preallocatedSize = string.m_preallocatedSize;
-
-	string.m_pData = s_emptyData;
-	string.m_size = 0;
-	string.m_preallocatedSize = 0;
+	MoveFrom(string);
 
 	return *this;
 }
@@ -60,13 +48,15 @@ DynamicString DynamicString::SubString(size_t pos, size_t numChars) const
 
 void DynamicString::Reset()
 {
-	if(m_pData != s_emptyData)
+	if(!IsUsingInlineStorage())
 	{
 		MemorySystem::Free(m_pData);
-		m_pData = s_emptyData;
-		m_size = 0;
-		m_preallocatedSize = 0;
+		m_pData = m_inlineData;
+		m_preallocatedSize = kInlineSize;
 	}
+
+	m_pData[0] = '\0';
+	m_size = 0;
 }
 
 bool DynamicString::Reserve(size_t numChars)
@@ -75,15 +65,39 @@ bool DynamicString::Reserve(size_t numChars)
 	{
 		m_preallocatedSize = numChars + 1;
 
-		if(m_pData != s_emptyData)
+		if(!IsUsingInlineStorage())
 		{
 			m_pData = static_cast<char*>(MemorySystem::Realloc(m_pData, m_preallocatedSize * sizeof(char)));
 		}
 		else
 		{
 			m_pData = static_cast<char*>(MemorySystem::Alloc(m_preallocatedSize * sizeof(char)));
+			memcpy(m_pData, m_inlineData, m_size + 1);
 		}
 	}
 
 	return true;
 }
+
+void DynamicString::MoveFrom(DynamicString& string)
+{
+	ASSERT(IsUsingInlineStorage() && m_size == 0);
+
+	if(string.IsUsingInlineStorage())
+	{
+		memcpy(m_inlineData, string.m_inlineData, string.m_size + 1);
+	}
+	else
+	{
+		m_pData = string.m_pData;
+		m_preallocatedSize = string.m_preallocatedSize;
+
+		string.m_pData = string.m_inlineData;
+		string.m_preallocatedSize = kInlineSize;
+	}
+
+	m_size = string.m_size;
+
+	string.m_pData[0] = '\0';
+	string.m_size = 0;
+}
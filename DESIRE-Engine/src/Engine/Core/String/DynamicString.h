@@ -29,6 +29,13 @@ public:
 	// Requests the string capacity to be (at least) as big to hold numChars characters. Returns true on success
 	bool Reserve(size_t numChars) override;
 
+	// Strings shorter than this are stored in place without allocating memory
+	static constexpr size_t kInlineSize = 24;
+
 private:
-	size_t m_preallocatedSize = 0;
+	bool IsUsingInlineStorage() const	{ return (m_pData == m_inlineData); }
+	void MoveFrom(DynamicString& string);
+
+	size_t m_preallocatedSize = kInlineSize;
+	char m_inlineData[kInlineSize];
 };
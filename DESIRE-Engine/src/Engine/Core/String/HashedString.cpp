@@ -3,15 +3,84 @@
 
 #include "Engine/Core/String/String.h"
 
+#if DESIRE_HASHED_STRING_INTERNING
+	#include "Engine/Core/Container/HashedStringMap.h"
+	#include "Engine/Core/String/DynamicString.h"
+#endif
+
 #define XXH_INLINE_ALL
 #include "xxHash/xxhash.h"
 
+#if DESIRE_HASHED_STRING_INTERNING
+struct HashedStringInterningTable
+{
+	std::mutex mutex;
+	HashedStringMap<std::unique_ptr<DynamicString>> strings;
+
+	static HashedStringInterningTable& Get()
+	{
+		// The table is never destroyed, so it can be used by the destructors of other static objects as well
+		alignas(HashedStringInterningTable) static uint8_t s_instanceStorage[sizeof(HashedStringInterningTable)];
+		static HashedStringInterningTable* s_pInstance = new(s_instanceStorage) HashedStringInterningTable();
+		return *s_pInstance;
+	}
+};
+#endif
+
 HashedString::HashedString(const String& string)
 	: HashedString(string.Str(), string.Length())
 {
 }
 
 HashedString::HashedString(const void* pData, size_t size)
-	: m_hash(XXH3_64bits(pData, size))
+	: m_hash(XXH64(pData, size, 0))
+{
+#if DESIRE_HASHED_STRING_INTERNING
+	const String string(static_cast<const char*>(pData), size);
+
+	HashedStringInterningTable& table = HashedStringInterningTable::Get();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	std::unique_ptr<DynamicString>* pExistingString = table.strings.Find(*this);
+	if(pExistingString != nullptr)
+	{
+		ASSERT(**pExistingString == string && "HashedString collision: two different strings have the same hash");
+	}
+	else
+	{
+		table.strings.Insert(*this, std::make_unique<DynamicString>(string));
+	}
+#endif
+}
+
+HashedString HashedString::FromConcatenation(std::initializer_list<const String*> strings)
+{
+#if DESIRE_HASHED_STRING_INTERNING
+	// The interning table needs the whole string
+	DynamicString concatenation;
+	for(const String* pString : strings)
+	{
+		concatenation += *pString;
+	}
+
+	return HashedString(concatenation);
+#else
+	XXH64_state_t state;
+	XXH64_reset(&state, 0);
+	for(const String* pString : strings)
+	{
+		XXH64_update(&state, pString->Str(), pString->Length());
+	}
+
+	return HashedString(XXH64_digest(&state));
+#endif
+}
+
+#if DESIRE_HASHED_STRING_INTERNING
+const char* HashedString::GetDebugString() const
 {
+	HashedStringInterningTable& table = HashedStringInterningTable::Get();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	const std::unique_ptr<DynamicString>* pString = table.strings.Find(*this);
+	return (pString != nullptr) ? (*pString)->Str() : nullptr;
 }
+#endif
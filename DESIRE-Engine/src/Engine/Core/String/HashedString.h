@@ -2,22 +2,165 @@
 
 class String;
 
+// --------------------------------------------------------------------------------------------------------------------
+//	HashedString stores the 64-bit XXH64 hash of a string.
+//	The hash of a string literal can be computed at compile time with DESIRE_HASHED_STRING(). When the optional
+//	DESIRE_HASHED_STRING_INTERNING is enabled, every hashed string is registered in a global interning table which can
+//	map the hashes back to the strings and asserts when two different strings have the same hash.
+//	Note: The interning table is locked and searched at every construction and never shrinks, so it is only for debugging
+// --------------------------------------------------------------------------------------------------------------------
+
+#if !defined(DESIRE_HASHED_STRING_INTERNING)
+	#define DESIRE_HASHED_STRING_INTERNING	0
+#endif
+
 class HashedString
 {
 public:
 	HashedString(const String& string);
 
+	// Hashes the concatenation of the strings without building it
+	static HashedString FromConcatenation(std::initializer_list<const String*> strings);
+
+#if DESIRE_HASHED_STRING_INTERNING
 	template<size_t SIZE>
 	HashedString(const char(&str)[SIZE])
 		: HashedString(str, SIZE - 1)
 	{
 	}
+#else
+	template<size_t SIZE>
+	constexpr HashedString(const char(&str)[SIZE])
+		: m_hash(Hash64(str, SIZE - 1))
+	{
+	}
+#endif
 
-	bool operator <(HashedString other) const	{ return (m_hash < other.m_hash); }
-	bool operator ==(HashedString other) const	{ return (m_hash == other.m_hash); }
+	constexpr bool operator <(HashedString other) const		{ return (m_hash < other.m_hash); }
+	constexpr bool operator ==(HashedString other) const	{ return (m_hash == other.m_hash); }
+	constexpr bool operator !=(HashedString other) const	{ return (m_hash != other.m_hash); }
+
+	constexpr uint64_t GetHash() const						{ return m_hash; }
+
+#if DESIRE_HASHED_STRING_INTERNING
+	// Returns the string from the interning table, or nullptr if the hash was never registered
+	const char* GetDebugString() const;
+#endif
+
+	// Compile-time implementation of XXH64 with seed 0 which gives the same result as the runtime version
+	static constexpr uint64_t Hash64(const char* pStr, size_t size);
 
 private:
 	HashedString(const void* pData, size_t size);
 
+	explicit constexpr HashedString(uint64_t hash)
+		: m_hash(hash)
+	{
+	}
+
+	static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+	static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+	static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+	static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+	static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+	static constexpr uint64_t RotateLeft(uint64_t x, int r)
+	{
+		return (x << r) | (x >> (64 - r));
+	}
+
+	static constexpr uint64_t Read64(const char* pStr)
+	{
+		uint64_t value = 0;
+		for(int i = 7; i >= 0; --i)
+		{
+			value = (value << 8) | static_cast<uint8_t>(pStr[i]);
+		}
+		return value;
+	}
+
+	static constexpr uint64_t Read32(const char* pStr)
+	{
+		uint64_t value = 0;
+		for(int i = 3; i >= 0; --i)
+		{
+			value = (value << 8) | static_cast<uint8_t>(pStr[i]);
+		}
+		return value;
+	}
+
+	static constexpr uint64_t Round(uint64_t acc, uint64_t input)
+	{
+		return RotateLeft(acc + input * kPrime2, 31) * kPrime1;
+	}
+
+	static constexpr uint64_t MergeRound(uint64_t acc, uint64_t value)
+	{
+		return (acc ^ Round(0, value)) * kPrime1 + kPrime4;
+	}
+
 	uint64_t m_hash = 0;
 };
+
+constexpr uint64_t HashedString::Hash64(const char* pStr, size_t size)
+{
+	size_t idx = 0;
+	uint64_t hash = 0;
+
+	if(size >= 32)
+	{
+		uint64_t v1 = kPrime1 + kPrime2;
+		uint64_t v2 = kPrime2;
+		uint64_t v3 = 0;
+		uint64_t v4 = 0 - kPrime1;
+		for(; idx + 32 <= size; idx += 32)
+		{
+			v1 = Round(v1, Read64(&pStr[idx]));
+			v2 = Round(v2, Read64(&pStr[idx + 8]));
+			v3 = Round(v3, Read64(&pStr[idx + 16]));
+			v4 = Round(v4, Read64(&pStr[idx + 24]));
+		}
+
+		hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+		hash = MergeRound(hash, v1);
+		hash = MergeRound(hash, v2);
+		hash = MergeRound(hash, v3);
+		hash = MergeRound(hash, v4);
+	}
+	else
+	{
+		hash = kPrime5;
+	}
+
+	hash += size;
+
+	for(; idx + 8 <= size; idx += 8)
+	{
+		hash = RotateLeft(hash ^ Round(0, Read64(&pStr[idx])), 27) * kPrime1 + kPrime4;
+	}
+
+	if(idx + 4 <= size)
+	{
+		hash = RotateLeft(hash ^ (Read32(&pStr[idx]) * kPrime1), 23) * kPrime2 + kPrime3;
+		idx += 4;
+	}
+
+	for(; idx < size; ++idx)
+	{
+		hash = RotateLeft(hash ^ (static_cast<uint8_t>(pStr[idx]) * kPrime5), 11) * kPrime1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= kPrime2;
+	hash ^= hash >> 29;
+	hash *= kPrime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// Hashes a string literal at compile time (with DESIRE_HASHED_STRING_INTERNING the string is registered in the interning table instead)
+#if DESIRE_HASHED_STRING_INTERNING
+	#define DESIRE_HASHED_STRING(STR)	HashedString(STR)
+#else
+	#define DESIRE_HASHED_STRING(STR)	[]() { constexpr HashedString hashedString(STR); return hashedString; }()
+#endif
@@ -1,6 +1,8 @@
 #include "Engine/stdafx.h"
 #include "Engine/Core/String/String.h"
 
+#include "Engine/Core/String/StringSIMD.h"
+
 const String String::kEmptyString = "";
 
 String::String(const char* pStr, size_t numChars)
@@ -18,7 +20,7 @@ size_t String::Find(const String& search, size_t pos) const
 		return kInvalidPos;
 	}
 
-	const char* pFoundCh = strstr(m_pData + pos, search.m_pData);
+	const char* pFoundCh = StringSIMD::FindString(m_pData + pos, m_pData + m_size, search.m_pData, search.m_size);
 	return pFoundCh ? pFoundCh - m_pData : kInvalidPos;
 }
 
@@ -29,40 +31,25 @@ size_t String::Find(char search, size_t pos) const
 		return kInvalidPos;
 	}
 
-	const char* pFoundCh = strchr(m_pData + pos, search);
+	const char* pFoundCh = StringSIMD::FindChar(m_pData + pos, m_pData + m_size, search);
 	return pFoundCh ? pFoundCh - m_pData : kInvalidPos;
 }
 
 size_t String::FindLast(const String& search) const
 {
-	const char* s = m_pData + m_size - search.m_size;
-	while(s >= m_pData)
+	if(search.m_size == 0)
 	{
-		if(memcmp(s, search.m_pData, search.m_size) == 0)
-		{
-			return static_cast<size_t>(s - m_pData);
-		}
-
-		s--;
+		return m_size;
 	}
 
-	return kInvalidPos;
+	const char* pFoundCh = StringSIMD::FindLastString(m_pData, m_pData + m_size, search.m_pData, search.m_size);
+	return pFoundCh ? pFoundCh - m_pData : kInvalidPos;
 }
 
 size_t String::FindLast(char search) const
 {
-	const char* s = m_pData + m_size - 1;
-	while(s >= m_pData)
-	{
-		if(*s == search)
-		{
-			return static_cast<size_t>(s - m_pData);
-		}
-
-		s--;
-	}
-
-	return kInvalidPos;
+	const char* pFoundCh = StringSIMD::FindLastChar(m_pData, m_pData + m_size, search);
+	return pFoundCh ? pFoundCh - m_pData : kInvalidPos;
 }
 
 const char* String::Str() const
@@ -77,28 +64,7 @@ size_t String::Length() const
 
 size_t String::LengthUTF8() const
 {
-	size_t len = 0;
-	const char* pCh = m_pData;
-	while(*pCh != '\0')
-	{
-		if(*pCh > 0)
-		{
-			pCh++;
-		}
-		else
-		{
-			// Select amongst multi-byte starters
-			switch(*pCh & 0xF0)
-			{
-				case 0xE0:	pCh += 3; break;
-				case 0xF0:	pCh += 4; break;
-				default:	pCh += 2; break;
-			}
-		}
-		len++;
-	}
-
-	return len;
+	return StringSIMD::CountUTF8Chars(m_pData, m_pData + m_size);
 }
 
 bool String::IsEmpty() const
@@ -138,20 +104,20 @@ double String::AsDouble() const
 
 int32_t String::Compare(const String& string) const
 {
-	const int32_t rv = memcmp(m_pData, string.m_pData, std::min(m_size, string.m_size));
+	const int32_t rv = StringSIMD::Compare(m_pData, string.m_pData, std::min(m_size, string.m_size));
 	return (rv != 0) ? rv : static_cast<int>(string.m_size) - static_cast<int>(m_size);
 }
 
 bool String::Equals(const String& string) const
 {
-	return (m_size == string.m_size && memcmp(m_pData, string.m_pData, m_size) == 0);
+	return (m_size == string.m_size && StringSIMD::Compare(m_pData, string.m_pData, m_size) == 0);
 }
 
 bool String::StartsWith(const String& prefix) const
 {
 	if(m_size >= prefix.m_size && prefix.m_size != 0)
 	{
-		return (memcmp(m_pData, prefix.m_pData, prefix.m_size) == 0);
+		return (StringSIMD::Compare(m_pData, prefix.m_pData, prefix.m_size) == 0);
 	}
 
 	return false;
@@ -166,7 +132,7 @@ bool String::EndsWith(const String& suffix) const
 {
 	if(m_size >= suffix.m_size && suffix.m_size != 0)
 	{
-		return (memcmp(&m_pData[m_size - suffix.m_size], suffix.m_pData, suffix.m_size) == 0);
+		return (StringSIMD::Compare(&m_pData[m_size - suffix.m_size], suffix.m_pData, suffix.m_size) == 0);
 	}
 
 	return false;
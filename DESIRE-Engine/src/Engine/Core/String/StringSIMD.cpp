@@ -0,0 +1,1044 @@
+#include "Engine/stdafx.h"
+#include "Engine/Core/String/StringSIMD.h"
+
+#include "Engine/Core/Math/math.h"
+
+#if DESIRE_USE_SSE
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		// MSVC allows the intrinsics of every instruction set in any function
+		#define DESIRE_TARGET_SSE42
+		#define DESIRE_TARGET_AVX2
+	#else
+		#include <cpuid.h>
+		#define DESIRE_TARGET_SSE42		__attribute__((target("sse4.2")))
+		#define DESIRE_TARGET_AVX2		__attribute__((target("avx2")))
+	#endif
+#endif
+
+namespace StringSIMD
+{
+
+static bool IsWhitespace(char ch)
+{
+	return (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r');
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//	Scalar
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace Scalar
+{
+
+static const char* FindChar(const char* pBegin, const char* pEnd, char ch)
+{
+	for(const char* pCh = pBegin; pCh < pEnd; ++pCh)
+	{
+		if(*pCh == ch)
+		{
+			return pCh;
+		}
+	}
+
+	return nullptr;
+}
+
+static const char* FindLastChar(const char* pBegin, const char* pEnd, char ch)
+{
+	for(const char* pCh = pEnd; pCh > pBegin; )
+	{
+		pCh--;
+		if(*pCh == ch)
+		{
+			return pCh;
+		}
+	}
+
+	return nullptr;
+}
+
+static const char* FindString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	const size_t size = pEnd - pBegin;
+	for(size_t i = 0; i + searchSize <= size; ++i)
+	{
+		if(pBegin[i] == pSearch[0] && memcmp(pBegin + i, pSearch, searchSize) == 0)
+		{
+			return pBegin + i;
+		}
+	}
+
+	return nullptr;
+}
+
+static const char* FindLastString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	const size_t size = pEnd - pBegin;
+	if(size < searchSize)
+	{
+		return nullptr;
+	}
+
+	for(size_t i = size - searchSize + 1; i > 0; )
+	{
+		i--;
+		if(pBegin[i] == pSearch[0] && memcmp(pBegin + i, pSearch, searchSize) == 0)
+		{
+			return pBegin + i;
+		}
+	}
+
+	return nullptr;
+}
+
+static int32_t Compare(const char* pA, const char* pB, size_t size)
+{
+	return memcmp(pA, pB, size);
+}
+
+static size_t CountUTF8Chars(const char* pBegin, const char* pEnd)
+{
+	size_t count = 0;
+	for(const char* pCh = pBegin; pCh < pEnd; ++pCh)
+	{
+		count += ((*pCh & 0xC0) != 0x80);
+	}
+
+	return count;
+}
+
+static void ToLower(char* pBegin, char* pEnd)
+{
+	for(char* pCh = pBegin; pCh < pEnd; ++pCh)
+	{
+		constexpr uint32_t rangeBegin = 'A';
+		constexpr uint32_t rangeSize = 'Z' - 'A';
+		if(static_cast<uint32_t>(*pCh) - rangeBegin <= rangeSize)
+		{
+			*pCh |= 0b00100000;	// Add 32 by setting the 6th bit
+		}
+	}
+}
+
+static void ToUpper(char* pBegin, char* pEnd)
+{
+	for(char* pCh = pBegin; pCh < pEnd; ++pCh)
+	{
+		constexpr uint32_t rangeBegin = 'a';
+		constexpr uint32_t rangeSize = 'z' - 'a';
+		if(static_cast<uint32_t>(*pCh) - rangeBegin <= rangeSize)
+		{
+			*pCh &= 0b11011111;	// Subtract 32 by clearing the 6th bit
+		}
+	}
+}
+
+static void ReplaceChar(char* pBegin, char* pEnd, char search, char replaceTo)
+{
+	for(char* pCh = pBegin; pCh < pEnd; ++pCh)
+	{
+		if(*pCh == search)
+		{
+			*pCh = replaceTo;
+		}
+	}
+}
+
+static const char* SkipWhitespaces(const char* pBegin, const char* pEnd)
+{
+	const char* pCh = pBegin;
+	while(pCh < pEnd && IsWhitespace(*pCh))
+	{
+		pCh++;
+	}
+
+	return pCh;
+}
+
+static const char* SkipWhitespacesBackwards(const char* pBegin, const char* pEnd)
+{
+	const char* pCh = pEnd;
+	while(pCh > pBegin && IsWhitespace(pCh[-1]))
+	{
+		pCh--;
+	}
+
+	return pCh;
+}
+
+}	// end of namespace Scalar
+
+#if DESIRE_USE_SSE
+
+// --------------------------------------------------------------------------------------------------------------------
+//	SSE2
+//	Processes 16 characters at once and leaves the remaining ones to the scalar loops.
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace SSE2
+{
+
+static constexpr ptrdiff_t kBlockSize = 16;
+
+static __m128i Load(const char* pCh)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCh));
+}
+
+static void Store(char* pCh, __m128i value)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pCh), value);
+}
+
+static uint32_t MatchChar(const char* pCh, __m128i ch)
+{
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Load(pCh), ch)));
+}
+
+static uint32_t MatchWhitespaces(const char* pCh)
+{
+	const __m128i chars = Load(pCh);
+	const __m128i isSpaceOrTab = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\t')));
+	const __m128i isNewLine = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('\r')));
+	return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(isSpaceOrTab, isNewLine)));
+}
+
+// Sets or clears the 6th bit of the letters in the range ['first', 'last']
+template<bool SET_BIT>
+static void ChangeCase(char* pBegin, char* pEnd, char first, char last)
+{
+	const __m128i rangeBegin = _mm_set1_epi8(first - 1);
+	const __m128i rangeEnd = _mm_set1_epi8(last + 1);
+	const __m128i caseBit = _mm_set1_epi8(0b00100000);
+
+	char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		// The signed comparison excludes the non-ASCII characters as they are negative
+		const __m128i chars = Load(pCh);
+		const __m128i isInRange = _mm_and_si128(_mm_cmpgt_epi8(chars, rangeBegin), _mm_cmplt_epi8(chars, rangeEnd));
+		const __m128i bits = _mm_and_si128(isInRange, caseBit);
+		Store(pCh, SET_BIT ? _mm_or_si128(chars, bits) : _mm_xor_si128(chars, bits));
+	}
+
+	if(SET_BIT)
+	{
+		Scalar::ToLower(pCh, pEnd);
+	}
+	else
+	{
+		Scalar::ToUpper(pCh, pEnd);
+	}
+}
+
+static const char* FindChar(const char* pBegin, const char* pEnd, char ch)
+{
+	const __m128i search = _mm_set1_epi8(ch);
+	const char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const uint32_t mask = MatchChar(pCh, search);
+		if(mask != 0)
+		{
+			return pCh + Math::CountTrailingZeros(mask);
+		}
+	}
+
+	return Scalar::FindChar(pCh, pEnd, ch);
+}
+
+static const char* FindLastChar(const char* pBegin, const char* pEnd, char ch)
+{
+	const __m128i search = _mm_set1_epi8(ch);
+	const char* pCh = pEnd;
+	for(; pCh - pBegin >= kBlockSize; )
+	{
+		pCh -= kBlockSize;
+		const uint32_t mask = MatchChar(pCh, search);
+		if(mask != 0)
+		{
+			return pCh + Math::FindLastSetBit(mask);
+		}
+	}
+
+	return Scalar::FindLastChar(pBegin, pCh, ch);
+}
+
+static const char* FindString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	// The last position where the search string can start
+	const char* pLast = pEnd - searchSize;
+	const char* pCh = pBegin;
+
+	// Only compare the whole search string at the positions where both its first and last character match
+	const __m128i first = _mm_set1_epi8(pSearch[0]);
+	const __m128i last = _mm_set1_epi8(pSearch[searchSize - 1]);
+	for(; pLast - pCh >= kBlockSize - 1; pCh += kBlockSize)
+	{
+		const __m128i matchFirst = _mm_cmpeq_epi8(Load(pCh), first);
+		const __m128i matchLast = _mm_cmpeq_epi8(Load(pCh + searchSize - 1), last);
+		for(uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(matchFirst, matchLast))); mask != 0; mask &= mask - 1)
+		{
+			const char* pCandidate = pCh + Math::CountTrailingZeros(mask);
+			if(memcmp(pCandidate, pSearch, searchSize) == 0)
+			{
+				return pCandidate;
+			}
+		}
+	}
+
+	return Scalar::FindString(pCh, pEnd, pSearch, searchSize);
+}
+
+static const char* FindLastString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	// One after the last position where the search string can start
+	const char* pCh = pEnd - searchSize + 1;
+
+	const __m128i first = _mm_set1_epi8(pSearch[0]);
+	const __m128i last = _mm_set1_epi8(pSearch[searchSize - 1]);
+	for(; pCh - pBegin >= kBlockSize; )
+	{
+		pCh -= kBlockSize;
+		const __m128i matchFirst = _mm_cmpeq_epi8(Load(pCh), first);
+		const __m128i matchLast = _mm_cmpeq_epi8(Load(pCh + searchSize - 1), last);
+		uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(matchFirst, matchLast)));
+		while(mask != 0)
+		{
+			const uint32_t idx = Math::FindLastSetBit(mask);
+			if(memcmp(pCh + idx, pSearch, searchSize) == 0)
+			{
+				return pCh + idx;
+			}
+
+			mask &= ~(1u << idx);
+		}
+	}
+
+	return Scalar::FindLastString(pBegin, pCh + searchSize - 1, pSearch, searchSize);
+}
+
+static int32_t Compare(const char* pA, const char* pB, size_t size)
+{
+	size_t i = 0;
+	for(; size - i >= static_cast<size_t>(kBlockSize); i += kBlockSize)
+	{
+		const uint32_t mismatchMask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Load(pA + i), Load(pB + i)))) & 0xFFFF;
+		if(mismatchMask != 0)
+		{
+			const size_t idx = i + Math::CountTrailingZeros(mismatchMask);
+			return static_cast<uint8_t>(pA[idx]) - static_cast<uint8_t>(pB[idx]);
+		}
+	}
+
+	return Scalar::Compare(pA + i, pB + i, size - i);
+}
+
+static size_t CountUTF8Chars(const char* pBegin, const char* pEnd)
+{
+	size_t count = 0;
+	const char* pCh = pBegin;
+
+	// The continuation bytes are in the range [0x80, 0xBF] which is [-128, -65] as signed values
+	const __m128i firstNonContinuation = _mm_set1_epi8(static_cast<char>(0xC0));
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const uint32_t continuationMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(Load(pCh), firstNonContinuation)));
+		count += kBlockSize - Math::CountSetBits(continuationMask);
+	}
+
+	return count + Scalar::CountUTF8Chars(pCh, pEnd);
+}
+
+static void ToLower(char* pBegin, char* pEnd)
+{
+	ChangeCase<true>(pBegin, pEnd, 'A', 'Z');
+}
+
+static void ToUpper(char* pBegin, char* pEnd)
+{
+	ChangeCase<false>(pBegin, pEnd, 'a', 'z');
+}
+
+static void ReplaceChar(char* pBegin, char* pEnd, char search, char replaceTo)
+{
+	char* pCh = pBegin;
+
+	const __m128i searchChars = _mm_set1_epi8(search);
+	const __m128i replaceToChars = _mm_set1_epi8(replaceTo);
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const __m128i chars = Load(pCh);
+		const __m128i isMatching = _mm_cmpeq_epi8(chars, searchChars);
+		Store(pCh, _mm_or_si128(_mm_andnot_si128(isMatching, chars), _mm_and_si128(isMatching, replaceToChars)));
+	}
+
+	Scalar::ReplaceChar(pCh, pEnd, search, replaceTo);
+}
+
+static const char* SkipWhitespaces(const char* pBegin, const char* pEnd)
+{
+	const char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const uint32_t nonWhitespaceMask = ~MatchWhitespaces(pCh) & 0xFFFF;
+		if(nonWhitespaceMask != 0)
+		{
+			return pCh + Math::CountTrailingZeros(nonWhitespaceMask);
+		}
+	}
+
+	return Scalar::SkipWhitespaces(pCh, pEnd);
+}
+
+static const char* SkipWhitespacesBackwards(const char* pBegin, const char* pEnd)
+{
+	const char* pCh = pEnd;
+	for(; pCh - pBegin >= kBlockSize; pCh -= kBlockSize)
+	{
+		const uint32_t nonWhitespaceMask = ~MatchWhitespaces(pCh - kBlockSize) & 0xFFFF;
+		if(nonWhitespaceMask != 0)
+		{
+			return pCh - kBlockSize + Math::FindLastSetBit(nonWhitespaceMask) + 1;
+		}
+	}
+
+	return Scalar::SkipWhitespacesBackwards(pBegin, pCh);
+}
+
+}	// end of namespace SSE2
+
+// --------------------------------------------------------------------------------------------------------------------
+//	SSE4.2
+//	The searches and the comparison use the string instructions (pcmpestri / pcmpestrm), the rest is the same as SSE2.
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace SSE42
+{
+
+static constexpr int kBlockSize = 16;
+static constexpr int kFindFirstFlags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT;
+static constexpr int kFindLastFlags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_MOST_SIGNIFICANT;
+// Sets a bit at every position where the search string starts, including the partial matches at the end of the block
+static constexpr int kFindStringFlags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED | _SIDD_BIT_MASK;
+static constexpr int kFindMismatchFlags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_EACH | _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
+
+// Loads the first (up to) 16 characters of the search string without reading outside of it
+static __m128i LoadSearchPrefix(const char* pSearch, int prefixSize)
+{
+	alignas(16) char prefix[kBlockSize] = {};
+	memcpy(prefix, pSearch, prefixSize);
+	return _mm_load_si128(reinterpret_cast<const __m128i*>(prefix));
+}
+
+DESIRE_TARGET_SSE42 static const char* FindChar(const char* pBegin, const char* pEnd, char ch)
+{
+	const __m128i search = _mm_cvtsi32_si128(static_cast<uint8_t>(ch));
+	const char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const int idx = _mm_cmpestri(search, 1, SSE2::Load(pCh), kBlockSize, kFindFirstFlags);
+		if(idx != kBlockSize)
+		{
+			return pCh + idx;
+		}
+	}
+
+	return Scalar::FindChar(pCh, pEnd, ch);
+}
+
+DESIRE_TARGET_SSE42 static const char* FindLastChar(const char* pBegin, const char* pEnd, char ch)
+{
+	const __m128i search = _mm_cvtsi32_si128(static_cast<uint8_t>(ch));
+	const char* pCh = pEnd;
+	for(; pCh - pBegin >= kBlockSize; )
+	{
+		pCh -= kBlockSize;
+		const int idx = _mm_cmpestri(search, 1, SSE2::Load(pCh), kBlockSize, kFindLastFlags);
+		if(idx != kBlockSize)
+		{
+			return pCh + idx;
+		}
+	}
+
+	return Scalar::FindLastChar(pBegin, pCh, ch);
+}
+
+// The candidates are found by the first (up to) 16 characters of the search string, the longer ones are verified with memcmp()
+DESIRE_TARGET_SSE42 static const char* FindString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	const int prefixSize = static_cast<int>(std::min<size_t>(searchSize, kBlockSize));
+	const __m128i prefix = LoadSearchPrefix(pSearch, prefixSize);
+
+	const char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		uint32_t mask = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_cmpestrm(prefix, prefixSize, SSE2::Load(pCh), kBlockSize, kFindStringFlags)));
+		for(; mask != 0; mask &= mask - 1)
+		{
+			const char* pCandidate = pCh + Math::CountTrailingZeros(mask);
+			if(static_cast<size_t>(pEnd - pCandidate) < searchSize)
+			{
+				// The later candidates don't fit either
+				return nullptr;
+			}
+
+			if(memcmp(pCandidate, pSearch, searchSize) == 0)
+			{
+				return pCandidate;
+			}
+		}
+	}
+
+	return Scalar::FindString(pCh, pEnd, pSearch, searchSize);
+}
+
+DESIRE_TARGET_SSE42 static const char* FindLastString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	const int prefixSize = static_cast<int>(std::min<size_t>(searchSize, kBlockSize));
+	const __m128i prefix = LoadSearchPrefix(pSearch, prefixSize);
+
+	// The candidates at and after 'pCh' are already checked
+	const char* pCh = pEnd;
+	for(; pCh - pBegin >= kBlockSize; )
+	{
+		pCh -= kBlockSize;
+		uint32_t mask = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_cmpestrm(prefix, prefixSize, SSE2::Load(pCh), kBlockSize, kFindStringFlags)));
+		while(mask != 0)
+		{
+			const uint32_t idx = Math::FindLastSetBit(mask);
+			if(static_cast<size_t>(pEnd - pCh) - idx >= searchSize && memcmp(pCh + idx, pSearch, searchSize) == 0)
+			{
+				return pCh + idx;
+			}
+
+			mask &= ~(1u << idx);
+		}
+	}
+
+	// Search in the remaining candidates which start before 'pCh'
+	const size_t numCheckedChars = std::min<size_t>(pEnd - pCh, searchSize - 1);
+	return Scalar::FindLastString(pBegin, pCh + numCheckedChars, pSearch, searchSize);
+}
+
+DESIRE_TARGET_SSE42 static int32_t Compare(const char* pA, const char* pB, size_t size)
+{
+	size_t i = 0;
+	for(; size - i >= static_cast<size_t>(kBlockSize); i += kBlockSize)
+	{
+		const int idx = _mm_cmpestri(SSE2::Load(pA + i), kBlockSize, SSE2::Load(pB + i), kBlockSize, kFindMismatchFlags);
+		if(idx != kBlockSize)
+		{
+			return static_cast<uint8_t>(pA[i + idx]) - static_cast<uint8_t>(pB[i + idx]);
+		}
+	}
+
+	return Scalar::Compare(pA + i, pB + i, size - i);
+}
+
+}	// end of namespace SSE42
+
+// --------------------------------------------------------------------------------------------------------------------
+//	AVX2
+//	Processes 32 characters at once and leaves the remaining ones to the SSE2 loops.
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace AVX2
+{
+
+static constexpr ptrdiff_t kBlockSize = 32;
+
+DESIRE_TARGET_AVX2 static __m256i Load(const char* pCh)
+{
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pCh));
+}
+
+DESIRE_TARGET_AVX2 static void Store(char* pCh, __m256i value)
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(pCh), value);
+}
+
+DESIRE_TARGET_AVX2 static uint32_t MatchChar(const char* pCh, __m256i ch)
+{
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Load(pCh), ch)));
+}
+
+DESIRE_TARGET_AVX2 static uint32_t MatchWhitespaces(const char* pCh)
+{
+	const __m256i chars = Load(pCh);
+	const __m256i isSpaceOrTab = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\t')));
+	const __m256i isNewLine = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('\r')));
+	return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(isSpaceOrTab, isNewLine)));
+}
+
+// Sets or clears the 6th bit of the letters in the range ['first', 'last']
+template<bool SET_BIT>
+DESIRE_TARGET_AVX2 static void ChangeCase(char* pBegin, char* pEnd, char first, char last)
+{
+	const __m256i rangeBegin = _mm256_set1_epi8(first - 1);
+	const __m256i rangeEnd = _mm256_set1_epi8(last + 1);
+	const __m256i caseBit = _mm256_set1_epi8(0b00100000);
+
+	char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		// The signed comparison excludes the non-ASCII characters as they are negative
+		const __m256i chars = Load(pCh);
+		const __m256i isInRange = _mm256_and_si256(_mm256_cmpgt_epi8(chars, rangeBegin), _mm256_cmpgt_epi8(rangeEnd, chars));
+		const __m256i bits = _mm256_and_si256(isInRange, caseBit);
+		Store(pCh, SET_BIT ? _mm256_or_si256(chars, bits) : _mm256_xor_si256(chars, bits));
+	}
+
+	SSE2::ChangeCase<SET_BIT>(pCh, pEnd, first, last);
+}
+
+DESIRE_TARGET_AVX2 static const char* FindChar(const char* pBegin, const char* pEnd, char ch)
+{
+	const __m256i search = _mm256_set1_epi8(ch);
+	const char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const uint32_t mask = MatchChar(pCh, search);
+		if(mask != 0)
+		{
+			return pCh + Math::CountTrailingZeros(mask);
+		}
+	}
+
+	return SSE2::FindChar(pCh, pEnd, ch);
+}
+
+DESIRE_TARGET_AVX2 static const char* FindLastChar(const char* pBegin, const char* pEnd, char ch)
+{
+	const __m256i search = _mm256_set1_epi8(ch);
+	const char* pCh = pEnd;
+	for(; pCh - pBegin >= kBlockSize; )
+	{
+		pCh -= kBlockSize;
+		const uint32_t mask = MatchChar(pCh, search);
+		if(mask != 0)
+		{
+			return pCh + Math::FindLastSetBit(mask);
+		}
+	}
+
+	return SSE2::FindLastChar(pBegin, pCh, ch);
+}
+
+DESIRE_TARGET_AVX2 static const char* FindString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	// The last position where the search string can start
+	const char* pLast = pEnd - searchSize;
+	const char* pCh = pBegin;
+
+	// Only compare the whole search string at the positions where both its first and last character match
+	const __m256i first = _mm256_set1_epi8(pSearch[0]);
+	const __m256i last = _mm256_set1_epi8(pSearch[searchSize - 1]);
+	for(; pLast - pCh >= kBlockSize - 1; pCh += kBlockSize)
+	{
+		const __m256i matchFirst = _mm256_cmpeq_epi8(Load(pCh), first);
+		const __m256i matchLast = _mm256_cmpeq_epi8(Load(pCh + searchSize - 1), last);
+		for(uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(matchFirst, matchLast))); mask != 0; mask &= mask - 1)
+		{
+			const char* pCandidate = pCh + Math::CountTrailingZeros(mask);
+			if(memcmp(pCandidate, pSearch, searchSize) == 0)
+			{
+				return pCandidate;
+			}
+		}
+	}
+
+	return SSE2::FindString(pCh, pEnd, pSearch, searchSize);
+}
+
+DESIRE_TARGET_AVX2 static const char* FindLastString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	// One after the last position where the search string can start
+	const char* pCh = pEnd - searchSize + 1;
+
+	const __m256i first = _mm256_set1_epi8(pSearch[0]);
+	const __m256i last = _mm256_set1_epi8(pSearch[searchSize - 1]);
+	for(; pCh - pBegin >= kBlockSize; )
+	{
+		pCh -= kBlockSize;
+		const __m256i matchFirst = _mm256_cmpeq_epi8(Load(pCh), first);
+		const __m256i matchLast = _mm256_cmpeq_epi8(Load(pCh + searchSize - 1), last);
+		uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(matchFirst, matchLast)));
+		while(mask != 0)
+		{
+			const uint32_t idx = Math::FindLastSetBit(mask);
+			if(memcmp(pCh + idx, pSearch, searchSize) == 0)
+			{
+				return pCh + idx;
+			}
+
+			mask &= ~(1u << idx);
+		}
+	}
+
+	return SSE2::FindLastString(pBegin, pCh + searchSize - 1, pSearch, searchSize);
+}
+
+DESIRE_TARGET_AVX2 static int32_t Compare(const char* pA, const char* pB, size_t size)
+{
+	size_t i = 0;
+	for(; size - i >= static_cast<size_t>(kBlockSize); i += kBlockSize)
+	{
+		const uint32_t mismatchMask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Load(pA + i), Load(pB + i))));
+		if(mismatchMask != 0)
+		{
+			const size_t idx = i + Math::CountTrailingZeros(mismatchMask);
+			return static_cast<uint8_t>(pA[idx]) - static_cast<uint8_t>(pB[idx]);
+		}
+	}
+
+	return SSE2::Compare(pA + i, pB + i, size - i);
+}
+
+DESIRE_TARGET_AVX2 static size_t CountUTF8Chars(const char* pBegin, const char* pEnd)
+{
+	size_t count = 0;
+	const char* pCh = pBegin;
+
+	// The continuation bytes are in the range [0x80, 0xBF] which is [-128, -65] as signed values
+	const __m256i firstNonContinuation = _mm256_set1_epi8(static_cast<char>(0xC0));
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const uint32_t continuationMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(firstNonContinuation, Load(pCh))));
+		count += kBlockSize - Math::CountSetBits(continuationMask);
+	}
+
+	return count + SSE2::CountUTF8Chars(pCh, pEnd);
+}
+
+static void ToLower(char* pBegin, char* pEnd)
+{
+	ChangeCase<true>(pBegin, pEnd, 'A', 'Z');
+}
+
+static void ToUpper(char* pBegin, char* pEnd)
+{
+	ChangeCase<false>(pBegin, pEnd, 'a', 'z');
+}
+
+DESIRE_TARGET_AVX2 static void ReplaceChar(char* pBegin, char* pEnd, char search, char replaceTo)
+{
+	char* pCh = pBegin;
+
+	const __m256i searchChars = _mm256_set1_epi8(search);
+	const __m256i replaceToChars = _mm256_set1_epi8(replaceTo);
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const __m256i chars = Load(pCh);
+		Store(pCh, _mm256_blendv_epi8(chars, replaceToChars, _mm256_cmpeq_epi8(chars, searchChars)));
+	}
+
+	SSE2::ReplaceChar(pCh, pEnd, search, replaceTo);
+}
+
+DESIRE_TARGET_AVX2 static const char* SkipWhitespaces(const char* pBegin, const char* pEnd)
+{
+	const char* pCh = pBegin;
+	for(; pEnd - pCh >= kBlockSize; pCh += kBlockSize)
+	{
+		const uint32_t nonWhitespaceMask = ~MatchWhitespaces(pCh);
+		if(nonWhitespaceMask != 0)
+		{
+			return pCh + Math::CountTrailingZeros(nonWhitespaceMask);
+		}
+	}
+
+	return SSE2::SkipWhitespaces(pCh, pEnd);
+}
+
+DESIRE_TARGET_AVX2 static const char* SkipWhitespacesBackwards(const char* pBegin, const char* pEnd)
+{
+	const char* pCh = pEnd;
+	for(; pCh - pBegin >= kBlockSize; pCh -= kBlockSize)
+	{
+		const uint32_t nonWhitespaceMask = ~MatchWhitespaces(pCh - kBlockSize);
+		if(nonWhitespaceMask != 0)
+		{
+			return pCh - kBlockSize + Math::FindLastSetBit(nonWhitespaceMask) + 1;
+		}
+	}
+
+	return SSE2::SkipWhitespacesBackwards(pBegin, pCh);
+}
+
+}	// end of namespace AVX2
+
+#endif	// #if DESIRE_USE_SSE
+
+// --------------------------------------------------------------------------------------------------------------------
+//	Dispatch
+// --------------------------------------------------------------------------------------------------------------------
+
+struct Functions
+{
+	EInstructionSet instructionSet;
+	const char* (*pFindChar)(const char*, const char*, char);
+	const char* (*pFindLastChar)(const char*, const char*, char);
+	const char* (*pFindString)(const char*, const char*, const char*, size_t);
+	const char* (*pFindLastString)(const char*, const char*, const char*, size_t);
+	int32_t (*pCompare)(const char*, const char*, size_t);
+	size_t (*pCountUTF8Chars)(const char*, const char*);
+	void (*pToLower)(char*, char*);
+	void (*pToUpper)(char*, char*);
+	void (*pReplaceChar)(char*, char*, char, char);
+	const char* (*pSkipWhitespaces)(const char*, const char*);
+	const char* (*pSkipWhitespacesBackwards)(const char*, const char*);
+};
+
+static const Functions kScalarFunctions =
+{
+	EInstructionSet::Scalar,
+	&Scalar::FindChar,
+	&Scalar::FindLastChar,
+	&Scalar::FindString,
+	&Scalar::FindLastString,
+	&Scalar::Compare,
+	&Scalar::CountUTF8Chars,
+	&Scalar::ToLower,
+	&Scalar::ToUpper,
+	&Scalar::ReplaceChar,
+	&Scalar::SkipWhitespaces,
+	&Scalar::SkipWhitespacesBackwards,
+};
+
+#if DESIRE_USE_SSE
+static const Functions kSSE2Functions =
+{
+	EInstructionSet::SSE2,
+	&SSE2::FindChar,
+	&SSE2::FindLastChar,
+	&SSE2::FindString,
+	&SSE2::FindLastString,
+	&SSE2::Compare,
+	&SSE2::CountUTF8Chars,
+	&SSE2::ToLower,
+	&SSE2::ToUpper,
+	&SSE2::ReplaceChar,
+	&SSE2::SkipWhitespaces,
+	&SSE2::SkipWhitespacesBackwards,
+};
+
+static const Functions kSSE42Functions =
+{
+	EInstructionSet::SSE42,
+	&SSE42::FindChar,
+	&SSE42::FindLastChar,
+	&SSE42::FindString,
+	&SSE42::FindLastString,
+	&SSE42::Compare,
+	&SSE2::CountUTF8Chars,
+	&SSE2::ToLower,
+	&SSE2::ToUpper,
+	&SSE2::ReplaceChar,
+	&SSE2::SkipWhitespaces,
+	&SSE2::SkipWhitespacesBackwards,
+};
+
+static const Functions kAVX2Functions =
+{
+	EInstructionSet::AVX2,
+	&AVX2::FindChar,
+	&AVX2::FindLastChar,
+	&AVX2::FindString,
+	&AVX2::FindLastString,
+	&AVX2::Compare,
+	&AVX2::CountUTF8Chars,
+	&AVX2::ToLower,
+	&AVX2::ToUpper,
+	&AVX2::ReplaceChar,
+	&AVX2::SkipWhitespaces,
+	&AVX2::SkipWhitespacesBackwards,
+};
+
+static void CpuId(uint32_t regs[4], uint32_t leaf, uint32_t subLeaf)
+{
+#if defined(_MSC_VER)
+	__cpuidex(reinterpret_cast<int*>(regs), static_cast<int>(leaf), static_cast<int>(subLeaf));
+#else
+	if(!__get_cpuid_count(leaf, subLeaf, &regs[0], &regs[1], &regs[2], &regs[3]))
+	{
+		regs[0] = regs[1] = regs[2] = regs[3] = 0;
+	}
+#endif
+}
+
+static uint64_t GetEnabledXSaveFeatures()
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif	// #if DESIRE_USE_SSE
+
+static EInstructionSet DetectInstructionSet()
+{
+#if DESIRE_USE_SSE
+	enum ERegister
+	{
+		EAX, EBX, ECX, EDX
+	};
+
+	uint32_t regs[4] = {};
+	CpuId(regs, 1, 0);
+	const bool isSSE42Supported = (regs[ECX] & (1u << 20)) != 0;
+	const bool isOSXSaveEnabled = (regs[ECX] & (1u << 27)) != 0;
+	const bool isAVXSupported = (regs[ECX] & (1u << 28)) != 0;
+
+	// The OS also has to save the YMM registers (XCR0 bits 1 and 2)
+	if(isAVXSupported && isOSXSaveEnabled && (GetEnabledXSaveFeatures() & 0b110) == 0b110)
+	{
+		CpuId(regs, 0, 0);
+		if(regs[EAX] >= 7)
+		{
+			CpuId(regs, 7, 0);
+			if(regs[EBX] & (1u << 5))
+			{
+				return EInstructionSet::AVX2;
+			}
+		}
+	}
+
+	return isSSE42Supported ? EInstructionSet::SSE42 : EInstructionSet::SSE2;
+#else
+	return EInstructionSet::Scalar;
+#endif
+}
+
+static const Functions& GetFunctionsFor(EInstructionSet instructionSet)
+{
+	switch(instructionSet)
+	{
+#if DESIRE_USE_SSE
+		case EInstructionSet::SSE2:		return kSSE2Functions;
+		case EInstructionSet::SSE42:	return kSSE42Functions;
+		case EInstructionSet::AVX2:		return kAVX2Functions;
+#endif
+		default:						return kScalarFunctions;
+	}
+}
+
+// The SSE4.2 string instructions have a high latency and the SSE2 loops are faster (see the StringSIMD benchmark),
+// so that implementation is only used when it is selected explicitly
+static EInstructionSet GetDefaultInstructionSet()
+{
+	const EInstructionSet instructionSet = GetSupportedInstructionSet();
+	return (instructionSet == EInstructionSet::SSE42) ? EInstructionSet::SSE2 : instructionSet;
+}
+
+// The tables are constant initialized, so the pointer can be set lazily from any thread
+static std::atomic<const Functions*> s_pFunctions = nullptr;
+
+static const Functions& GetFunctions()
+{
+	const Functions* pFunctions = s_pFunctions.load(std::memory_order_relaxed);
+	if(pFunctions == nullptr)
+	{
+		pFunctions = &GetFunctionsFor(GetDefaultInstructionSet());
+		s_pFunctions.store(pFunctions, std::memory_order_relaxed);
+	}
+
+	return *pFunctions;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//	StringSIMD
+// --------------------------------------------------------------------------------------------------------------------
+
+const char* FindChar(const char* pBegin, const char* pEnd, char ch)
+{
+	return GetFunctions().pFindChar(pBegin, pEnd, ch);
+}
+
+const char* FindLastChar(const char* pBegin, const char* pEnd, char ch)
+{
+	return GetFunctions().pFindLastChar(pBegin, pEnd, ch);
+}
+
+const char* FindString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	ASSERT(searchSize > 0);
+
+	if(static_cast<size_t>(pEnd - pBegin) < searchSize)
+	{
+		return nullptr;
+	}
+
+	return GetFunctions().pFindString(pBegin, pEnd, pSearch, searchSize);
+}
+
+const char* FindLastString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize)
+{
+	ASSERT(searchSize > 0);
+
+	if(static_cast<size_t>(pEnd - pBegin) < searchSize)
+	{
+		return nullptr;
+	}
+
+	return GetFunctions().pFindLastString(pBegin, pEnd, pSearch, searchSize);
+}
+
+int32_t Compare(const char* pA, const char* pB, size_t size)
+{
+	return GetFunctions().pCompare(pA, pB, size);
+}
+
+size_t CountUTF8Chars(const char* pBegin, const char* pEnd)
+{
+	return GetFunctions().pCountUTF8Chars(pBegin, pEnd);
+}
+
+void ToLower(char* pBegin, char* pEnd)
+{
+	GetFunctions().pToLower(pBegin, pEnd);
+}
+
+void ToUpper(char* pBegin, char* pEnd)
+{
+	GetFunctions().pToUpper(pBegin, pEnd);
+}
+
+void ReplaceChar(char* pBegin, char* pEnd, char search, char replaceTo)
+{
+	GetFunctions().pReplaceChar(pBegin, pEnd, search, replaceTo);
+}
+
+const char* SkipWhitespaces(const char* pBegin, const char* pEnd)
+{
+	return GetFunctions().pSkipWhitespaces(pBegin, pEnd);
+}
+
+const char* SkipWhitespacesBackwards(const char* pBegin, const char* pEnd)
+{
+	return GetFunctions().pSkipWhitespacesBackwards(pBegin, pEnd);
+}
+
+EInstructionSet GetSupportedInstructionSet()
+{
+	static const EInstructionSet s_supportedInstructionSet = DetectInstructionSet();
+	return s_supportedInstructionSet;
+}
+
+EInstructionSet GetInstructionSet()
+{
+	return GetFunctions().instructionSet;
+}
+
+void SetInstructionSet(EInstructionSet instructionSet)
+{
+	ASSERT(instructionSet <= GetSupportedInstructionSet());
+	s_pFunctions.store(&GetFunctionsFor(instructionSet), std::memory_order_relaxed);
+}
+
+}	// end of namespace StringSIMD
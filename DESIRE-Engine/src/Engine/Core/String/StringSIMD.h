@@ -0,0 +1,55 @@
+#pragma once
+
+// --------------------------------------------------------------------------------------------------------------------
+//	SIMD implementations of the character processing loops of String and WritableString.
+//	The functions work on the [pBegin, pEnd) range and never read outside of it. When DESIRE_USE_SSE is enabled the
+//	implementation is selected at the first call based on the CPU: AVX2 processes 32 characters at once, otherwise
+//	SSE2 processes 16 characters at once. The SSE4.2 implementation uses the string comparison instructions for the
+//	searches, it can be selected with SetInstructionSet(). Without SSE the scalar loops are used.
+// --------------------------------------------------------------------------------------------------------------------
+
+namespace StringSIMD
+{
+
+enum class EInstructionSet
+{
+	Scalar,
+	SSE2,
+	SSE42,
+	AVX2
+};
+
+// Returns the first / last occurrence of 'ch' or nullptr if it is not found
+const char* FindChar(const char* pBegin, const char* pEnd, char ch);
+const char* FindLastChar(const char* pBegin, const char* pEnd, char ch);
+
+// Returns the first / last occurrence of 'pSearch' or nullptr if it is not found ('searchSize' has to be greater than 0)
+const char* FindString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize);
+const char* FindLastString(const char* pBegin, const char* pEnd, const char* pSearch, size_t searchSize);
+
+// Compares 'size' characters with the same sign convention as memcmp()
+int32_t Compare(const char* pA, const char* pB, size_t size);
+
+// Returns the number of UTF8 characters (the bytes which are not continuation bytes)
+size_t CountUTF8Chars(const char* pBegin, const char* pEnd);
+
+// Converts the ASCII letters in place
+void ToLower(char* pBegin, char* pEnd);
+void ToUpper(char* pBegin, char* pEnd);
+
+// Replaces all occurrences of 'search' with 'replaceTo' in place
+void ReplaceChar(char* pBegin, char* pEnd, char search, char replaceTo);
+
+// Returns the first character which is not a whitespace, or pEnd if there is none
+const char* SkipWhitespaces(const char* pBegin, const char* pEnd);
+// Returns the position after the last character which is not a whitespace, or pBegin if there is none
+const char* SkipWhitespacesBackwards(const char* pBegin, const char* pEnd);
+
+// Returns the best instruction set which is supported by the CPU
+EInstructionSet GetSupportedInstructionSet();
+// Returns the instruction set of the implementation used by the functions
+EInstructionSet GetInstructionSet();
+// Overrides the implementation used by the functions (for testing and benchmarking), it has to be supported by the CPU
+void SetInstructionSet(EInstructionSet instructionSet);
+
+}	// end of namespace StringSIMD
@@ -1,7 +1,20 @@
 #include "Engine/stdafx.h"
 #include "Engine/Core/String/WritableString.h"
 
-#include <cinttypes>
+#include "Engine/Core/String/StringSIMD.h"
+
+#include <charconv>		// std::to_chars()
+
+// Converts the number with std::to_chars() which doesn't allocate and doesn't depend on the locale like snprintf()
+template<size_t MAX_LENGTH, typename T, typename... Args>
+static void AppendNumber(WritableString& string, T number, Args... args)
+{
+	char str[MAX_LENGTH + 1];
+	const std::to_chars_result result = std::to_chars(str, str + MAX_LENGTH, number, args...);
+	ASSERT(result.ec == std::errc());
+	*result.ptr = '\0';
+	string.Append(String(str, result.ptr - str));
+}
 
 void WritableString::Clear()
 {
@@ -130,11 +143,7 @@ void WritableString::ReplaceAllChar(char search, char replaceTo)
 		return;
 	}
 
-	do
-	{
-		m_pData[foundPos] = replaceTo;
-		foundPos = Find(search, foundPos + 1);
-	} while(foundPos != kInvalidPos);
+	StringSIMD::ReplaceChar(m_pData + foundPos, m_pData + m_size, search, replaceTo);
 }
 
 void WritableString::Append(const String& string)
@@ -166,67 +175,39 @@ void WritableString::AppendChar(char ch)
 
 WritableString& WritableString::operator +=(int32_t number)
 {
-	char str[10 + 2];
-	const int32_t len = snprintf(str, sizeof(str), "%" PRIi32, number);
-	if(len > 0)
-	{
-		Append(String(str, len));
-	}
+	AppendNumber<10 + 1>(*this, number);
 	return *this;
 }
 
 WritableString& WritableString::operator +=(uint32_t number)
 {
-	char str[10 + 2];
-	const int32_t len = snprintf(str, sizeof(str), "%" PRIu32, number);
-	if(len > 0)
-	{
-		Append(String(str, len));
-	}
+	AppendNumber<10>(*this, number);
 	return *this;
 }
 
 WritableString& WritableString::operator +=(int64_t number)
 {
-	char str[20 + 2];
-	const int32_t len = snprintf(str, sizeof(str), "%" PRIi64, number);
-	if(len > 0)
-	{
-		Append(String(str, len));
-	}
+	AppendNumber<20 + 1>(*this, number);
 	return *this;
 }
 
 WritableString& WritableString::operator +=(uint64_t number)
 {
-	char str[20 + 2];
-	const int32_t len = snprintf(str, sizeof(str), "%" PRIu64, number);
-	if(len > 0)
-	{
-		Append(String(str, len));
-	}
+	AppendNumber<20>(*this, number);
 	return *this;
 }
 
 WritableString& WritableString::operator +=(float number)
 {
-	char str[32];
-	const int32_t len = snprintf(str, sizeof(str), "%.3f", number);
-	if(len > 0)
-	{
-		Append(String(str, len));
-	}
+	// Sign + 39 digits of FLT_MAX + decimal point + 3 decimals
+	AppendNumber<1 + 39 + 1 + 3>(*this, number, std::chars_format::fixed, 3);
 	return *this;
 }
 
 WritableString& WritableString::operator +=(double number)
 {
-	char str[32];
-	const int32_t len = snprintf(str, sizeof(str), "%.3f", number);
-	if(len > 0)
-	{
-		Append(String(str, len));
-	}
+	// Sign + 309 digits of DBL_MAX + decimal point + 3 decimals
+	AppendNumber<1 + 309 + 1 + 3>(*this, number, std::chars_format::fixed, 3);
 	return *this;
 }
 
@@ -260,25 +241,12 @@ void WritableString::Set(const char* pStr, size_t numChars)
 
 void WritableString::Trim()
 {
-	auto IsWhiteSpace = [](char c)
-	{
-		return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
-	};
-
 	// Remove from end
-	while(m_size > 0 && IsWhiteSpace(m_pData[m_size - 1]))
-	{
-		m_size--;
-	}
+	m_size = StringSIMD::SkipWhitespacesBackwards(m_pData, m_pData + m_size) - m_pData;
 	m_pData[m_size] = '\0';
 
 	// Remove from beginning
-	char* pCh = m_pData;
-	while(*pCh != '\0' && IsWhiteSpace(*pCh))
-	{
-		++pCh;
-	}
-
+	const char* pCh = StringSIMD::SkipWhitespaces(m_pData, m_pData + m_size);
 	if(pCh != m_pData)
 	{
 		m_size -= pCh - m_pData;
@@ -288,34 +256,12 @@ void WritableString::Trim()
 
 void WritableString::ToLower()
 {
-	char* pCh = m_pData;
-	while(*pCh != '\0')
-	{
-		constexpr uint32_t rangeBegin = 'A';
-		constexpr uint32_t rangeSize = 'Z' - 'A';
-		if(static_cast<uint32_t>(*pCh) - rangeBegin <= rangeSize)
-		{
-			*pCh |= 0b00100000;	// Add 32 by setting the 6th bit
-		}
-
-		pCh++;
-	}
+	StringSIMD::ToLower(m_pData, m_pData + m_size);
 }
 
 void WritableString::ToUpper()
 {
-	char* pCh = m_pData;
-	while(*pCh != '\0')
-	{
-		constexpr uint32_t rangeBegin = 'a';
-		constexpr uint32_t rangeSize = 'z' - 'a';
-		if(static_cast<uint32_t>(*pCh) - rangeBegin <= rangeSize)
-		{
-			*pCh &= 0b11011111;	// Subtract 32 by clearing the 6th bit
-		}
-
-		pCh++;
-	}
+	StringSIMD::ToUpper(m_pData, m_pData + m_size);
 }
 
 char* WritableString::AsCharBufferWithSize(size_t newSize)
@@ -78,15 +78,20 @@
 // The value of this macro represents the maximum length of a file name string
 #define DESIRE_MAX_PATH_LEN					512
 
+// The size of a cache line in bytes (data written by different threads should be placed on separate cache lines)
+#define DESIRE_CACHE_LINE_SIZE				64
+
 // --------------------------------------------------------------------------------------------------------------------
 
 #if defined(_MSC_VER)
 	#define DESIRE_ATTRIBUTE_PACKED
+	#define DESIRE_NO_INLINE				__declspec(noinline)
 	#define DESIRE_PRAGMA(X)				__pragma(X)
 	#define DESIRE_DISABLE_WARNINGS			DESIRE_PRAGMA(warning(push, 1))
 	#define DESIRE_ENABLE_WARNINGS			DESIRE_PRAGMA(warning(pop))
 #else
 	#define DESIRE_ATTRIBUTE_PACKED			__attribute__((packed))
+	#define DESIRE_NO_INLINE				__attribute__((noinline))
 	#define DESIRE_PRAGMA(X)				_Pragma(#X)
 	#define DESIRE_DISABLE_WARNINGS
 	#define DESIRE_ENABLE_WARNINGS
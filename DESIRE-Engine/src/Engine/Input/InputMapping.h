@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/InlineArray.h"
 
 class InputDevice;
 
@@ -39,8 +40,8 @@ private:
 	struct UserAction
 	{
 		int32_t id;
-		Array<MappedInput> mappedButtons;
-		Array<MappedAxis> mappedAxes;
+		InlineArray<MappedInput, 2> mappedButtons;
+		InlineArray<MappedAxis, 2> mappedAxes;
 
 		UserAction(int32_t userActionId)
 			: id(userActionId)
@@ -2,6 +2,7 @@
 #include "Engine/Modules.h"
 
 #include "Engine/Application/Application.h"
+#include "Engine/Core/Job/JobSystem.h"
 #include "Engine/Input/Input.h"
 #include "Engine/Physics/Physics.h"
 #include "Engine/Render/Render.h"
@@ -11,6 +12,7 @@
 
 std::unique_ptr<Application> Modules::Application;
 std::unique_ptr<Input> Modules::Input;
+std::unique_ptr<JobSystem> Modules::JobSystem;
 std::unique_ptr<Physics> Modules::Physics;
 std::unique_ptr<Render> Modules::Render;
 std::unique_ptr<ScriptSystem> Modules::ScriptSystem;
@@ -2,6 +2,7 @@
 
 class Application;
 class Input;
+class JobSystem;
 class Physics;
 class Render;
 class ScriptSystem;
@@ -12,6 +13,7 @@ struct Modules
 {
 	static std::unique_ptr<Application> Application;
 	static std::unique_ptr<Input> Input;
+	static std::unique_ptr<JobSystem> JobSystem;
 	static std::unique_ptr<Physics> Physics;
 	static std::unique_ptr<Render> Render;
 	static std::unique_ptr<ScriptSystem> ScriptSystem;
@@ -20,14 +20,14 @@ Physics::~Physics()
 {
 }
 
-void Physics::OnPhysicsComponentCreated(PhysicsComponent* pPhysicsComponent)
+SlotMap<PhysicsComponent*>::Handle Physics::OnPhysicsComponentCreated(PhysicsComponent* pPhysicsComponent)
 {
-	m_components.Add(pPhysicsComponent);
+	return m_components.Add(pPhysicsComponent);
 }
 
-void Physics::OnPhysicsComponentDestroyed(PhysicsComponent* pPhysicsComponent)
+void Physics::OnPhysicsComponentDestroyed(SlotMap<PhysicsComponent*>::Handle handle)
 {
-	m_components.RemoveFast(pPhysicsComponent);
+	m_components.Remove(handle);
 }
 
 void Physics::SetFixedStepTime(float stepTime)
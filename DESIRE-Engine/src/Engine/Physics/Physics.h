@@ -2,6 +2,7 @@
 
 #include "Engine/Physics/Collision.h"
 #include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/SlotMap.h"
 
 class Object;
 class PhysicsComponent;
@@ -37,8 +38,8 @@ public:
 
 	virtual PhysicsComponent& CreatePhysicsComponentOnObject(Object& object) = 0;
 
-	void OnPhysicsComponentCreated(PhysicsComponent* pPhysicsComponent);
-	void OnPhysicsComponentDestroyed(PhysicsComponent* pPhysicsComponent);
+	SlotMap<PhysicsComponent*>::Handle OnPhysicsComponentCreated(PhysicsComponent* pPhysicsComponent);
+	void OnPhysicsComponentDestroyed(SlotMap<PhysicsComponent*>::Handle handle);
 
 	void SetFixedStepTime(float stepTime);
 	float GetFixedStepTime() const;
@@ -56,7 +57,7 @@ public:
 protected:
 	void UpdateComponents();
 
-	Array<PhysicsComponent*> m_components;
+	SlotMap<PhysicsComponent*> m_components;
 	int m_collisionMasks[(size_t)EPhysicsCollisionLayer::Num];
 	float m_fixedStepTime = 1.0f / 60.0f;
 };
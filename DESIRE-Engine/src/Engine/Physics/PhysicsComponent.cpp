@@ -8,12 +8,12 @@ PhysicsComponent::PhysicsComponent(Object& object)
 	: Component(object)
 	, m_collisionLayer(EPhysicsCollisionLayer::Default)
 {
-	Modules::Physics->OnPhysicsComponentCreated(this);
+	m_handle = Modules::Physics->OnPhysicsComponentCreated(this);
 }
 
 PhysicsComponent::~PhysicsComponent()
 {
-	Modules::Physics->OnPhysicsComponentDestroyed(this);
+	Modules::Physics->OnPhysicsComponentDestroyed(m_handle);
 }
 
 void PhysicsComponent::CloneTo(Object& otherObject) const
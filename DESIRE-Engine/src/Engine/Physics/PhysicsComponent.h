@@ -2,6 +2,7 @@
 
 #include "Engine/Core/Component.h"
 #include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/SlotMap.h"
 #include "Engine/Core/Math/Vector3.h"
 
 #include "Engine/Physics/PhysicsMaterial.h"
@@ -92,4 +93,7 @@ protected:
 	EPhysicsCollisionLayer m_collisionLayer;
 	PhysicsMaterial m_physicsMaterial;
 	std::unique_ptr<ColliderShape> m_spShape;
+
+private:
+	SlotMap<PhysicsComponent*>::Handle m_handle;
 };
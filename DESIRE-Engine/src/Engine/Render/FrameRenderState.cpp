@@ -0,0 +1,70 @@
+#include "Engine/stdafx.h"
+#include "Engine/Render/FrameRenderState.h"
+
+#include "Engine/Render/Camera.h"
+#include "Engine/Render/Render.h"
+
+FrameRenderState::FrameRenderState()
+{
+}
+
+FrameRenderState::~FrameRenderState()
+{
+}
+
+void FrameRenderState::Clear()
+{
+	m_viewMatrix = Matrix4::Identity();
+	m_projMatrix = Matrix4::Identity();
+	m_renderItems.Clear();
+	m_isCameraSet = false;
+}
+
+bool FrameRenderState::IsEmpty() const
+{
+	return (!m_isCameraSet && m_renderItems.IsEmpty());
+}
+
+void FrameRenderState::SetCamera(const Camera& camera)
+{
+	SetCamera(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+}
+
+void FrameRenderState::SetCamera(const Matrix4& viewMatrix, const Matrix4& projMatrix)
+{
+	m_viewMatrix = viewMatrix;
+	m_projMatrix = projMatrix;
+	m_isCameraSet = true;
+}
+
+void FrameRenderState::AddRenderable(const std::shared_ptr<Renderable>& spRenderable, const Matrix4& worldMatrix)
+{
+	ASSERT(spRenderable != nullptr);
+	m_renderItems.Add({ worldMatrix, spRenderable });
+}
+
+const Matrix4& FrameRenderState::GetViewMatrix() const
+{
+	return m_viewMatrix;
+}
+
+const Matrix4& FrameRenderState::GetProjectionMatrix() const
+{
+	return m_projMatrix;
+}
+
+const Array<FrameRenderState::RenderItem>& FrameRenderState::GetRenderItems() const
+{
+	return m_renderItems;
+}
+
+void FrameRenderState::Submit(Render& render) const
+{
+	render.SetViewProjectionMatrices(m_viewMatrix, m_projMatrix);
+
+	for(const RenderItem& renderItem : m_renderItems)
+	{
+		render.SetWorldMatrix(renderItem.worldMatrix);
+		render.RenderRenderable(*renderItem.spRenderable);
+	}
+}
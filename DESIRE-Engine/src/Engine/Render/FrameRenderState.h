@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Math/Matrix4.h"
+
+class Camera;
+class Render;
+class Renderable;
+
+// --------------------------------------------------------------------------------------------------------------------
+//	FrameRenderState holds a copy of everything needed to render a frame (camera matrices and the visible renderables
+//	with their world matrices), so the rendering of a frame can overlap with the simulation of the next one.
+//	The renderables are kept alive until the state is cleared, even if the simulation has already released them.
+// --------------------------------------------------------------------------------------------------------------------
+
+class FrameRenderState
+{
+public:
+	struct RenderItem
+	{
+		Matrix4 worldMatrix;
+		std::shared_ptr<Renderable> spRenderable;
+	};
+
+	FrameRenderState();
+	~FrameRenderState();
+
+	// Removes everything, but keeps the allocated memory for the next frame
+	// This releases the renderables, so in pipelined mode it is called on the render thread
+	void Clear();
+
+	// Returns true if nothing was extracted
+	bool IsEmpty() const;
+
+	void SetCamera(const Camera& camera);
+	void SetCamera(const Matrix4& viewMatrix, const Matrix4& projMatrix);
+	void AddRenderable(const std::shared_ptr<Renderable>& spRenderable, const Matrix4& worldMatrix);
+
+	const Matrix4& GetViewMatrix() const;
+	const Matrix4& GetProjectionMatrix() const;
+	const Array<RenderItem>& GetRenderItems() const;
+
+	// Render all the extracted renderables with the extracted camera
+	void Submit(Render& render) const;
+
+private:
+	Matrix4 m_viewMatrix = Matrix4::Identity();
+	Matrix4 m_projMatrix = Matrix4::Identity();
+	Array<RenderItem> m_renderItems;
+	bool m_isCameraSet = false;
+};
@@ -51,7 +51,7 @@ void Material::ChangeTexture(uint8_t idx, const std::shared_ptr<Texture>& spText
 	m_textures[idx].spTexture = spTexture;
 }
 
-const Array<Material::TextureInfo>& Material::GetTextures() const
+const InlineArray<Material::TextureInfo, 4>& Material::GetTextures() const
 {
 	return m_textures;
 }
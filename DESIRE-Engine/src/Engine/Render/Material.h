@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Container/InlineArray.h"
 #include "Engine/Core/String/HashedString.h"
 
 #include "Engine/Render/RenderEnums.h"
@@ -36,7 +37,7 @@ public:
 
 	void AddTexture(const std::shared_ptr<Texture>& spTexture, EFilterMode filterMode = EFilterMode::Trilinear, EAddressMode addressMode = EAddressMode::Repeat);
 	void ChangeTexture(uint8_t idx, const std::shared_ptr<Texture>& spTexture);
-	const Array<TextureInfo>& GetTextures() const;
+	const InlineArray<TextureInfo, 4>& GetTextures() const;
 
 	void AddShaderParam(HashedString name, const void* pParam);
 	void AddShaderParam(HashedString name, std::function<void(float*)>&& func);
@@ -63,6 +64,6 @@ public:
 	bool m_isDepthWriteEnabled = true;
 
 private:
-	Array<TextureInfo> m_textures;
+	InlineArray<TextureInfo, 4> m_textures;
 	Array<ShaderParam> m_shaderParams;
 };
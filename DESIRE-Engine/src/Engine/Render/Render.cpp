@@ -13,6 +13,7 @@
 #include "Engine/Render/VertexBuffer.h"
 
 Render::Render()
+	: m_ownerThreadId(std::this_thread::get_id())
 {
 }
 
@@ -22,6 +23,8 @@ Render::~Render()
 
 void Render::BeginFrame(OSWindow& window)
 {
+	ExecuteDeferredCommands();
+
 	m_pActiveWindow = &window;
 
 	SetRenderTarget(nullptr);
@@ -174,71 +177,71 @@ void Render::SetActiveRenderTarget(RenderTarget* pRenderTarget)
 	}
 }
 
-void Render::Unbind(Renderable& renderable)
+void Render::SetOwnerThread(std::thread::id threadId)
 {
-	if(renderable.m_pRenderData == nullptr)
+	m_ownerThreadId = threadId;
+}
+
+bool Render::IsOwnerThread() const
+{
+	return (std::this_thread::get_id() == m_ownerThreadId);
+}
+
+void Render::RunOnOwnerThread(std::function<void()> func)
+{
+	if(IsOwnerThread())
 	{
+		func();
 		return;
 	}
 
-	OnDestroyRenderableRenderData(renderable.m_pRenderData);
-	delete renderable.m_pRenderData;
-	renderable.m_pRenderData = nullptr;
+	DESIRE_SCOPED_SPINLOCK(m_deferredCommandsSpinLock);
+	m_deferredCommands.Add(std::move(func));
 }
 
-void Render::Unbind(IndexBuffer& indexBuffer)
+void Render::ExecuteDeferredCommands()
 {
-	if(indexBuffer.m_pRenderData == nullptr)
+	ASSERT(IsOwnerThread());
+
+	Array<std::function<void()>> commands;
 	{
-		return;
+		DESIRE_SCOPED_SPINLOCK(m_deferredCommandsSpinLock);
+		commands.Swap(m_deferredCommands);
 	}
 
-	if(m_pActiveIndexBuffer == &indexBuffer)
+	for(const std::function<void()>& func : commands)
 	{
-		m_pActiveIndexBuffer = nullptr;
+		func();
 	}
+}
+
+void Render::Unbind(Renderable& renderable)
+{
+	ReleaseRenderData(renderable.m_pRenderData, &renderable, ERenderDataType::Renderable);
+	renderable.m_pRenderData = nullptr;
+}
 
-	delete indexBuffer.m_pRenderData;
+void Render::Unbind(IndexBuffer& indexBuffer)
+{
+	ReleaseRenderData(indexBuffer.m_pRenderData, &indexBuffer, ERenderDataType::IndexBuffer);
 	indexBuffer.m_pRenderData = nullptr;
 }
 
 void Render::Unbind(VertexBuffer& vertexBuffer)
 {
-	if(vertexBuffer.m_pRenderData == nullptr)
-	{
-		return;
-	}
-
-	if(m_pActiveVertexBuffer == &vertexBuffer)
-	{
-		m_pActiveVertexBuffer = nullptr;
-	}
-
-	delete vertexBuffer.m_pRenderData;
+	ReleaseRenderData(vertexBuffer.m_pRenderData, &vertexBuffer, ERenderDataType::VertexBuffer);
 	vertexBuffer.m_pRenderData = nullptr;
 }
 
 void Render::Unbind(Shader& shader)
 {
-	if(shader.m_pRenderData == nullptr)
-	{
-		return;
-	}
-
-	OnDestroyShaderRenderData(shader.m_pRenderData);
-	delete shader.m_pRenderData;
+	ReleaseRenderData(shader.m_pRenderData, &shader, ERenderDataType::Shader);
 	shader.m_pRenderData = nullptr;
 }
 
 void Render::Unbind(Texture& texture)
 {
-	if(texture.m_pRenderData == nullptr)
-	{
-		return;
-	}
-
-	OnDestroyTextureRenderData(texture.m_pRenderData);
-	delete texture.m_pRenderData;
+	ReleaseRenderData(texture.m_pRenderData, &texture, ERenderDataType::Texture);
 	texture.m_pRenderData = nullptr;
 }
 
@@ -249,18 +252,67 @@ void Render::Unbind(RenderTarget& renderTarget)
 		return;
 	}
 
-	if(m_pActiveRenderTarget == &renderTarget)
-	{
-		m_pActiveRenderTarget = nullptr;
-	}
-
 	const uint8_t textureCount = renderTarget.GetTextureCount();
 	for(uint8_t i = 0; i < textureCount; ++i)
 	{
 		Unbind(*renderTarget.GetTexture(i));
 	}
 
-	OnDestroyRenderTargetRenderData(renderTarget.m_pRenderData);
-	delete renderTarget.m_pRenderData;
+	ReleaseRenderData(renderTarget.m_pRenderData, &renderTarget, ERenderDataType::RenderTarget);
 	renderTarget.m_pRenderData = nullptr;
 }
+
+void Render::ReleaseRenderData(RenderData* pRenderData, const void* pResource, ERenderDataType type)
+{
+	if(pRenderData == nullptr)
+	{
+		return;
+	}
+
+	RunOnOwnerThread([this, pRenderData, pResource, type]()
+	{
+		DestroyRenderData(pRenderData, pResource, type);
+	});
+}
+
+void Render::DestroyRenderData(RenderData* pRenderData, const void* pResource, ERenderDataType type)
+{
+	switch(type)
+	{
+		case ERenderDataType::Renderable:
+			OnDestroyRenderableRenderData(pRenderData);
+			break;
+
+		case ERenderDataType::IndexBuffer:
+			if(m_pActiveIndexBuffer == pResource)
+			{
+				m_pActiveIndexBuffer = nullptr;
+			}
+			break;
+
+		case ERenderDataType::VertexBuffer:
+			if(m_pActiveVertexBuffer == pResource)
+			{
+				m_pActiveVertexBuffer = nullptr;
+			}
+			break;
+
+		case ERenderDataType::Shader:
+			OnDestroyShaderRenderData(pRenderData);
+			break;
+
+		case ERenderDataType::Texture:
+			OnDestroyTextureRenderData(pRenderData);
+			break;
+
+		case ERenderDataType::RenderTarget:
+			if(m_pActiveRenderTarget == pResource)
+			{
+				m_pActiveRenderTarget = nullptr;
+			}
+			OnDestroyRenderTargetRenderData(pRenderData);
+			break;
+	}
+
+	delete pRenderData;
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/SpinLock.h"
+
 class DeviceBuffer;
 class IndexBuffer;
 class Material;
@@ -27,9 +30,18 @@ public:
 
 	virtual void AppendShaderFilenameWithPath(WritableString& outString, const String& shaderFilename) const = 0;
 
+	// Also executes the commands which were deferred from other threads since the previous frame
 	void BeginFrame(OSWindow& window);
 	virtual void EndFrame() = 0;
 
+	// The device is only used from the owner thread (the creator by default, or the render thread in pipelined mode)
+	void SetOwnerThread(std::thread::id threadId);
+	bool IsOwnerThread() const;
+
+	// Executes the function right away on the owner thread, otherwise it is deferred until the next BeginFrame() there
+	void RunOnOwnerThread(std::function<void()> func);
+	void ExecuteDeferredCommands();
+
 	void RenderRenderable(Renderable& renderable, uint32_t indexOffset = 0, uint32_t vertexOffset = 0, uint32_t numIndices = UINT32_MAX, uint32_t numVertices = UINT32_MAX);
 
 	void SetActiveRenderTarget(RenderTarget* pRenderTarget);
@@ -38,7 +50,7 @@ public:
 	virtual void SetWorldMatrix(const Matrix4& worldMatrix) = 0;
 	virtual void SetViewProjectionMatrices(const Matrix4& viewMatrix, const Matrix4& projMatrix) = 0;
 
-	// Resource unbind
+	// Resource unbind (releasing the render data is deferred to the owner thread, so these can be called from any thread)
 	void Unbind(Renderable& renderable);
 	void Unbind(IndexBuffer& indexBuffer);
 	void Unbind(VertexBuffer& vertexBuffer);
@@ -55,6 +67,24 @@ protected:
 	const RenderTarget* m_pActiveRenderTarget = nullptr;
 
 private:
+	enum class ERenderDataType : uint8_t
+	{
+		Renderable,
+		IndexBuffer,
+		VertexBuffer,
+		Shader,
+		Texture,
+		RenderTarget
+	};
+
+	// The resource is only used to reset the active bindings, it might be destroyed by the time the render data is released
+	void ReleaseRenderData(RenderData* pRenderData, const void* pResource, ERenderDataType type);
+	void DestroyRenderData(RenderData* pRenderData, const void* pResource, ERenderDataType type);
+
+	std::thread::id m_ownerThreadId;
+	Array<std::function<void()>> m_deferredCommands;
+	SpinLock m_deferredCommandsSpinLock;
+
 	virtual RenderData* CreateRenderableRenderData(const Renderable& renderable) = 0;
 	virtual RenderData* CreateIndexBufferRenderData(const IndexBuffer& indexBuffer) = 0;
 	virtual RenderData* CreateVertexBufferRenderData(const VertexBuffer& vertexBuffer) = 0;
@@ -2,8 +2,11 @@
 #include "Engine/Render/RenderComponent.h"
 
 #include "Engine/Core/Math/AABB.h"
+#include "Engine/Core/Math/Transform.h"
 #include "Engine/Core/Object.h"
 
+#include "Engine/Render/FrameRenderState.h"
+
 RenderComponent::RenderComponent(Object& object)
 	: Component(object)
 	, m_spAABB(std::make_unique<AABB>())
@@ -50,3 +53,23 @@ const AABB& RenderComponent::GetAABB() const
 {
 	return *m_spAABB;
 }
+
+void RenderComponent::AddRenderable(std::shared_ptr<Renderable> spRenderable)
+{
+	ASSERT(spRenderable != nullptr);
+	m_renderables.Add(std::move(spRenderable));
+}
+
+void RenderComponent::ExtractRenderState(FrameRenderState& renderState) const
+{
+	if(!IsEnabled() || !m_isVisible)
+	{
+		return;
+	}
+
+	const Matrix4& worldMatrix = m_object.GetTransform().GetWorldMatrix();
+	for(const std::shared_ptr<Renderable>& spRenderable : m_renderables)
+	{
+		renderState.AddRenderable(spRenderable, worldMatrix);
+	}
+}
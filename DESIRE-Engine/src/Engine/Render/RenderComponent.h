@@ -4,6 +4,7 @@
 #include "Engine/Core/Container/Array.h"
 
 class AABB;
+class FrameRenderState;
 class Renderable;
 
 class RenderComponent : public Component
@@ -24,8 +25,14 @@ public:
 
 	const AABB& GetAABB() const;
 
+	void AddRenderable(std::shared_ptr<Renderable> spRenderable);
+
+	// Add the renderables with the world matrix of the object, if the component is enabled and visible
+	void ExtractRenderState(FrameRenderState& renderState) const;
+
 private:
-	Array<Renderable*> m_renderables;
+	// Shared with the extracted render states, which can outlive the component in pipelined mode
+	Array<std::shared_ptr<Renderable>> m_renderables;
 
 	std::unique_ptr<AABB> m_spAABB;
 
@@ -0,0 +1,71 @@
+#include "Engine/stdafx.h"
+#include "Engine/Render/RenderThread.h"
+
+RenderThread::RenderThread()
+{
+	m_thread = std::thread(&RenderThread::ThreadFunc, this);
+}
+
+RenderThread::~RenderThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isShuttingDown = true;
+		m_condition.notify_all();
+	}
+
+	m_thread.join();
+}
+
+void RenderThread::Run(std::function<void()> func)
+{
+	ASSERT(func != nullptr);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]()
+	{
+		return (m_func == nullptr);
+	});
+
+	m_func = std::move(func);
+	m_condition.notify_all();
+}
+
+void RenderThread::WaitForIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_condition.wait(lock, [this]()
+	{
+		return (m_func == nullptr);
+	});
+}
+
+std::thread::id RenderThread::GetThreadId() const
+{
+	return m_thread.get_id();
+}
+
+void RenderThread::ThreadFunc()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for(;;)
+	{
+		m_condition.wait(lock, [this]()
+		{
+			return (m_func != nullptr || m_isShuttingDown);
+		});
+
+		// The function which was started before the shutdown is still executed
+		if(m_func == nullptr)
+		{
+			break;
+		}
+
+		lock.unlock();
+		m_func();
+		lock.lock();
+
+		m_func = nullptr;
+		m_condition.notify_all();
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// --------------------------------------------------------------------------------------------------------------------
+//	RenderThread executes functions one at a time on a dedicated thread.
+//	The Render module is thread-affine, so in pipelined mode it is initialized, used and killed only from this thread.
+// --------------------------------------------------------------------------------------------------------------------
+
+class RenderThread
+{
+public:
+	RenderThread();
+	~RenderThread();
+
+	// Start executing the function on the render thread, after the previously started one has finished
+	void Run(std::function<void()> func);
+
+	// Block the calling thread until the previously started function has finished
+	void WaitForIdle();
+
+	std::thread::id GetThreadId() const;
+
+private:
+	DESIRE_NO_COPY_AND_MOVE(RenderThread)
+
+	void ThreadFunc();
+
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::function<void()> m_func;
+	bool m_isShuttingDown = false;
+};
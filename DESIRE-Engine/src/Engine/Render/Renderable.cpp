@@ -5,5 +5,9 @@
 
 Renderable::~Renderable()
 {
-	Modules::Render->Unbind(*this);
+	// Only the renderables which were rendered have data in the render module
+	if(m_pRenderData != nullptr)
+	{
+		Modules::Render->Unbind(*this);
+	}
 }
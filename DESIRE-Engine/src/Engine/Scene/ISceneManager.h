@@ -1,6 +1,7 @@
 #pragma once
 
 class Camera;
+class FrameRenderState;
 class RenderComponent;
 
 class ISceneManager
@@ -18,4 +19,7 @@ public:
 
 	virtual void Update() = 0;
 	virtual void Reset() = 0;
+
+	// Add the active camera and the visible render components to the render state
+	virtual void ExtractRenderState(FrameRenderState& renderState) const = 0;
 };
@@ -5,6 +5,7 @@
 
 #include "Engine/Render/Camera.h"
 #include "Engine/Render/DebugDraw.h"
+#include "Engine/Render/FrameRenderState.h"
 #include "Engine/Render/RenderComponent.h"
 
 #include "Engine/Scene/QuadTreeLeaf.h"
@@ -117,6 +118,22 @@ void QuadTreeSceneManager::Reset()
 	m_doInvisibleLeafTest = true;
 }
 
+void QuadTreeSceneManager::ExtractRenderState(FrameRenderState& renderState) const
+{
+	if(m_pActiveCamera)
+	{
+		renderState.SetCamera(*m_pActiveCamera);
+	}
+
+	for(RenderComponent* pRenderComponent : m_visibleDynamicComponents)
+	{
+		pRenderComponent->ExtractRenderState(renderState);
+	}
+
+	// The components of the leafs are filtered by their visibility
+	ExtractRenderState_recursive(*m_pRootLeaf, renderState);
+}
+
 void QuadTreeSceneManager::CalcFrustumNormalsFromCamera(Camera* pCamera, Vector3* pNormals, uint8_t& numNormals, float(&pointDotNormal)[kMaxFurstumNormal], uint8_t(&aabbNPVertex)[kMaxFurstumNormal][2])
 {
 	numNormals = 0;
@@ -385,6 +402,22 @@ void QuadTreeSceneManager::SetLeafsVisible_recursive(QuadTreeLeaf& leaf, bool vi
 	}
 }
 
+void QuadTreeSceneManager::ExtractRenderState_recursive(const QuadTreeLeaf& leaf, FrameRenderState& renderState)
+{
+	for(const RenderComponent* pRenderComponent : leaf.m_renderComponents)
+	{
+		pRenderComponent->ExtractRenderState(renderState);
+	}
+
+	for(uint8_t i = 0; i < 4; i++)
+	{
+		if(leaf.m_leafs[i] != nullptr)
+		{
+			ExtractRenderState_recursive(*leaf.m_leafs[i], renderState);
+		}
+	}
+}
+
 QuadTreeSceneManager::EState QuadTreeSceneManager::IsAabbVisible(const Vector3* pPoints, uint8_t numNormals, const Vector3* pNormals, const float* pPointDotNormal, const uint8_t(&aabbNPVertex)[kMaxFurstumNormal][2])
 {
 	EState rv = EState::Inside;
@@ -21,6 +21,8 @@ public:
 	void Update() override;
 	void Reset() override;
 
+	void ExtractRenderState(FrameRenderState& renderState) const override;
+
 private:
 	static constexpr size_t kMaxFurstumNormal = 4;
 
@@ -37,6 +39,7 @@ private:
 	void TestInvisibleLeafs(uint8_t numNormals, const Vector3* pNormals, const float* pPointDotNormal, const uint8_t(&aabbNPVertex)[kMaxFurstumNormal][2]);
 
 	static void SetLeafsVisible_recursive(QuadTreeLeaf& leaf, bool visible);
+	static void ExtractRenderState_recursive(const QuadTreeLeaf& leaf, FrameRenderState& renderState);
 	static EState IsAabbVisible(const Vector3* pPoints, uint8_t numNormals, const Vector3* pNormals, const float* pPointDotNormal, const uint8_t(&aabbNPVertex)[kMaxFurstumNormal][2]);
 
 	QuadTreeLeaf* m_pRootLeaf = nullptr;
@@ -6,12 +6,12 @@
 ScriptComponent::ScriptComponent(Object& object)
 	: Component(object)
 {
-	Modules::ScriptSystem->OnScriptComponentCreated(this);
+	m_handle = Modules::ScriptSystem->OnScriptComponentCreated(this);
 }
 
 ScriptComponent::~ScriptComponent()
 {
-	Modules::ScriptSystem->OnScriptComponentDestroyed(this);
+	Modules::ScriptSystem->OnScriptComponentDestroyed(m_handle);
 }
 
 void ScriptComponent::CloneTo(Object& otherObject) const
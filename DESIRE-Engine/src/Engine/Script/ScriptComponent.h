@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Core/Component.h"
+#include "Engine/Core/Container/SlotMap.h"
 
 class String;
 
@@ -51,4 +52,6 @@ private:
 	virtual bool AddFunctionCallArg(bool arg) = 0;
 	virtual bool AddFunctionCallArg(void* pArg) = 0;
 	virtual bool AddFunctionCallArg(const String& string) = 0;
+
+	SlotMap<ScriptComponent*>::Handle m_handle;
 };
@@ -34,14 +34,14 @@ ScriptComponent* ScriptSystem::CreateScriptComponentOnObject(Object& object, con
 	return CreateScriptComponentOnObject_Internal(object, scriptName);
 }
 
-void ScriptSystem::OnScriptComponentCreated(ScriptComponent* pScriptComponent)
+SlotMap<ScriptComponent*>::Handle ScriptSystem::OnScriptComponentCreated(ScriptComponent* pScriptComponent)
 {
-	m_scriptComponents.Add(pScriptComponent);
+	return m_scriptComponents.Add(pScriptComponent);
 }
 
-void ScriptSystem::OnScriptComponentDestroyed(ScriptComponent* pScriptComponent)
+void ScriptSystem::OnScriptComponentDestroyed(SlotMap<ScriptComponent*>::Handle handle)
 {
-	m_scriptComponents.RemoveFast(pScriptComponent);
+	m_scriptComponents.Remove(handle);
 }
 
 void ScriptSystem::Update()
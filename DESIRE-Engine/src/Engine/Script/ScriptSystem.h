@@ -1,7 +1,7 @@
 #pragma once
 
-#include "Engine/Core/Container/Array.h"
 #include "Engine/Core/Container/HashedStringMap.h"
+#include "Engine/Core/Container/SlotMap.h"
 #include "Engine/Core/Factory.h"
 
 class IScript;
@@ -21,14 +21,14 @@ public:
 	void RegisterScript(HashedString scriptName, ScriptFactory::Func_t factory);
 	ScriptComponent* CreateScriptComponentOnObject(Object& object, const String& scriptName);
 
-	void OnScriptComponentCreated(ScriptComponent* pScriptComponent);
-	void OnScriptComponentDestroyed(ScriptComponent* pScriptComponent);
+	SlotMap<ScriptComponent*>::Handle OnScriptComponentCreated(ScriptComponent* pScriptComponent);
+	void OnScriptComponentDestroyed(SlotMap<ScriptComponent*>::Handle handle);
 
 private:
 	virtual ScriptComponent* CreateScriptComponentOnObject_Internal(Object& object, const String& scriptName) = 0;
 
-	Array<ScriptComponent*> m_scriptComponents;
+	SlotMap<ScriptComponent*> m_scriptComponents;
 	HashedStringMap<ScriptFactory::Func_t> m_scriptFactories;
 };
 
-#define REGISTER_NATIVE_SCRIPT(SCRIPT)	Modules::ScriptSystem->RegisterScript(HashedString(#SCRIPT), &ScriptSystem::ScriptFactory::Create<SCRIPT>)
+#define REGISTER_NATIVE_SCRIPT(SCRIPT)	Modules::ScriptSystem->RegisterScript(DESIRE_HASHED_STRING(#SCRIPT), &ScriptSystem::ScriptFactory::Create<SCRIPT>)
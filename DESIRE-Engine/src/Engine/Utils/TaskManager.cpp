@@ -7,23 +7,16 @@ TaskManager::TaskManager()
 
 TaskManager::~TaskManager()
 {
+	WaitForDispatchedTasks();
 }
 
-uint32_t TaskManager::AddTask(std::function<void()> task, bool toFront)
+uint32_t TaskManager::AddTask(std::function<void()> task)
 {
 	ASSERT(task != nullptr);
 
 	std::lock_guard<std::mutex> lock(m_taskQueueMutex);
 	const uint32_t taskId = m_taskUniqueId++;
-	if(toFront)
-	{
-		m_taskQueue.emplace_front(taskId, task);
-	}
-	else
-	{
-		m_taskQueue.emplace_back(taskId, task);
-	}
-
+	m_taskQueue.emplace_back(taskId, task);
 	return taskId;
 }
 
@@ -50,48 +43,53 @@ void TaskManager::AddDelayedTask(float delaySecs, std::function<void()> task)
 
 void TaskManager::Update(float deltaTime)
 {
-	// Check timed tasks
-	if(!m_timedTasks.empty())
-	{
-		m_taskQueueMutex.lock();
+	Array<std::function<void()>> readyTasks;
 
-		m_timer += deltaTime;
+	{
+		std::lock_guard<std::mutex> lock(m_taskQueueMutex);
 
-		while(!m_timedTasks.empty() && m_timedTasks.top().time < m_timer)
+		// Check timed tasks
+		if(!m_timedTasks.empty())
 		{
-			std::function<void()> task = m_timedTasks.top().task;
-			m_timedTasks.pop();
-
-			m_taskQueueMutex.unlock();
-			task();
-			m_taskQueueMutex.lock();
+			m_timer += deltaTime;
+
+			while(!m_timedTasks.empty() && m_timedTasks.top().time < m_timer)
+			{
+				readyTasks.Add(m_timedTasks.top().task);
+				m_timedTasks.pop();
+			}
+
+			// Reset m_timer if we run out of tasks
+			if(m_timedTasks.empty())
+			{
+				m_timer = 0.0f;
+			}
 		}
 
-		// Reset m_timer if we run out of tasks
-		if(m_timedTasks.empty())
+		// Check normal tasks
+		for(std::pair<uint32_t, std::function<void()>>& taskPair : m_taskQueue)
 		{
-			m_timer = 0.0f;
+			readyTasks.Add(std::move(taskPair.second));
 		}
-
-		m_taskQueueMutex.unlock();
+		m_taskQueue.clear();
 	}
 
-	// Check normal tasks
-	if(!m_taskQueue.empty())
+	JobSystem* pJobSystem = Modules::JobSystem.get();
+	if(pJobSystem && pJobSystem->GetNumThreads() > 1)
 	{
-		m_taskQueueMutex.lock();
-
-		if(!m_taskQueue.empty())	// Just to be sure
+		for(std::function<void()>& task : readyTasks)
 		{
-			std::function<void()> task = m_taskQueue.front().second;
-			m_taskQueue.pop_front();
-
-			m_taskQueueMutex.unlock();
-			task();
+			pJobSystem->Run(std::move(task), &m_dispatchedTasks);
 		}
-		else
+
+		// The tasks of this update run concurrently, but they are finished before the caller continues with the frame
+		WaitForDispatchedTasks();
+	}
+	else
+	{
+		for(std::function<void()>& task : readyTasks)
 		{
-			m_taskQueueMutex.unlock();
+			task();
 		}
 	}
 }
@@ -110,3 +108,19 @@ void TaskManager::Clear()
 	m_timer = 0.0f;
 	m_taskUniqueId = 0;
 }
+
+void TaskManager::WaitForDispatchedTasks()
+{
+	if(m_dispatchedTasks.IsDone())
+	{
+		return;
+	}
+
+	// Without a JobSystem the tasks are executed inline by Update(), so the counter can only be pending if the JobSystem was destroyed
+	JobSystem* pJobSystem = Modules::JobSystem.get();
+	ASSERT(pJobSystem != nullptr);
+	if(pJobSystem != nullptr)
+	{
+		pJobSystem->WaitForCounter(m_dispatchedTasks);
+	}
+}
@@ -1,22 +1,35 @@
 #pragma once
 
+#include "Engine/Core/Job/JobSystem.h"
+
 #include <deque>
 #include <queue>		// for std::priority_queue
 
+// --------------------------------------------------------------------------------------------------------------------
+//	TaskManager collects tasks and dispatches them to Modules::JobSystem when Update() is called.
+//	The dispatched tasks can run concurrently in any order, but Update() returns only after all of them have finished.
+//	If there is no JobSystem or it has no worker threads, the tasks are executed on the calling thread in order.
+// --------------------------------------------------------------------------------------------------------------------
+
 class TaskManager
 {
 public:
 	TaskManager();
 	~TaskManager();
 
-	uint32_t AddTask(std::function<void()> task, bool toFront = false);
+	uint32_t AddTask(std::function<void()> task);
 	void CancelTask(uint32_t taskId);
 
 	void AddDelayedTask(float delaySecs, std::function<void()> task);
 
+	// Execute all queued tasks and the delayed tasks which are due
 	void Update(float deltaTime);
+	// Remove all tasks which are not dispatched yet
 	void Clear();
 
+	// Wait for the dispatched tasks to finish
+	void WaitForDispatchedTasks();
+
 private:
 	struct TimedTask
 	{
@@ -34,4 +47,6 @@ private:
 	std::priority_queue<TimedTask, std::vector<TimedTask>, std::greater<TimedTask>> m_timedTasks;
 	float m_timer = 0.0f;
 	uint32_t m_taskUniqueId = 0;
+
+	JobCounter m_dispatchedTasks;
 };
@@ -962,14 +962,14 @@ void Direct3D12Render::UpdateShaderParams(const Material& material, ShaderRender
 			}
 		}
 
-		pVariable = bufferData.variables.Find("matWorldView");
+		pVariable = bufferData.variables.Find(DESIRE_HASHED_STRING("matWorldView"));
 		if(pVariable && pVariable->size == sizeof(DirectX::XMMATRIX))
 		{
 			const DirectX::XMMATRIX matWorldView = DirectX::XMMatrixMultiply(m_matWorld, m_matView);
 			isChanged |= pVariable->CheckAndUpdate(&matWorldView.r[0]);
 		}
 
-		pVariable = bufferData.variables.Find("matWorldViewProj");
+		pVariable = bufferData.variables.Find(DESIRE_HASHED_STRING("matWorldViewProj"));
 		if(pVariable && pVariable->size == sizeof(DirectX::XMMATRIX))
 		{
 			const DirectX::XMMATRIX matWorldView = DirectX::XMMatrixMultiply(m_matWorld, m_matView);
@@ -977,27 +977,27 @@ void Direct3D12Render::UpdateShaderParams(const Material& material, ShaderRender
 			isChanged |= pVariable->CheckAndUpdate(&matWorldViewProj.r[0]);
 		}
 
-		pVariable = bufferData.variables.Find("matView");
+		pVariable = bufferData.variables.Find(DESIRE_HASHED_STRING("matView"));
 		if(pVariable)
 		{
 			isChanged |= pVariable->CheckAndUpdate(&m_matView.r[0]);
 		}
 
-		pVariable = bufferData.variables.Find("matViewInv");
+		pVariable = bufferData.variables.Find(DESIRE_HASHED_STRING("matViewInv"));
 		if(pVariable)
 		{
 			const DirectX::XMMATRIX matViewInv = DirectX::XMMatrixInverse(nullptr, m_matView);
 			isChanged |= pVariable->CheckAndUpdate(&matViewInv.r[0]);
 		}
 
-		pVariable = bufferData.variables.Find("camPos");
+		pVariable = bufferData.variables.Find(DESIRE_HASHED_STRING("camPos"));
 		if(pVariable)
 		{
 			const DirectX::XMMATRIX matViewInv = DirectX::XMMatrixInverse(nullptr, m_matView);
 			isChanged |= pVariable->CheckAndUpdate(&matViewInv.r[3]);
 		}
 
-		pVariable = bufferData.variables.Find("resolution");
+		pVariable = bufferData.variables.Find(DESIRE_HASHED_STRING("resolution"));
 		if(pVariable && pVariable->size == 2 * sizeof(float))
 		{
 			float resolution[2] = {};
@@ -9,6 +9,11 @@ project "UnitTest"
 	pchheader "stdafx.h"
 	pchsource "../src/stdafx.cpp"
 
+	defines
+	{
+		"CATCH_CONFIG_ENABLE_BENCHMARKING",
+	}
+
 	includedirs
 	{
 		"../3rdparty",
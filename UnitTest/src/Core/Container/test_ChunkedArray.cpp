@@ -0,0 +1,94 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/ChunkedArray.h"
+
+TEST_CASE("ChunkedArray", "[Core]")
+{
+	ChunkedArray<std::unique_ptr<int32_t>, 4> array;
+	CHECK(array.IsEmpty());
+
+	for(int32_t i = 0; i < 10; ++i)
+	{
+		array.Add(std::make_unique<int32_t>(i));
+	}
+	CHECK(array.Size() == 10);
+	CHECK(array.GetReservedSize() == 12);
+
+	SECTION("Stable addresses")
+	{
+		const std::unique_ptr<int32_t>* pFirst = &array.GetFirst();
+		const std::unique_ptr<int32_t>* pFifth = &array[4];
+
+		for(int32_t i = 0; i < 100; ++i)
+		{
+			array.EmplaceAdd(std::make_unique<int32_t>(i));
+		}
+
+		CHECK(pFirst == &array.GetFirst());
+		CHECK(pFifth == &array[4]);
+		CHECK(**pFifth == 4);
+	}
+
+	SECTION("RemoveFastAt()")
+	{
+		array.RemoveFastAt(1);
+		CHECK(array.Size() == 9);
+		CHECK(*array[1] == 9);
+		CHECK(*array.GetLast() == 8);
+
+		array.RemoveFastAt(8);
+		CHECK(array.Size() == 8);
+		CHECK(*array.GetLast() == 7);
+	}
+
+	SECTION("Iteration")
+	{
+		int32_t expectedValue = 0;
+		for(const std::unique_ptr<int32_t>& spValue : array)
+		{
+			CHECK(*spValue == expectedValue++);
+		}
+		CHECK(expectedValue == 10);
+
+		size_t numChunks = 0;
+		size_t numElements = 0;
+		array.ForEachChunk([&numChunks, &numElements](std::unique_ptr<int32_t>* pElements, size_t count)
+		{
+			CHECK(*pElements[0] == static_cast<int32_t>(numChunks * 4));
+			numChunks++;
+			numElements += count;
+		});
+		CHECK(numChunks == 3);
+		CHECK(numElements == 10);
+	}
+
+	SECTION("Clear()")
+	{
+		array.Clear();
+		CHECK(array.IsEmpty());
+		CHECK(array.GetReservedSize() == 12);
+
+		array.Add(std::make_unique<int32_t>(100));
+		CHECK(*array.GetFirst() == 100);
+	}
+}
+
+TEST_CASE("ChunkedArray RemoveFast()", "[Core]")
+{
+	ChunkedArray<int32_t> array;
+	for(int32_t i = 0; i < 1000; ++i)
+	{
+		array.Add(i);
+	}
+
+	CHECK(array.RemoveFast(500));
+	CHECK_FALSE(array.RemoveFast(500));
+	CHECK(array.Size() == 999);
+	CHECK(array[500] == 999);
+
+	int64_t sum = 0;
+	array.ForEach([&sum](int32_t value)
+	{
+		sum += value;
+	});
+	CHECK(sum == 999 * 1000 / 2 - 500);
+}
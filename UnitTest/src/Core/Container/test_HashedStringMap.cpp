@@ -3,6 +3,9 @@
 #define ASSERT(COND)
 #include "Engine/Core/Container/HashedStringMap.h"
 
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/String/StackString.h"
+
 TEST_CASE("HashedStringMap", "[Core]")
 {
 	HashedStringMap<int32_t> map;
@@ -36,4 +39,92 @@ TEST_CASE("HashedStringMap", "[Core]")
 
 		CHECK(map.Find("not_added") == nullptr);
 	}
+
+	SECTION("Remove()")
+	{
+		map.Insert("one", 1);
+		map.Insert("two", 2);
+
+		CHECK(map.Remove("one"));
+		CHECK_FALSE(map.Remove("one"));
+		CHECK(map.Find("one") == nullptr);
+		REQUIRE(map.Find("two") != nullptr);
+		CHECK(*map.Find("two") == 2);
+		CHECK(map.Size() == 2);
+	}
+
+	SECTION("Clear()")
+	{
+		map.Clear();
+		CHECK(map.IsEmpty());
+		CHECK(map.Find("asdasdasd") == nullptr);
+	}
+}
+
+TEST_CASE("HashedStringMap with many elements", "[Core]")
+{
+	constexpr int32_t kNumElements = 10000;
+
+	HashedStringMap<int32_t> map;
+	map.Reserve(kNumElements / 2);
+
+	for(int32_t i = 0; i < kNumElements; ++i)
+	{
+		map.Insert(StackString<16>::Format("key%d", i), i);
+	}
+	CHECK(map.Size() == kNumElements);
+
+	// Remove every third element, the rest must remain reachable after the backward shifts
+	for(int32_t i = 0; i < kNumElements; i += 3)
+	{
+		CHECK(map.Remove(StackString<16>::Format("key%d", i)));
+	}
+
+	bool allFound = true;
+	for(int32_t i = 0; i < kNumElements; ++i)
+	{
+		const int32_t* pValue = map.Find(StackString<16>::Format("key%d", i));
+		allFound &= (i % 3 == 0) ? (pValue == nullptr) : (pValue != nullptr && *pValue == i);
+	}
+	CHECK(allFound);
+
+	int64_t sum = 0;
+	map.ForEach([&sum](int32_t value)
+	{
+		sum += value;
+	});
+
+	int64_t expectedSum = 0;
+	for(int32_t i = 0; i < kNumElements; ++i)
+	{
+		expectedSum += (i % 3 != 0) ? i : 0;
+	}
+	CHECK(sum == expectedSum);
+
+	HashedStringMap<int32_t> movedMap = std::move(map);
+	CHECK(map.IsEmpty());
+	CHECK(movedMap.Size() == kNumElements - (kNumElements + 2) / 3);
+}
+
+TEST_CASE("HashedStringMap benchmark", "[Core][!benchmark]")
+{
+	constexpr int32_t kNumElements = 1000;
+
+	Array<HashedString> keys;
+	HashedStringMap<int32_t> map;
+	for(int32_t i = 0; i < kNumElements; ++i)
+	{
+		keys.Add(StackString<16>::Format("key%d", i));
+		map.Insert(keys.GetLast(), i);
+	}
+
+	BENCHMARK("Find")
+	{
+		int32_t sum = 0;
+		for(const HashedString& key : keys)
+		{
+			sum += *map.Find(key);
+		}
+		return sum;
+	};
 }
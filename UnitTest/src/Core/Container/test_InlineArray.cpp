@@ -0,0 +1,98 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/InlineArray.h"
+
+TEST_CASE("InlineArray", "[Core]")
+{
+	InlineArray<std::unique_ptr<int32_t>, 2> array;
+	CHECK(array.IsEmpty());
+	CHECK(array.IsUsingInlineStorage());
+
+	array.Add(std::make_unique<int32_t>(1));
+	array.Add(std::make_unique<int32_t>(2));
+	CHECK(array.Size() == 2);
+	CHECK(array.IsUsingInlineStorage());
+
+	SECTION("Add() beyond the inline storage")
+	{
+		array.Add(std::make_unique<int32_t>(3));
+		CHECK_FALSE(array.IsUsingInlineStorage());
+		CHECK(array.Size() == 3);
+		CHECK(*array[0] == 1);
+		CHECK(*array[1] == 2);
+		CHECK(*array[2] == 3);
+	}
+
+	SECTION("Insert() | RemoveAt()")
+	{
+		array.Insert(1, std::make_unique<int32_t>(100));
+		CHECK(*array[0] == 1);
+		CHECK(*array[1] == 100);
+		CHECK(*array[2] == 2);
+
+		array.RemoveAt(0);
+		CHECK(array.Size() == 2);
+		CHECK(*array.GetFirst() == 100);
+		CHECK(*array.GetLast() == 2);
+	}
+
+	SECTION("RemoveFastAt()")
+	{
+		array.Add(std::make_unique<int32_t>(3));
+		array.RemoveFastAt(0);
+		CHECK(array.Size() == 2);
+		CHECK(*array[0] == 3);
+		CHECK(*array[1] == 2);
+	}
+
+	SECTION("Move")
+	{
+		InlineArray<std::unique_ptr<int32_t>, 2> movedArray = std::move(array);
+		CHECK(array.IsEmpty());
+		REQUIRE(movedArray.Size() == 2);
+		CHECK(*movedArray[1] == 2);
+
+		movedArray.Add(std::make_unique<int32_t>(3));
+		array = std::move(movedArray);
+		CHECK(movedArray.IsEmpty());
+		CHECK(movedArray.IsUsingInlineStorage());
+		REQUIRE(array.Size() == 3);
+		CHECK(*array[2] == 3);
+	}
+
+	SECTION("Swap()")
+	{
+		InlineArray<std::unique_ptr<int32_t>, 2> otherArray;
+		for(int32_t i = 0; i < 5; ++i)
+		{
+			otherArray.Add(std::make_unique<int32_t>(10 + i));
+		}
+
+		array.Swap(otherArray);
+		CHECK(array.Size() == 5);
+		CHECK(*array[4] == 14);
+		CHECK(otherArray.Size() == 2);
+		CHECK(*otherArray[0] == 1);
+	}
+}
+
+TEST_CASE("InlineArray copy", "[Core]")
+{
+	InlineArray<int32_t, 4> array = { 5, 3, 1 };
+	InlineArray<int32_t, 4> copiedArray = array;
+	copiedArray.BinaryFindOrInsert(2, [](const int32_t& a, const int32_t& b) { return a > b; });
+	copiedArray.Add(0);
+
+	CHECK(array.Size() == 3);
+	REQUIRE(copiedArray.Size() == 5);
+	CHECK_FALSE(copiedArray.IsUsingInlineStorage());
+
+	const int32_t expectedValues[] = { 5, 3, 2, 1, 0 };
+	for(size_t i = 0; i < copiedArray.Size(); ++i)
+	{
+		CHECK(copiedArray[i] == expectedValues[i]);
+	}
+
+	CHECK(copiedArray.Find(1) == 3);
+	CHECK(copiedArray.Remove(3));
+	CHECK(copiedArray.Find(3) == SIZE_MAX);
+}
@@ -0,0 +1,155 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/LockFreeMPMCQueue.h"
+
+#include <deque>
+
+// Pushes 'numElements' values from each producer thread and pops them on the consumer threads, returns the sum of the popped values
+template<typename PushFunc, typename PopFunc>
+static uint64_t TransferValues(uint32_t numProducers, uint32_t numConsumers, uint32_t numElements, const PushFunc& pushFunc, const PopFunc& popFunc)
+{
+	std::atomic<uint64_t> sum = 0;
+	std::atomic<uint32_t> numRemainingElements = numProducers * numElements;
+
+	std::vector<std::thread> threads;
+	for(uint32_t i = 0; i < numProducers; ++i)
+	{
+		threads.emplace_back([&pushFunc, numElements]()
+		{
+			for(uint32_t value = 1; value <= numElements; ++value)
+			{
+				while(!pushFunc(value))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+
+	for(uint32_t i = 0; i < numConsumers; ++i)
+	{
+		threads.emplace_back([&popFunc, &sum, &numRemainingElements]()
+		{
+			uint64_t localSum = 0;
+			uint32_t value = 0;
+			while(numRemainingElements > 0)
+			{
+				if(popFunc(value))
+				{
+					localSum += value;
+					numRemainingElements--;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+			sum += localSum;
+		});
+	}
+
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	return sum;
+}
+
+TEST_CASE("LockFreeMPMCQueue", "[Core]")
+{
+	LockFreeMPMCQueue<uint32_t, 1024> queue;
+	CHECK(queue.IsEmpty());
+
+	SECTION("Push() | Pop()")
+	{
+		for(uint32_t i = 0; i < 4; ++i)
+		{
+			CHECK(queue.Push(i));
+		}
+		CHECK_FALSE(queue.IsEmpty());
+
+		uint32_t value = 0;
+		for(uint32_t i = 0; i < 4; ++i)
+		{
+			CHECK(queue.Pop(value));
+			CHECK(value == i);
+		}
+
+		CHECK_FALSE(queue.Pop(value));
+		CHECK(queue.IsEmpty());
+	}
+
+	SECTION("Full queue")
+	{
+		for(uint32_t i = 0; i < 1024; ++i)
+		{
+			CHECK(queue.Push(i));
+		}
+
+		CHECK_FALSE(queue.Push(1024));
+
+		// Wrap around
+		uint32_t value = 0;
+		CHECK(queue.Pop(value));
+		CHECK(value == 0);
+		CHECK(queue.Push(1024));
+	}
+
+	SECTION("Multiple producers and consumers")
+	{
+		constexpr uint32_t kNumElements = 100000;
+		constexpr uint32_t kNumProducers = 3;
+		const uint64_t sum = TransferValues(kNumProducers, 3, kNumElements,
+			[&queue](uint32_t value) { return queue.Push(value); },
+			[&queue](uint32_t& value) { return queue.Pop(value); }
+		);
+
+		CHECK(sum == kNumProducers * static_cast<uint64_t>(kNumElements) * (kNumElements + 1) / 2);
+		CHECK(queue.IsEmpty());
+	}
+}
+
+TEST_CASE("LockFreeMPMCQueue benchmark", "[Core][!benchmark]")
+{
+	constexpr uint32_t kNumElements = 100000;
+
+	for(uint32_t numThreads : { 1, 2, 4 })
+	{
+		const std::string name = std::to_string(numThreads) + " producer(s) / " + std::to_string(numThreads) + " consumer(s)";
+
+		BENCHMARK("LockFreeMPMCQueue " + name)
+		{
+			LockFreeMPMCQueue<uint32_t, 1024> queue;
+			return TransferValues(numThreads, numThreads, kNumElements,
+				[&queue](uint32_t value) { return queue.Push(value); },
+				[&queue](uint32_t& value) { return queue.Pop(value); }
+			);
+		};
+
+		BENCHMARK("std::mutex + std::deque " + name)
+		{
+			std::mutex mutex;
+			std::deque<uint32_t> queue;
+			return TransferValues(numThreads, numThreads, kNumElements,
+				[&mutex, &queue](uint32_t value)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					queue.push_back(value);
+					return true;
+				},
+				[&mutex, &queue](uint32_t& value)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if(queue.empty())
+					{
+						return false;
+					}
+
+					value = queue.front();
+					queue.pop_front();
+					return true;
+				}
+			);
+		};
+	}
+}
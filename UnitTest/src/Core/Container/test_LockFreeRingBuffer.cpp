@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "Engine/Core/Container/LockFreeRingBuffer.h"
 
+#include <deque>
+
 TEST_CASE("LockFreeRingBuffer", "[Core]")
 {
 	LockFreeRingBuffer<uint32_t, 10> ringBuffer;
@@ -9,10 +11,10 @@ TEST_CASE("LockFreeRingBuffer", "[Core]")
 	std::thread thread2([&ringBuffer, &thread2Running]()
 	{
 		uint32_t counter = 0;
-		while(thread2Running || !ringBuffer.empty())
+		while(thread2Running || !ringBuffer.IsEmpty())
 		{
 			uint32_t num;
-			if(ringBuffer.pop(num))
+			if(ringBuffer.Pop(num))
 			{
 				CHECK(num == counter);
 				counter++;
@@ -25,7 +27,7 @@ TEST_CASE("LockFreeRingBuffer", "[Core]")
 	uint32_t i = 0;
 	while(i < 15)
 	{
-		bool successful = ringBuffer.push(i);
+		bool successful = ringBuffer.Push(i);
 		if(!successful)
 		{
 			std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -38,5 +40,84 @@ TEST_CASE("LockFreeRingBuffer", "[Core]")
 	thread2Running = false;
 	thread2.join();
 
-	CHECK(ringBuffer.empty());
+	CHECK(ringBuffer.IsEmpty());
+}
+
+TEST_CASE("LockFreeRingBuffer benchmark", "[Core][!benchmark]")
+{
+	constexpr uint32_t kNumElements = 1000000;
+
+	BENCHMARK("LockFreeRingBuffer 1 producer / 1 consumer")
+	{
+		LockFreeRingBuffer<uint32_t, 1024> ringBuffer;
+
+		std::thread consumer([&ringBuffer]()
+		{
+			uint32_t num = 0;
+			for(uint32_t i = 0; i < kNumElements; ++i)
+			{
+				while(!ringBuffer.Pop(num))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		for(uint32_t i = 0; i < kNumElements; ++i)
+		{
+			while(!ringBuffer.Push(i))
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		consumer.join();
+	};
+
+	BENCHMARK("std::mutex + std::deque 1 producer / 1 consumer")
+	{
+		// Limited to the same number of elements as the ring buffer above
+		constexpr size_t kMaxNumElements = 1023;
+		std::mutex mutex;
+		std::deque<uint32_t> queue;
+
+		std::thread consumer([&mutex, &queue]()
+		{
+			uint32_t num = 0;
+			for(uint32_t i = 0; i < kNumElements; ++i)
+			{
+				for(;;)
+				{
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						if(!queue.empty())
+						{
+							num = queue.front();
+							queue.pop_front();
+							break;
+						}
+					}
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		for(uint32_t i = 0; i < kNumElements; ++i)
+		{
+			for(;;)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if(queue.size() < kMaxNumElements)
+					{
+						queue.push_back(i);
+						break;
+					}
+				}
+				std::this_thread::yield();
+			}
+		}
+
+		consumer.join();
+	};
 }
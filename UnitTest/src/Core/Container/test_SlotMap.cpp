@@ -0,0 +1,105 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/SlotMap.h"
+
+TEST_CASE("SlotMap", "[Core]")
+{
+	SlotMap<int32_t> slotMap;
+	CHECK(slotMap.IsEmpty());
+
+	const SlotMap<int32_t>::Handle handle0 = slotMap.Add(0);
+	const SlotMap<int32_t>::Handle handle1 = slotMap.Add(1);
+	const SlotMap<int32_t>::Handle handle2 = slotMap.Add(2);
+	const SlotMap<int32_t>::Handle handle3 = slotMap.Add(3);
+	CHECK(slotMap.Size() == 4);
+
+	SECTION("Get()")
+	{
+		REQUIRE(slotMap.Get(handle2) != nullptr);
+		CHECK(*slotMap.Get(handle2) == 2);
+		CHECK(slotMap.Get(SlotMap<int32_t>::Handle()) == nullptr);
+	}
+
+	SECTION("Remove()")
+	{
+		CHECK(slotMap.Remove(handle1));
+		CHECK_FALSE(slotMap.Remove(handle1));
+		CHECK_FALSE(slotMap.IsValid(handle1));
+		CHECK(slotMap.Size() == 3);
+
+		// The last element is moved into the place of the removed one, but its handle remains valid
+		REQUIRE(slotMap.Get(handle3) != nullptr);
+		CHECK(*slotMap.Get(handle3) == 3);
+		CHECK(*slotMap.begin() == 0);
+		CHECK(*(slotMap.begin() + 1) == 3);
+	}
+
+	SECTION("RemoveKeepOrder()")
+	{
+		CHECK(slotMap.RemoveKeepOrder(handle1));
+		CHECK_FALSE(slotMap.IsValid(handle1));
+
+		int32_t expectedValues[] = { 0, 2, 3 };
+		size_t idx = 0;
+		for(int32_t value : slotMap)
+		{
+			CHECK(value == expectedValues[idx++]);
+		}
+		CHECK(idx == 3);
+
+		CHECK(*slotMap.Get(handle0) == 0);
+		CHECK(*slotMap.Get(handle2) == 2);
+		CHECK(*slotMap.Get(handle3) == 3);
+	}
+
+	SECTION("Reused slot")
+	{
+		slotMap.Remove(handle2);
+		const SlotMap<int32_t>::Handle handle4 = slotMap.Add(4);
+
+		// The new element reuses the slot, but the stale handle is detected by the generation
+		CHECK(handle4.index == handle2.index);
+		CHECK(handle4 != handle2);
+		CHECK(slotMap.Get(handle2) == nullptr);
+		REQUIRE(slotMap.Get(handle4) != nullptr);
+		CHECK(*slotMap.Get(handle4) == 4);
+	}
+
+	SECTION("Clear()")
+	{
+		slotMap.Clear();
+		CHECK(slotMap.IsEmpty());
+		CHECK_FALSE(slotMap.IsValid(handle0));
+		CHECK_FALSE(slotMap.IsValid(handle3));
+
+		const SlotMap<int32_t>::Handle handle = slotMap.Add(100);
+		CHECK(*slotMap.Get(handle) == 100);
+	}
+}
+
+TEST_CASE("SlotMap with many elements", "[Core]")
+{
+	constexpr uint32_t kNumElements = 10000;
+
+	SlotMap<uint32_t> slotMap;
+	slotMap.Reserve(kNumElements);
+
+	Array<SlotMap<uint32_t>::Handle> handles;
+	for(uint32_t i = 0; i < kNumElements; ++i)
+	{
+		handles.Add(slotMap.Add(i));
+	}
+
+	for(uint32_t i = 0; i < kNumElements; i += 2)
+	{
+		CHECK(slotMap.Remove(handles[i]));
+	}
+	CHECK(slotMap.Size() == kNumElements / 2);
+
+	bool allValid = true;
+	for(uint32_t i = 0; i < kNumElements; ++i)
+	{
+		const uint32_t* pValue = slotMap.Get(handles[i]);
+		allValid &= (i % 2 == 0) ? (pValue == nullptr) : (pValue != nullptr && *pValue == i);
+	}
+	CHECK(allValid);
+}
@@ -0,0 +1,109 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/SoAArray.h"
+
+#include "Engine/Core/Container/Array.h"
+
+TEST_CASE("SoAArray", "[Core]")
+{
+	SoAArray<float, int32_t, uint8_t> array;
+	CHECK(array.IsEmpty());
+
+	for(int32_t i = 0; i < 10; ++i)
+	{
+		CHECK(array.Add(static_cast<float>(i), i * 10, static_cast<uint8_t>(i)) == static_cast<size_t>(i));
+	}
+
+	CHECK(array.Size() == 10);
+	CHECK(array.GetPaddedSize() == 16);
+	CHECK(array.GetReservedSize() % SoAArray<float>::kNumLanes == 0);
+
+	SECTION("Stream alignment")
+	{
+		CHECK(reinterpret_cast<size_t>(array.GetStream<0>()) % SoAArray<float>::kStreamAlignment == 0);
+		CHECK(reinterpret_cast<size_t>(array.GetStream<1>()) % SoAArray<float>::kStreamAlignment == 0);
+		CHECK(reinterpret_cast<size_t>(array.GetStream<2>()) % SoAArray<float>::kStreamAlignment == 0);
+	}
+
+	SECTION("RemoveFastAt()")
+	{
+		array.RemoveFastAt(2);
+		CHECK(array.Size() == 9);
+		CHECK(array.Get<0>(2) == 9.0f);
+		CHECK(array.Get<1>(2) == 90);
+		CHECK(array.Get<2>(2) == 9);
+
+		array.RemoveFastAt(8);
+		CHECK(array.Size() == 8);
+		CHECK(array.Get<1>(7) == 70);
+	}
+
+	SECTION("ForEach()")
+	{
+		array.ForEach([](float& x, int32_t& y, uint8_t& z)
+		{
+			x *= 2.0f;
+			y += z;
+		});
+
+		for(size_t i = 0; i < array.Size(); ++i)
+		{
+			CHECK(array.Get<0>(i) == i * 2.0f);
+			CHECK(array.Get<1>(i) == static_cast<int32_t>(i * 11));
+		}
+	}
+
+	SECTION("Move")
+	{
+		SoAArray<float, int32_t, uint8_t> movedArray = std::move(array);
+		CHECK(array.IsEmpty());
+		CHECK(movedArray.Size() == 10);
+		CHECK(movedArray.Get<1>(9) == 90);
+	}
+}
+
+TEST_CASE("SoAArray culling kernel", "[Core]")
+{
+	// Bounding boxes in the XZ plane stored as 4 streams
+	SoAArray<float, float, float, float> boxes;
+	for(int32_t i = 0; i < 1000; ++i)
+	{
+		const float x = static_cast<float>(i % 100);
+		const float z = static_cast<float>(i / 100);
+		boxes.Add(x, z, x + 0.5f, z + 0.5f);
+	}
+
+	// The padded size lets the kernel process the streams in full batches without a scalar remainder loop
+	const float* pMinX = boxes.GetStream<0>();
+	const float* pMinZ = boxes.GetStream<1>();
+	const float* pMaxX = boxes.GetStream<2>();
+	const float* pMaxZ = boxes.GetStream<3>();
+	Array<uint8_t> isVisible;
+	isVisible.SetSize(boxes.GetPaddedSize());
+	for(size_t i = 0; i < boxes.GetPaddedSize(); i += 4)
+	{
+#if DESIRE_USE_SSE
+		const __m128 minX = _mm_load_ps(&pMinX[i]);
+		const __m128 minZ = _mm_load_ps(&pMinZ[i]);
+		const __m128 maxX = _mm_load_ps(&pMaxX[i]);
+		const __m128 maxZ = _mm_load_ps(&pMaxZ[i]);
+		const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(minX, _mm_set1_ps(10.0f)), _mm_cmpge_ps(maxX, _mm_set1_ps(0.0f))), _mm_and_ps(_mm_cmple_ps(minZ, _mm_set1_ps(2.0f)), _mm_cmpge_ps(maxZ, _mm_set1_ps(0.0f))));
+		const int mask = _mm_movemask_ps(inside);
+		for(size_t lane = 0; lane < 4; ++lane)
+		{
+			isVisible[i + lane] = (mask >> lane) & 1;
+		}
+#else
+		for(size_t lane = i; lane < i + 4; ++lane)
+		{
+			isVisible[lane] = (pMinX[lane] <= 10.0f && pMaxX[lane] >= 0.0f && pMinZ[lane] <= 2.0f && pMaxZ[lane] >= 0.0f);
+		}
+#endif
+	}
+
+	size_t numVisible = 0;
+	for(size_t i = 0; i < boxes.Size(); ++i)
+	{
+		numVisible += isVisible[i];
+	}
+	CHECK(numVisible == 11 * 3);
+}
@@ -0,0 +1,216 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/ThreadSafeFreeList.h"
+
+#include "Engine/Core/Container/FreeList.h"
+#include "Engine/Core/SpinLock.h"
+
+#include <set>
+
+struct FreeListTestElement
+{
+	void* pNext;
+	uint32_t value;
+};
+
+TEST_CASE("ThreadSafeFreeList", "[Core]")
+{
+	constexpr uint32_t kNumElements = 1024;
+	FreeListTestElement elements[kNumElements];
+	ThreadSafeFreeList freeList;
+
+	CHECK(freeList.Pop() == nullptr);
+
+	SECTION("Push() | Pop()")
+	{
+		freeList.Push(&elements[0]);
+		freeList.Push(&elements[1]);
+		CHECK(freeList.Pop() == &elements[1]);
+		CHECK(freeList.Pop() == &elements[0]);
+		CHECK(freeList.Pop() == nullptr);
+	}
+
+	SECTION("Concurrent Push() and Pop()")
+	{
+		for(FreeListTestElement& element : elements)
+		{
+			freeList.Push(&element);
+		}
+
+		// Each thread takes elements, marks them as its own and gives them back
+		std::atomic<uint32_t> numErrors = 0;
+		constexpr uint32_t kNumThreads = 4;
+		std::thread threads[kNumThreads];
+		for(uint32_t threadIdx = 0; threadIdx < kNumThreads; ++threadIdx)
+		{
+			threads[threadIdx] = std::thread([&freeList, &numErrors, threadIdx]()
+			{
+				FreeListTestElement* poppedElements[16];
+				for(uint32_t i = 0; i < 10000; ++i)
+				{
+					for(FreeListTestElement*& pElement : poppedElements)
+					{
+						pElement = static_cast<FreeListTestElement*>(freeList.Pop());
+						pElement->value = threadIdx;
+					}
+
+					for(FreeListTestElement* pElement : poppedElements)
+					{
+						if(pElement->value != threadIdx)
+						{
+							// The same element was given to multiple threads
+							numErrors++;
+						}
+						freeList.Push(pElement);
+					}
+				}
+			});
+		}
+
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		CHECK(numErrors == 0);
+
+		// All elements are back in the list
+		std::set<void*> poppedElements;
+		for(void* pElement = freeList.Pop(); pElement != nullptr; pElement = freeList.Pop())
+		{
+			poppedElements.insert(pElement);
+		}
+		CHECK(poppedElements.size() == kNumElements);
+	}
+
+	SECTION("Magazine")
+	{
+		{
+			ThreadSafeFreeList::Magazine magazine(freeList);
+			CHECK(magazine.Pop() == nullptr);
+
+			for(FreeListTestElement& element : elements)
+			{
+				magazine.Push(&element);
+			}
+
+			// Only the overflow reached the shared list
+			std::vector<void*> poppedElements;
+			for(void* pElement = freeList.Pop(); pElement != nullptr; pElement = freeList.Pop())
+			{
+				poppedElements.push_back(pElement);
+			}
+			CHECK(poppedElements.size() < kNumElements);
+			for(void* pElement : poppedElements)
+			{
+				freeList.Push(pElement);
+			}
+
+			std::set<void*> uniqueElements;
+			for(void* pElement = magazine.Pop(); pElement != nullptr; pElement = magazine.Pop())
+			{
+				uniqueElements.insert(pElement);
+			}
+			CHECK(uniqueElements.size() == kNumElements);
+
+			for(void* pElement : uniqueElements)
+			{
+				magazine.Push(pElement);
+			}
+		}
+
+		// The destructor of the magazine gave back all the cached elements
+		uint32_t numElements = 0;
+		while(freeList.Pop() != nullptr)
+		{
+			numElements++;
+		}
+		CHECK(numElements == kNumElements);
+	}
+}
+
+TEST_CASE("ThreadSafeFreeList benchmark", "[Core][!benchmark]")
+{
+	constexpr uint32_t kNumElements = 1024;
+	constexpr uint32_t kNumIterations = 10000;
+	static FreeListTestElement elements[kNumElements];
+
+	const auto runOnThreads = [](uint32_t numThreads, const std::function<void()>& func)
+	{
+		std::vector<std::thread> threads;
+		for(uint32_t i = 0; i < numThreads; ++i)
+		{
+			threads.emplace_back(func);
+		}
+
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	};
+
+	for(uint32_t numThreads : { 1, 2, 4 })
+	{
+		const std::string name = std::to_string(numThreads) + " thread(s)";
+
+		BENCHMARK("SpinLock + FreeList " + name)
+		{
+			SpinLock spinLock;
+			FreeList freeList;
+			for(FreeListTestElement& element : elements)
+			{
+				freeList.Push(&element);
+			}
+
+			runOnThreads(numThreads, [&spinLock, &freeList]()
+			{
+				for(uint32_t i = 0; i < kNumIterations; ++i)
+				{
+					void* pElement = nullptr;
+					{
+						DESIRE_SCOPED_SPINLOCK(spinLock);
+						pElement = freeList.Pop();
+					}
+					{
+						DESIRE_SCOPED_SPINLOCK(spinLock);
+						freeList.Push(pElement);
+					}
+				}
+			});
+		};
+
+		BENCHMARK("ThreadSafeFreeList " + name)
+		{
+			ThreadSafeFreeList freeList;
+			for(FreeListTestElement& element : elements)
+			{
+				freeList.Push(&element);
+			}
+
+			runOnThreads(numThreads, [&freeList]()
+			{
+				for(uint32_t i = 0; i < kNumIterations; ++i)
+				{
+					freeList.Push(freeList.Pop());
+				}
+			});
+		};
+
+		BENCHMARK("ThreadSafeFreeList::Magazine " + name)
+		{
+			ThreadSafeFreeList freeList;
+			for(FreeListTestElement& element : elements)
+			{
+				freeList.Push(&element);
+			}
+
+			runOnThreads(numThreads, [&freeList]()
+			{
+				ThreadSafeFreeList::Magazine magazine(freeList);
+				for(uint32_t i = 0; i < kNumIterations; ++i)
+				{
+					magazine.Push(magazine.Pop());
+				}
+			});
+		};
+	}
+}
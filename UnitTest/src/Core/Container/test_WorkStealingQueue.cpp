@@ -0,0 +1,87 @@
+#include "stdafx.h"
+#include "Engine/Core/Container/WorkStealingQueue.h"
+
+TEST_CASE("WorkStealingQueue", "[Core]")
+{
+	WorkStealingQueue<uint32_t, 1024> queue;
+	CHECK(queue.IsEmpty());
+
+	SECTION("Push() | Pop() | Steal()")
+	{
+		for(uint32_t i = 0; i < 4; ++i)
+		{
+			CHECK(queue.Push(i));
+		}
+
+		uint32_t value = 0;
+		CHECK(queue.Pop(value));
+		CHECK(value == 3);
+		CHECK(queue.Steal(value));
+		CHECK(value == 0);
+		CHECK(queue.Pop(value));
+		CHECK(value == 2);
+		CHECK(queue.Pop(value));
+		CHECK(value == 1);
+		CHECK_FALSE(queue.Pop(value));
+		CHECK_FALSE(queue.Steal(value));
+		CHECK(queue.IsEmpty());
+	}
+
+	SECTION("Full queue")
+	{
+		for(uint32_t i = 0; i < 1024; ++i)
+		{
+			CHECK(queue.Push(i));
+		}
+
+		CHECK_FALSE(queue.Push(1024));
+	}
+
+	SECTION("Concurrent stealing")
+	{
+		constexpr uint32_t kNumElements = 100000;
+		std::atomic<uint64_t> sum = 0;
+		std::atomic<bool> isRunning = true;
+
+		std::thread thieves[3];
+		for(std::thread& thief : thieves)
+		{
+			thief = std::thread([&queue, &sum, &isRunning]()
+			{
+				uint32_t value = 0;
+				while(isRunning || !queue.IsEmpty())
+				{
+					if(queue.Steal(value))
+					{
+						sum += value;
+					}
+				}
+			});
+		}
+
+		uint32_t value = 0;
+		for(uint32_t i = 1; i <= kNumElements; ++i)
+		{
+			while(!queue.Push(i))
+			{
+				if(queue.Pop(value))
+				{
+					sum += value;
+				}
+			}
+		}
+
+		while(queue.Pop(value))
+		{
+			sum += value;
+		}
+
+		isRunning = false;
+		for(std::thread& thief : thieves)
+		{
+			thief.join();
+		}
+
+		CHECK(sum == static_cast<uint64_t>(kNumElements) * (kNumElements + 1) / 2);
+	}
+}
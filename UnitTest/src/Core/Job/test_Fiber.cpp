@@ -0,0 +1,45 @@
+#include "stdafx.h"
+#include "Engine/Core/Job/Fiber.h"
+
+struct FiberTestData
+{
+	Fiber* pThreadFiber = nullptr;
+	Fiber* pFiber = nullptr;
+	uint32_t counter = 0;
+};
+
+static void FiberTestEntryPoint(void* pUserData)
+{
+	FiberTestData* pData = static_cast<FiberTestData*>(pUserData);
+	for(;;)
+	{
+		pData->counter++;
+		pData->pFiber->SwitchTo(*pData->pThreadFiber);
+	}
+}
+
+TEST_CASE("Fiber", "[Core]")
+{
+	FiberTestData data;
+	Fiber threadFiber;
+	Fiber fiber(&FiberTestEntryPoint, &data, 64 * 1024);
+	data.pThreadFiber = &threadFiber;
+	data.pFiber = &fiber;
+
+	for(uint32_t i = 1; i <= 10; ++i)
+	{
+		threadFiber.SwitchTo(fiber);
+		CHECK(data.counter == i);
+	}
+}
+
+TEST_CASE("Fiber creation failure", "[Core]")
+{
+	// The stack can't be allocated
+	FiberTestData data;
+	Fiber fiber(&FiberTestEntryPoint, &data, SIZE_MAX / 2);
+	CHECK_FALSE(fiber.IsValid());
+
+	Fiber threadFiber;
+	CHECK(threadFiber.IsValid());
+}
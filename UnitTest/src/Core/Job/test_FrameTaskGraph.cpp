@@ -0,0 +1,106 @@
+#include "stdafx.h"
+#include "Engine/Core/Job/FrameTaskGraph.h"
+
+#include "Engine/Core/Job/JobSystem.h"
+
+TEST_CASE("FrameTaskGraph", "[Core]")
+{
+	constexpr FrameTaskGraph::ResourceMask_t kResourceA = FrameTaskGraph::USER_RESOURCE << 0;
+	constexpr FrameTaskGraph::ResourceMask_t kResourceB = FrameTaskGraph::USER_RESOURCE << 1;
+
+	FrameTaskGraph taskGraph;
+	std::atomic<uint32_t> values[4] = {};
+
+	SECTION("Dependencies")
+	{
+		const auto emptyFunc = []() {};
+		const uint32_t writeA = taskGraph.AddStage("WriteA", 0, kResourceA, emptyFunc);
+		const uint32_t writeB = taskGraph.AddStage("WriteB", 0, kResourceB, emptyFunc);
+		const uint32_t readA1 = taskGraph.AddStage("ReadA1", kResourceA, 0, emptyFunc);
+		const uint32_t readA2 = taskGraph.AddStage("ReadA2", kResourceA, 0, emptyFunc);
+		const uint32_t writeAB = taskGraph.AddStage("WriteAB", kResourceB, kResourceA, emptyFunc);
+		taskGraph.Execute(nullptr);
+
+		CHECK(taskGraph.GetNumStages() == 5);
+		CHECK(taskGraph.GetStageName(writeAB) == "WriteAB");
+		CHECK(taskGraph.GetStageDependencies(writeA).IsEmpty());
+		CHECK(taskGraph.GetStageDependencies(writeB).IsEmpty());
+
+		// Readers of the same resource don't depend on each other
+		const Array<uint32_t>& readA1Dependencies = taskGraph.GetStageDependencies(readA1);
+		REQUIRE(readA1Dependencies.Size() == 1);
+		CHECK(readA1Dependencies[0] == writeA);
+		const Array<uint32_t>& readA2Dependencies = taskGraph.GetStageDependencies(readA2);
+		REQUIRE(readA2Dependencies.Size() == 1);
+		CHECK(readA2Dependencies[0] == writeA);
+
+		// The writer waits for all the readers, the dependency on the first writer is implied by them
+		const Array<uint32_t>& writeABDependencies = taskGraph.GetStageDependencies(writeAB);
+		CHECK(writeABDependencies.Size() == 3);
+		CHECK(writeABDependencies.Find(readA1) != SIZE_MAX);
+		CHECK(writeABDependencies.Find(readA2) != SIZE_MAX);
+		CHECK(writeABDependencies.Find(writeB) != SIZE_MAX);
+		CHECK(writeABDependencies.Find(writeA) == SIZE_MAX);
+	}
+
+	SECTION("Execute()")
+	{
+		const uint32_t numWorkerThreads = GENERATE(0, 3);
+		JobSystem jobSystem(numWorkerThreads);
+
+		std::atomic<uint32_t> mainThreadStageThreadIdx = UINT32_MAX;
+		taskGraph.AddStage("Stage0", 0, kResourceA, [&values]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			values[0] = 1;
+		});
+		taskGraph.AddStage("Stage1", 0, kResourceB, [&values]()
+		{
+			values[1] = 1;
+		});
+		taskGraph.AddMainThreadStage("Stage2", kResourceA | kResourceB, 0, [&values, &mainThreadStageThreadIdx]()
+		{
+			mainThreadStageThreadIdx = JobSystem::GetCurrentThreadIdx();
+			values[2] = values[0] + values[1];
+		});
+		taskGraph.AddStage("Stage3", kResourceA, kResourceB, [&values]()
+		{
+			values[3] = values[2] + 1;
+		});
+
+		uint32_t numCriticalPathCallbacks = 0;
+		taskGraph.SetCriticalPathCallback([&numCriticalPathCallbacks](const FrameTaskGraph& taskGraph)
+		{
+			CHECK(taskGraph.GetCriticalPath().Size() == 3);
+			CHECK(taskGraph.GetCriticalPath().GetLast().stageIdx == 3);
+			numCriticalPathCallbacks++;
+		});
+
+		for(uint32_t frame = 0; frame < 10; ++frame)
+		{
+			for(std::atomic<uint32_t>& value : values)
+			{
+				value = 0;
+			}
+
+			taskGraph.Execute(&jobSystem);
+			CHECK(values[2] == 2);
+			CHECK(values[3] == 3);
+			CHECK(mainThreadStageThreadIdx == 0);
+		}
+
+		CHECK(numCriticalPathCallbacks == 10);
+
+		const Array<FrameTaskGraph::StageTiming>& criticalPath = taskGraph.GetCriticalPath();
+		REQUIRE(criticalPath.Size() == 3);
+		CHECK(criticalPath[1].stageIdx == 2);
+		CHECK(criticalPath[2].stageIdx == 3);
+		CHECK(taskGraph.GetFrameDuration() >= 1000);
+		if(numWorkerThreads > 0)
+		{
+			// The critical path goes through the slow stage when the first two stages are running concurrently
+			CHECK(criticalPath[0].stageIdx == 0);
+			CHECK(criticalPath[0].duration >= 1000);
+		}
+	}
+}
@@ -0,0 +1,187 @@
+#include "stdafx.h"
+#include "Engine/Core/Job/JobSystem.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+TEST_CASE("JobSystem", "[Core]")
+{
+	const bool isFiberModeEnabled = GENERATE(false, true);
+	JobSystem jobSystem(3, isFiberModeEnabled);
+	CHECK(jobSystem.GetNumThreads() == 4);
+	CHECK(JobSystem::GetCurrentThreadIdx() == 0);
+
+	SECTION("Run() | WaitForCounter()")
+	{
+		std::atomic<uint32_t> numExecutedJobs = 0;
+		JobCounter counter;
+		for(uint32_t i = 0; i < 1000; ++i)
+		{
+			jobSystem.Run([&numExecutedJobs]()
+			{
+				numExecutedJobs++;
+			}, &counter);
+		}
+
+		jobSystem.WaitForCounter(counter);
+		CHECK(counter.IsDone());
+		CHECK(numExecutedJobs == 1000);
+	}
+
+	SECTION("Nested jobs")
+	{
+		std::atomic<uint32_t> numExecutedJobs = 0;
+		JobCounter counter;
+		for(uint32_t i = 0; i < 10; ++i)
+		{
+			jobSystem.Run([&jobSystem, &numExecutedJobs]()
+			{
+				JobCounter innerCounter;
+				for(uint32_t j = 0; j < 10; ++j)
+				{
+					jobSystem.Run([&numExecutedJobs]()
+					{
+						numExecutedJobs++;
+					}, &innerCounter);
+				}
+
+				// Waiting inside a job has to execute other jobs instead of blocking the worker
+				jobSystem.WaitForCounter(innerCounter);
+			}, &counter);
+		}
+
+		jobSystem.WaitForCounter(counter);
+		CHECK(numExecutedJobs == 100);
+	}
+
+	SECTION("WaitForCounter() inside jobs")
+	{
+		// More jobs are waiting at the same time than the number of fibers in the pool
+		constexpr uint32_t kNumJobs = 200;
+		std::atomic<uint32_t> numExecutedInnerJobs = 0;
+		std::atomic<uint32_t> numResumedJobs = 0;
+		JobCounter counter;
+		for(uint32_t i = 0; i < kNumJobs; ++i)
+		{
+			jobSystem.Run([&jobSystem, &numExecutedInnerJobs, &numResumedJobs, i]()
+			{
+				const uint32_t threadIdx = JobSystem::GetCurrentThreadIdx();
+
+				JobCounter innerCounter;
+				jobSystem.Run([&numExecutedInnerJobs]()
+				{
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+					numExecutedInnerJobs++;
+				}, &innerCounter);
+
+				jobSystem.WaitForCounter(innerCounter);
+
+				// The job continues on the same thread, so its thread-local state is kept
+				if(innerCounter.IsDone() && i < kNumJobs && JobSystem::GetCurrentThreadIdx() == threadIdx)
+				{
+					numResumedJobs++;
+				}
+			}, &counter);
+		}
+
+		jobSystem.WaitForCounter(counter);
+		CHECK(numExecutedInnerJobs == kNumJobs);
+		CHECK(numResumedJobs == kNumJobs);
+	}
+
+	SECTION("WaitForCounter() inside jobs keeps the memory scopes")
+	{
+		// All the jobs wait for the same counter, so the suspended ones are interleaved on the threads
+		std::atomic<bool> isGateOpen = false;
+		JobCounter gateCounter;
+		jobSystem.Run([&isGateOpen]()
+		{
+			while(!isGateOpen)
+			{
+				std::this_thread::yield();
+			}
+		}, &gateCounter);
+
+		// Without fibers the waiting jobs are nested on the stacks of the threads, so there are fewer than the max depth of the scopes
+		constexpr uint32_t kNumJobs = 12;
+		std::atomic<uint32_t> numJobsWithOwnMemoryTag = 0;
+		JobCounter counter;
+		for(uint32_t i = 0; i < kNumJobs; ++i)
+		{
+			jobSystem.Run([&jobSystem, &gateCounter, &numJobsWithOwnMemoryTag, i]()
+			{
+				const EMemoryTag memoryTag = (i % 2 == 0) ? EMemoryTag::Physics : EMemoryTag::Render;
+				DESIRE_MEMORY_TAG_SCOPE(memoryTag);
+
+				jobSystem.WaitForCounter(gateCounter);
+
+				if(MemorySystem::GetActiveMemoryTag() == memoryTag)
+				{
+					numJobsWithOwnMemoryTag++;
+				}
+			}, &counter);
+		}
+
+		// Let the worker threads start the jobs before the main thread joins in
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		isGateOpen = true;
+
+		jobSystem.WaitForCounter(counter);
+		CHECK(numJobsWithOwnMemoryTag == kNumJobs);
+		CHECK(MemorySystem::GetActiveMemoryTag() == EMemoryTag::Untagged);
+	}
+
+	SECTION("RunAfter()")
+	{
+		std::atomic<uint32_t> value = 0;
+		std::atomic<uint32_t> valueBeforeSecondJob = 0;
+		JobCounter firstCounter;
+		JobCounter secondCounter;
+		jobSystem.Run([&value]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			value = 1;
+		}, &firstCounter);
+
+		jobSystem.RunAfter(firstCounter, [&value, &valueBeforeSecondJob]()
+		{
+			valueBeforeSecondJob = value.load();
+			value = 2;
+		}, &secondCounter);
+
+		jobSystem.WaitForCounter(secondCounter);
+		CHECK(firstCounter.IsDone());
+		CHECK(valueBeforeSecondJob == 1);
+		CHECK(value == 2);
+
+		// The dependency is already done so the job can run immediately
+		jobSystem.RunAfter(firstCounter, [&value]()
+		{
+			value = 3;
+		}, &secondCounter);
+
+		jobSystem.WaitForCounter(secondCounter);
+		CHECK(value == 3);
+	}
+
+	SECTION("Run() from an other thread")
+	{
+		std::atomic<uint32_t> numExecutedJobs = 0;
+		uint32_t otherThreadIdx = 0;
+		JobCounter counter;
+		std::thread thread([&jobSystem, &numExecutedJobs, &otherThreadIdx, &counter]()
+		{
+			otherThreadIdx = JobSystem::GetCurrentThreadIdx();
+			for(uint32_t i = 0; i < 100; ++i)
+			{
+				jobSystem.Run([&numExecutedJobs]()
+				{
+					numExecutedJobs++;
+				}, &counter);
+			}
+		});
+		thread.join();
+		CHECK(otherThreadIdx == UINT32_MAX);
+
+		jobSystem.WaitForCounter(counter);
+		CHECK(numExecutedJobs == 100);
+	}
+}
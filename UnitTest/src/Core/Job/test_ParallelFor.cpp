@@ -0,0 +1,162 @@
+#include "stdafx.h"
+#include "Engine/Core/Job/ParallelFor.h"
+#include "Engine/Core/Job/JobSystem.h"
+
+TEST_CASE("ParallelFor", "[Core]")
+{
+	Modules::JobSystem = std::make_unique<JobSystem>(3);
+
+	Array<uint32_t> values;
+	values.SetSize(100000);
+	for(size_t i = 0; i < values.Size(); ++i)
+	{
+		values[i] = static_cast<uint32_t>(i);
+	}
+
+	SECTION("ParallelFor()")
+	{
+		ParallelFor(values, 64, [](uint32_t& value)
+		{
+			value *= 2;
+		});
+
+		bool allElementsProcessedOnce = true;
+		for(size_t i = 0; i < values.Size(); ++i)
+		{
+			allElementsProcessedOnce &= (values[i] == i * 2);
+		}
+		CHECK(allElementsProcessedOnce);
+	}
+
+	SECTION("ParallelFor() serial fallback")
+	{
+		Array<uint32_t> smallArray = { 1, 2, 3 };
+		std::atomic<uint32_t> numElementsOnOtherThreads = 0;
+		ParallelFor(smallArray, 1024, [&numElementsOnOtherThreads](uint32_t& value)
+		{
+			if(JobSystem::GetCurrentThreadIdx() != 0)
+			{
+				numElementsOnOtherThreads++;
+			}
+			value++;
+		});
+
+		CHECK(numElementsOnOtherThreads == 0);
+		CHECK(smallArray[0] == 2);
+		CHECK(smallArray[1] == 3);
+		CHECK(smallArray[2] == 4);
+	}
+
+	SECTION("ParallelReduce()")
+	{
+		const uint64_t sum = ParallelReduce<uint64_t>(values, 64, 0, [](uint32_t value)
+		{
+			return static_cast<uint64_t>(value);
+		}, [](uint64_t a, uint64_t b)
+		{
+			return a + b;
+		});
+		CHECK(sum == static_cast<uint64_t>(values.Size()) * (values.Size() - 1) / 2);
+
+		const uint32_t maxValue = ParallelReduce<uint32_t>(values, 64, 0, [](uint32_t value)
+		{
+			return value;
+		}, [](uint32_t a, uint32_t b)
+		{
+			return std::max(a, b);
+		});
+		CHECK(maxValue == values.Size() - 1);
+
+		Array<uint32_t> emptyArray;
+		CHECK(ParallelReduce<uint32_t>(emptyArray, 64, 123, [](uint32_t value) { return value; }, [](uint32_t a, uint32_t b) { return a + b; }) == 123);
+	}
+
+	SECTION("ParallelReduce() is deterministic")
+	{
+		// The float sum depends on the order of the additions, so the chunks have to be the same for any number of threads
+		const auto sumFunc = [&values]()
+		{
+			return ParallelReduce<float>(values, 1000, 0.0f, [](uint32_t value)
+			{
+				return 1.0f / (1.0f + static_cast<float>(value));
+			}, [](float a, float b)
+			{
+				return a + b;
+			});
+		};
+
+		const float sum = sumFunc();
+
+		Modules::JobSystem = nullptr;
+		Modules::JobSystem = std::make_unique<JobSystem>(7);
+		const float sumWithMoreThreads = sumFunc();
+
+		Modules::JobSystem = nullptr;
+		const float sumWithoutJobSystem = sumFunc();
+
+		CHECK(memcmp(&sum, &sumWithMoreThreads, sizeof(float)) == 0);
+		CHECK(memcmp(&sum, &sumWithoutJobSystem, sizeof(float)) == 0);
+	}
+
+	Modules::JobSystem = nullptr;
+}
+
+TEST_CASE("ParallelFor benchmark", "[Core][!benchmark]")
+{
+	Modules::JobSystem = std::make_unique<JobSystem>();
+
+	const auto updateFunc = [](float& value)
+	{
+		value = std::sqrt(value * value + 1.0f) * 0.5f;
+	};
+
+	const auto mapFunc = [](float value)
+	{
+		return std::sqrt(value) * 0.5f;
+	};
+
+	const auto reduceFunc = [](float a, float b)
+	{
+		return a + b;
+	};
+
+	for(size_t numElements : { 10000, 100000, 1000000 })
+	{
+		Array<float> values;
+		values.SetSize(numElements);
+		for(size_t i = 0; i < numElements; ++i)
+		{
+			values[i] = static_cast<float>(i);
+		}
+
+		BENCHMARK("Serial for " + std::to_string(numElements))
+		{
+			for(float& value : values)
+			{
+				updateFunc(value);
+			}
+		};
+
+		BENCHMARK("ParallelFor " + std::to_string(numElements))
+		{
+			ParallelFor(values, 1024, updateFunc);
+		};
+
+		BENCHMARK("Serial reduce " + std::to_string(numElements))
+		{
+			float result = 0.0f;
+			for(float value : values)
+			{
+				result = reduceFunc(result, mapFunc(value));
+			}
+			return result;
+		};
+
+		BENCHMARK("ParallelReduce " + std::to_string(numElements))
+		{
+			return ParallelReduce<float>(values, 1024, 0.0f, mapFunc, reduceFunc);
+		};
+	}
+
+	Modules::JobSystem = nullptr;
+}
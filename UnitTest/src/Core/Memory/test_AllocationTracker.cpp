@@ -0,0 +1,108 @@
+#include "stdafx.h"
+#include "Engine/Core/Memory/AllocationTracker.h"
+
+#include "Engine/Core/Memory/MemorySystem.h"
+
+static uint64_t GetLiveBytesOfCallSitesWithAtLeast(uint64_t numLiveAllocations)
+{
+	uint64_t liveBytes = 0;
+	for(const AllocationTracker::CallSite& callSite : AllocationTracker::GetLeakedCallSites())
+	{
+		if(callSite.numLiveAllocations >= numLiveAllocations)
+		{
+			liveBytes += callSite.liveBytes;
+		}
+	}
+
+	return liveBytes;
+}
+
+TEST_CASE("AllocationTracker", "[Core][memory]")
+{
+	constexpr size_t kNumAllocations = 1000;
+	constexpr size_t kAllocationSize = 48;
+
+	AllocationTracker::SetSamplingRate(1);
+	CHECK(AllocationTracker::GetSamplingRate() == 1);
+
+	void* allocations[kNumAllocations] = {};
+	for(void*& ptr : allocations)
+	{
+		ptr = MemorySystem::Alloc(kAllocationSize);
+	}
+
+	SECTION("Leak report")
+	{
+		const Array<AllocationTracker::CallSite> callSites = AllocationTracker::GetLeakedCallSites();
+		REQUIRE(!callSites.IsEmpty());
+		CHECK(callSites[0].numFrames > 0);
+		CHECK(GetLiveBytesOfCallSitesWithAtLeast(kNumAllocations) >= kNumAllocations * kAllocationSize);
+
+		// Realloc moves the allocation to its own call site
+		const uint64_t liveBytesBeforeRealloc = GetLiveBytesOfCallSitesWithAtLeast(1);
+		allocations[0] = MemorySystem::Realloc(allocations[0], 2 * kAllocationSize);
+		CHECK(GetLiveBytesOfCallSitesWithAtLeast(kNumAllocations - 1) >= (kNumAllocations - 1) * kAllocationSize);
+		CHECK(GetLiveBytesOfCallSitesWithAtLeast(1) >= liveBytesBeforeRealloc + kAllocationSize);
+
+		for(void* ptr : allocations)
+		{
+			MemorySystem::Free(ptr);
+		}
+
+		CHECK(GetLiveBytesOfCallSitesWithAtLeast(kNumAllocations - 1) == 0);
+	}
+
+	SECTION("Churn report")
+	{
+		AllocationTracker::EndFrame();
+
+		const Array<AllocationTracker::CallSite> callSites = AllocationTracker::GetTopCallSitesInLastFrame(3);
+		REQUIRE(!callSites.IsEmpty());
+		CHECK(callSites.Size() <= 3);
+		CHECK(callSites[0].numAllocationsInLastFrame >= kNumAllocations);
+
+		for(void* ptr : allocations)
+		{
+			MemorySystem::Free(ptr);
+		}
+
+		// A frame without allocations
+		AllocationTracker::EndFrame();
+		AllocationTracker::EndFrame();
+		for(const AllocationTracker::CallSite& callSite : AllocationTracker::GetTopCallSitesInLastFrame(3))
+		{
+			CHECK(callSite.numAllocationsInLastFrame < kNumAllocations);
+		}
+	}
+
+	SECTION("Sampling")
+	{
+		for(void* ptr : allocations)
+		{
+			MemorySystem::Free(ptr);
+		}
+
+		AllocationTracker::SetSamplingRate(10);
+		for(void*& ptr : allocations)
+		{
+			ptr = MemorySystem::Alloc(kAllocationSize);
+		}
+
+		uint64_t numSampledAllocations = 0;
+		for(const AllocationTracker::CallSite& callSite : AllocationTracker::GetLeakedCallSites())
+		{
+			numSampledAllocations = std::max(numSampledAllocations, callSite.numLiveAllocations);
+		}
+		CHECK(numSampledAllocations >= kNumAllocations / 10 - 1);
+		CHECK(numSampledAllocations <= kNumAllocations / 10 + 1);
+
+		// The frees of the sampled allocations are found among the not sampled ones
+		for(void* ptr : allocations)
+		{
+			MemorySystem::Free(ptr);
+		}
+		CHECK(GetLiveBytesOfCallSitesWithAtLeast(kNumAllocations / 10 - 1) == 0);
+	}
+
+	AllocationTracker::SetSamplingRate(0);
+}
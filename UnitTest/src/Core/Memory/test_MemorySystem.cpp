@@ -0,0 +1,250 @@
+#include "stdafx.h"
+#include "Engine/Core/Memory/MemorySystem.h"
+
+#include "Engine/Core/Memory/Allocator.h"
+#include "Engine/Core/Memory/LinearAllocator.h"
+
+TEST_CASE("MemorySystem", "[Core][memory]")
+{
+	SECTION("Alloc/Realloc/Free")
+	{
+		const size_t alignment = GENERATE(as<size_t>(), 16, 32, 64, 4096);
+		void* ptr = MemorySystem::Alloc(10, alignment);
+		REQUIRE(ptr != nullptr);
+		CHECK(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+		memcpy(ptr, "0123456789", 10);
+		MemorySystem::Free(ptr);
+
+		ptr = MemorySystem::Alloc(10);
+		memcpy(ptr, "0123456789", 10);
+
+		// Grow beyond the small allocations
+		for(size_t size : { 20, 100, 1000, 10000, 100000 })
+		{
+			ptr = MemorySystem::Realloc(ptr, size);
+			REQUIRE(ptr != nullptr);
+			CHECK(memcmp(ptr, "0123456789", 10) == 0);
+		}
+
+		ptr = MemorySystem::Realloc(ptr, 10);
+		REQUIRE(ptr != nullptr);
+		CHECK(memcmp(ptr, "0123456789", 10) == 0);
+		MemorySystem::Free(ptr);
+	}
+
+	SECTION("Headerless allocations")
+	{
+		// Small allocations from the default allocator don't have a header
+		void* ptr = MemorySystem::Alloc(24);
+		CHECK(MemorySystem::FindHeaderlessAllocator(ptr) == &Allocator::GetDefaultAllocator());
+		CHECK(Allocator::GetDefaultAllocator().GetAllocationSize(ptr) >= 24);
+		MemorySystem::Free(ptr);
+
+		// Large allocations have
+		ptr = MemorySystem::Alloc(100000);
+		CHECK(MemorySystem::FindHeaderlessAllocator(ptr) == nullptr);
+		MemorySystem::Free(ptr);
+
+		// Growing a headerless allocation beyond the size classes moves it to an allocation with header
+		const size_t maxSizeWithoutHeader = Allocator::GetDefaultAllocator().GetMaxSizeWithoutHeader();
+		ptr = MemorySystem::Alloc(maxSizeWithoutHeader);
+		CHECK(Allocator::GetDefaultAllocator().IsAllocationWithoutHeader(ptr));
+		ptr = MemorySystem::Realloc(ptr, maxSizeWithoutHeader + 1);
+		CHECK(MemorySystem::FindHeaderlessAllocator(ptr) == nullptr);
+		ptr = MemorySystem::Realloc(ptr, maxSizeWithoutHeader);
+		CHECK(Allocator::GetDefaultAllocator().IsAllocationWithoutHeader(ptr));
+		MemorySystem::Free(ptr);
+
+		// As well as the ones from allocators which don't support it
+		uint8_t memory[1024];
+		LinearAllocator linearAllocator(memory, sizeof(memory));
+		{
+			DESIRE_ALLOCATOR_SCOPE(linearAllocator);
+			ptr = MemorySystem::Alloc(24);
+			CHECK(MemorySystem::FindHeaderlessAllocator(ptr) == nullptr);
+			CHECK(linearAllocator.GetAllocatedBytes() == 24 + MemorySystem::kDefaultAlignment);
+			MemorySystem::Free(ptr);
+		}
+	}
+
+	SECTION("Fallback allocations with header on headerless pages")
+	{
+		// The exhausted linear allocator falls back to the default allocator which puts the memory on its headerless pages
+		uint8_t memory[64];
+		LinearAllocator linearAllocator(memory, sizeof(memory));
+		{
+			DESIRE_ALLOCATOR_SCOPE(linearAllocator);
+			void* ptr = MemorySystem::Alloc(100);
+			REQUIRE(ptr != nullptr);
+			CHECK_FALSE(linearAllocator.IsMemoryFromThis(ptr));
+			CHECK(MemorySystem::FindHeaderlessAllocator(ptr) == &Allocator::GetDefaultAllocator());
+			MemorySystem::Free(ptr);
+		}
+
+		// The freed block must not be reused from the middle by the headerless allocations of the same size class
+		uint8_t* ptr1 = static_cast<uint8_t*>(MemorySystem::Alloc(120));
+		uint8_t* ptr2 = static_cast<uint8_t*>(MemorySystem::Alloc(120));
+		REQUIRE(ptr1 != nullptr);
+		REQUIRE(ptr2 != nullptr);
+		CHECK((ptr1 + 120 <= ptr2 || ptr2 + 120 <= ptr1));
+		MemorySystem::Free(ptr1);
+		MemorySystem::Free(ptr2);
+	}
+
+	SECTION("RegisterHeaderlessPages()")
+	{
+		uint8_t memory[1024];
+		LinearAllocator allocator(memory, sizeof(memory));
+		void* pPages = MemorySystem::SystemAlignedAlloc(2 * MemorySystem::kHeaderlessPageSize, MemorySystem::kHeaderlessPageSize);
+		uint8_t* pData = static_cast<uint8_t*>(pPages);
+
+		MemorySystem::RegisterHeaderlessPages(pPages, 2 * MemorySystem::kHeaderlessPageSize, allocator);
+		CHECK(MemorySystem::FindHeaderlessAllocator(pData) == &allocator);
+		CHECK(MemorySystem::FindHeaderlessAllocator(pData + 2 * MemorySystem::kHeaderlessPageSize - 1) == &allocator);
+		CHECK(MemorySystem::FindHeaderlessAllocator(pData + 2 * MemorySystem::kHeaderlessPageSize) != &allocator);
+
+		MemorySystem::UnregisterHeaderlessPages(pPages, 2 * MemorySystem::kHeaderlessPageSize);
+		CHECK(MemorySystem::FindHeaderlessAllocator(pData) == nullptr);
+		MemorySystem::SystemAlignedFree(pPages);
+	}
+}
+
+TEST_CASE("MemorySystem memory tags", "[Core][memory]")
+{
+	CHECK(MemorySystem::GetActiveMemoryTag() == EMemoryTag::Untagged);
+	{
+		DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Physics);
+		CHECK(MemorySystem::GetActiveMemoryTag() == EMemoryTag::Physics);
+		{
+			DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Render);
+			CHECK(MemorySystem::GetActiveMemoryTag() == EMemoryTag::Render);
+		}
+		CHECK(MemorySystem::GetActiveMemoryTag() == EMemoryTag::Physics);
+	}
+	CHECK(MemorySystem::GetActiveMemoryTag() == EMemoryTag::Untagged);
+	CHECK(strcmp(MemorySystem::GetMemoryTagName(EMemoryTag::Physics), "Physics") == 0);
+
+	MemorySystem::SampleMemoryTagStats();
+	const MemorySystem::MemoryTagStats statsBefore = MemorySystem::GetMemoryTagStats(EMemoryTag::Network);
+
+	// Small and large allocations on this thread and one freed on an other thread
+	void* pSmall = nullptr;
+	void* pLarge = nullptr;
+	void* pFreedOnOtherThread = nullptr;
+	{
+		DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Network);
+		pSmall = MemorySystem::Alloc(100);
+		pLarge = MemorySystem::Alloc(100000);
+		pFreedOnOtherThread = MemorySystem::Alloc(200);
+	}
+	std::thread([pFreedOnOtherThread]()
+	{
+		MemorySystem::Free(pFreedOnOtherThread);
+	}).join();
+
+	MemorySystem::SampleMemoryTagStats();
+	const MemorySystem::MemoryTagStats& stats = MemorySystem::GetMemoryTagStats(EMemoryTag::Network);
+	CHECK(stats.liveBytes - statsBefore.liveBytes >= 100 + 100000);
+	CHECK(stats.liveBytes - statsBefore.liveBytes < 200 + 100 + 100000);
+	CHECK(stats.peakBytes >= stats.liveBytes);
+	CHECK(stats.numLiveAllocations - statsBefore.numLiveAllocations == 2);
+	CHECK(stats.numAllocationsInLastFrame == 3);
+	CHECK(stats.allocatedBytesInLastFrame >= 200 + 100 + 100000);
+
+	// The frees are counted for the original tag
+	MemorySystem::Free(pSmall);
+	MemorySystem::Free(pLarge);
+
+	const MemorySystem::MemoryTagStats* pCallbackStats = nullptr;
+	MemorySystem::SetMemoryTagStatsCallback([&pCallbackStats](const MemorySystem::MemoryTagStats* pStats)
+	{
+		pCallbackStats = pStats;
+	});
+	MemorySystem::SampleMemoryTagStats();
+	MemorySystem::SetMemoryTagStatsCallback(nullptr);
+
+	REQUIRE(pCallbackStats != nullptr);
+	CHECK(pCallbackStats[static_cast<size_t>(EMemoryTag::Network)].liveBytes == statsBefore.liveBytes);
+	CHECK(pCallbackStats[static_cast<size_t>(EMemoryTag::Network)].numAllocationsInLastFrame == 0);
+	CHECK(pCallbackStats[static_cast<size_t>(EMemoryTag::Network)].peakBytes == stats.peakBytes);
+}
+
+TEST_CASE("MemorySystem scratch allocator", "[Core][memory]")
+{
+	Allocator& scratchAllocator = MemorySystem::GetScratchAllocator();
+	void* pMemory = scratchAllocator.Alloc(100);
+	CHECK(scratchAllocator.GetAllocatedBytes() >= 100);
+
+	// Each thread has its own scratch allocator
+	Allocator* pOtherThreadAllocator = nullptr;
+	std::thread thread([&pOtherThreadAllocator]()
+	{
+		pOtherThreadAllocator = &MemorySystem::GetScratchAllocator();
+		pOtherThreadAllocator->Alloc(100);
+	});
+	thread.join();
+	CHECK(pOtherThreadAllocator != &scratchAllocator);
+
+	const MemorySystem::ScratchAllocatorStats stats = MemorySystem::GetScratchAllocatorStats();
+	CHECK(stats.numThreads >= 1);
+	CHECK(stats.highWaterMark >= 100);
+	CHECK(stats.committedBytes >= 100);
+	CHECK(stats.reservedBytes >= stats.committedBytes);
+
+	// The reset happens on the next access
+	MemorySystem::ResetScratchAllocator();
+	CHECK(scratchAllocator.GetAllocatedBytes() != 0);
+	CHECK(&MemorySystem::GetScratchAllocator() == &scratchAllocator);
+	CHECK(scratchAllocator.GetAllocatedBytes() == 0);
+
+	// Freeing on an other thread is ignored
+	void* pOtherMemory = scratchAllocator.Alloc(100);
+	std::thread([&scratchAllocator, pOtherMemory]()
+	{
+		scratchAllocator.Free(pOtherMemory, 100);
+	}).join();
+	CHECK(scratchAllocator.GetAllocatedBytes() >= 100);
+
+	scratchAllocator.Free(pOtherMemory, 100);
+	scratchAllocator.Free(pMemory, 100);
+}
+
+TEST_CASE("MemorySystem frame allocator", "[Core][memory]")
+{
+	Allocator& frameAllocator = MemorySystem::GetFrameAllocator();
+	char* pData = static_cast<char*>(frameAllocator.Alloc(100));
+	memcpy(pData, "frame data", 11);
+	CHECK(frameAllocator.GetAllocatedBytes() >= 100);
+
+	// The allocations survive until the frame gets reused
+	for(uint32_t i = 1; i < MemorySystem::kNumFrameAllocatorBuffers; ++i)
+	{
+		MemorySystem::AdvanceFrameAllocator();
+		Allocator& otherFrameAllocator = MemorySystem::GetFrameAllocator();
+		CHECK(&otherFrameAllocator != &frameAllocator);
+		otherFrameAllocator.Alloc(1000);
+		CHECK(frameAllocator.GetAllocatedBytes() >= 100);
+		CHECK(strcmp(pData, "frame data") == 0);
+	}
+
+	const MemorySystem::ScratchAllocatorStats stats = MemorySystem::GetFrameAllocatorStats();
+	CHECK(stats.numThreads >= 1);
+	CHECK(stats.highWaterMark >= 1000);
+
+	// The reset happens on the next access
+	MemorySystem::AdvanceFrameAllocator();
+	CHECK(frameAllocator.GetAllocatedBytes() != 0);
+	CHECK(&MemorySystem::GetFrameAllocator() == &frameAllocator);
+	CHECK(frameAllocator.GetAllocatedBytes() == 0);
+
+	// Skipping frames resets all the buffers which were reused in between
+	frameAllocator.Alloc(100);
+	const uint64_t frameIdx = MemorySystem::GetFrameAllocatorFrameIdx();
+	for(uint32_t i = 0; i < 2 * MemorySystem::kNumFrameAllocatorBuffers; ++i)
+	{
+		MemorySystem::AdvanceFrameAllocator();
+	}
+	CHECK(MemorySystem::GetFrameAllocatorFrameIdx() == frameIdx + 2 * MemorySystem::kNumFrameAllocatorBuffers);
+	CHECK(&MemorySystem::GetFrameAllocator() == &frameAllocator);
+	CHECK(frameAllocator.GetAllocatedBytes() == 0);
+}
@@ -0,0 +1,159 @@
+#include "stdafx.h"
+#include "Engine/Core/Memory/PagedPoolAllocator.h"
+
+struct PoolTestElement
+{
+	PoolTestElement(uint32_t value)
+		: value(value)
+	{
+		s_numInstances++;
+	}
+
+	~PoolTestElement()
+	{
+		s_numInstances--;
+	}
+
+	uint32_t value;
+	uint8_t padding[60];
+
+	static int32_t s_numInstances;
+};
+
+int32_t PoolTestElement::s_numInstances = 0;
+
+TEST_CASE("PagedPoolAllocator", "[Core][memory]")
+{
+	using Pool = PagedPoolAllocator<PoolTestElement>;
+	const uint32_t kNumElementsPerPage = Pool::GetNumElementsPerPage();
+
+	SECTION("Create() | Destroy() | Get()")
+	{
+		Pool pool;
+		CHECK(pool.Size() == 0);
+		CHECK(pool.GetNumPages() == 0);
+
+		Pool::Handle handle = pool.Create(123u);
+		CHECK(pool.Size() == 1);
+		CHECK(pool.GetNumPages() == 1);
+		REQUIRE(pool.Get(handle) != nullptr);
+		CHECK(pool.Get(handle)->value == 123);
+		CHECK(PoolTestElement::s_numInstances == 1);
+
+		pool.Destroy(handle);
+		CHECK(pool.Get(handle) == nullptr);
+		CHECK_FALSE(pool.IsValid(handle));
+		CHECK(PoolTestElement::s_numInstances == 0);
+		CHECK(pool.GetNumPages() == 1);
+
+		CHECK_FALSE(pool.IsValid(Pool::Handle()));
+	}
+
+	SECTION("Stale handles")
+	{
+		Pool pool;
+		Pool::Handle handle1 = pool.Create(1u);
+		Pool::Handle handle2 = pool.Create(2u);
+		pool.Destroy(handle1);
+
+		// The slot is reused with a new generation
+		Pool::Handle handle3 = pool.Create(3u);
+		CHECK(handle3.index == handle1.index);
+		CHECK(handle3 != handle1);
+		CHECK(pool.Get(handle1) == nullptr);
+		CHECK(pool.Get(handle3)->value == 3);
+
+		// The empty page is kept and reused
+		pool.Destroy(handle2);
+		pool.Destroy(handle3);
+		CHECK(pool.GetNumPages() == 1);
+		Pool::Handle handle4 = pool.Create(4u);
+		CHECK(pool.Get(handle1) == nullptr);
+		CHECK(pool.Get(handle2) == nullptr);
+		CHECK(pool.Get(handle3) == nullptr);
+		CHECK(pool.Get(handle4)->value == 4);
+	}
+
+	SECTION("Growing and shrinking")
+	{
+		Pool pool;
+		std::vector<Pool::Handle> handles;
+		for(uint32_t i = 0; i < 3 * kNumElementsPerPage; ++i)
+		{
+			handles.push_back(pool.Create(i));
+		}
+		CHECK(pool.Size() == 3 * kNumElementsPerPage);
+		CHECK(pool.GetNumPages() == 3);
+
+		// The elements don't move when the pool grows
+		bool isDataValid = true;
+		for(uint32_t i = 0; i < handles.size(); ++i)
+		{
+			isDataValid &= (pool.Get(handles[i])->value == i);
+		}
+		CHECK(isDataValid);
+
+		// Empty the middle page (it is kept as it is the only empty one)
+		for(uint32_t i = kNumElementsPerPage; i < 2 * kNumElementsPerPage; ++i)
+		{
+			pool.Destroy(handles[i]);
+		}
+		CHECK(pool.GetNumPages() == 3);
+
+		// Free one slot from the first page, new elements fill the holes from the beginning
+		pool.Destroy(handles[5]);
+		Pool::Handle handle = pool.Create(5u);
+		CHECK(handle.index == handles[5].index);
+		handle = pool.Create(1000u);
+		CHECK(handle.index == kNumElementsPerPage);
+		CHECK(pool.GetNumPages() == 3);
+
+		uint32_t numElements = 0;
+		pool.ForEach([&numElements](PoolTestElement& /*element*/)
+		{
+			numElements++;
+		});
+		CHECK(numElements == pool.Size());
+	}
+
+	SECTION("Empty page is kept")
+	{
+		Pool pool;
+		std::vector<Pool::Handle> handles;
+		for(uint32_t i = 0; i < kNumElementsPerPage; ++i)
+		{
+			handles.push_back(pool.Create(i));
+		}
+
+		// An element toggling across the page boundary reuses the same page
+		Pool::Handle handle = pool.Create(1000u);
+		const void* pElement = pool.Get(handle);
+		for(uint32_t i = 0; i < 10; ++i)
+		{
+			pool.Destroy(handle);
+			CHECK(pool.GetNumPages() == 2);
+			handle = pool.Create(1000u);
+			CHECK(pool.Get(handle) == pElement);
+		}
+		pool.Destroy(handle);
+
+		// Only one empty page is kept, the others are released
+		for(Pool::Handle& elementHandle : handles)
+		{
+			pool.Destroy(elementHandle);
+		}
+		CHECK(pool.Size() == 0);
+		CHECK(pool.GetNumPages() == 1);
+
+		// The stale handles stay invalid when the released page is created again
+		handles.clear();
+		for(uint32_t i = 0; i < 2 * kNumElementsPerPage; ++i)
+		{
+			handles.push_back(pool.Create(i));
+		}
+		CHECK(pool.GetNumPages() == 2);
+		CHECK(pool.Get(handle) == nullptr);
+	}
+
+	CHECK(PoolTestElement::s_numInstances == 0);
+}
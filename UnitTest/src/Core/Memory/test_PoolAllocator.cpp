@@ -15,21 +15,49 @@ public:
 TEST_CASE("PoolAllocator", "[Core][memory]")
 {
 	PoolAllocator<TestClass, 10> a;
+	CHECK(a.GetNumBlocks() == 1);
 
-	TestClass* tmp[10];
+	TestClass* tmp[20];
 	for(uint32_t i = 0; i < 10; ++i)
 	{
 		tmp[i] = a.Alloc();
 		REQUIRE(tmp[i] != nullptr);
 		CHECK(tmp[i]->value == 123);
+		tmp[i]->value = i;
 	}
+	CHECK(a.GetNumBlocks() == 1);
 
-	TestClass* pElementAllocatedWhenPoolIsEmpty = a.Alloc();
+	// The pool grows by a new block of elements when it is empty
+	for(uint32_t i = 10; i < 20; ++i)
+	{
+		tmp[i] = a.Alloc();
+		REQUIRE(tmp[i] != nullptr);
+		CHECK(tmp[i]->value == 123);
+		tmp[i]->value = i;
+	}
+	CHECK(a.GetNumBlocks() == 2);
+	// The elements are smaller than a pointer, so they are padded to the size of the free list link
+	CHECK(reinterpret_cast<uintptr_t>(tmp[19]) - reinterpret_cast<uintptr_t>(tmp[10]) == 9 * sizeof(void*));
 
-	a.Free(pElementAllocatedWhenPoolIsEmpty);
-	pElementAllocatedWhenPoolIsEmpty = nullptr;
+	bool isDataValid = true;
+	for(uint32_t i = 0; i < 20; ++i)
+	{
+		isDataValid &= (tmp[i]->value == i);
+	}
+	CHECK(isDataValid);
 
-	for(uint32_t i = 0; i < 10; ++i)
+	// The freed elements are reused without growing again
+	for(uint32_t i = 0; i < 20; ++i)
+	{
+		a.Free(tmp[i]);
+	}
+	for(uint32_t i = 0; i < 20; ++i)
+	{
+		tmp[i] = a.Alloc();
+	}
+	CHECK(a.GetNumBlocks() == 2);
+
+	for(uint32_t i = 0; i < 20; ++i)
 	{
 		a.Free(tmp[i]);
 		tmp[i] = nullptr;
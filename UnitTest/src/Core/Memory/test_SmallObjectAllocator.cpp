@@ -0,0 +1,241 @@
+#include "stdafx.h"
+#include "Engine/Core/Memory/SmallObjectAllocator.h"
+
+#include "Engine/Core/Memory/MemorySystem.h"
+
+TEST_CASE("SmallObjectAllocator", "[Core][memory]")
+{
+	SmallObjectAllocator a;
+
+	SECTION("Alloc/Realloc/Free")
+	{
+		const size_t size = GENERATE(1, 16, 17, 100, 1000, SmallObjectAllocator::kMaxSmallObjectSize);
+		void* ptr = a.Alloc(size);
+		REQUIRE(ptr != nullptr);
+		CHECK(reinterpret_cast<uintptr_t>(ptr) % MemorySystem::kDefaultAlignment == 0);
+		memset(ptr, 0xFF, size);
+		CHECK(SmallObjectAllocator::GetBlockSize(size) >= size);
+
+		// The freed block is reused by the next allocation from the same size class
+		a.Free(ptr, size);
+		void* ptr2 = a.Alloc(size);
+		CHECK(ptr2 == ptr);
+
+		// Stays in place when the size class doesn't change
+		const size_t blockSize = SmallObjectAllocator::GetBlockSize(size);
+		void* ptr3 = a.Realloc(ptr2, blockSize, size);
+		CHECK(ptr3 == ptr2);
+		a.Free(ptr3, blockSize);
+	}
+
+	SECTION("AllocWithoutHeader()")
+	{
+		const size_t alignment = GENERATE(as<size_t>(), 16, 32, 64, 128, 1024);
+		void* ptr = a.AllocWithoutHeader(40, alignment);
+		REQUIRE(ptr != nullptr);
+		CHECK(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+		CHECK(a.GetAllocationSize(ptr) >= 40);
+		CHECK(MemorySystem::FindHeaderlessAllocator(ptr) == &a);
+		a.Free(ptr, a.GetAllocationSize(ptr));
+
+		CHECK(a.AllocWithoutHeader(SmallObjectAllocator::kMaxSmallObjectSize + 1, 16) == nullptr);
+		CHECK(a.AllocWithoutHeader(16, 2 * SmallObjectAllocator::kMaxSmallObjectSize) == nullptr);
+	}
+
+	SECTION("Memory tags share the slabs")
+	{
+		void* pPhysicsPtr = nullptr;
+		void* pRenderPtr = nullptr;
+		{
+			DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Physics);
+			pPhysicsPtr = a.AllocWithoutHeader(32, 16);
+		}
+		{
+			DESIRE_MEMORY_TAG_SCOPE(EMemoryTag::Render);
+			pRenderPtr = a.AllocWithoutHeader(32, 16);
+		}
+
+		CHECK(static_cast<uint8_t*>(pRenderPtr) == static_cast<uint8_t*>(pPhysicsPtr) + 32);
+		CHECK(a.GetAllocationTag(pPhysicsPtr) == EMemoryTag::Physics);
+		CHECK(a.GetAllocationTag(pRenderPtr) == EMemoryTag::Render);
+
+		// The tag is updated when the block is reused
+		a.Free(pPhysicsPtr, 32);
+		pPhysicsPtr = a.AllocWithoutHeader(32, 16);
+		CHECK(a.GetAllocationTag(pPhysicsPtr) == EMemoryTag::Untagged);
+
+		a.Free(pPhysicsPtr, 32);
+		a.Free(pRenderPtr, 32);
+	}
+
+	SECTION("Realloc between size classes")
+	{
+		void* ptr = a.Alloc(10);
+		memcpy(ptr, "0123456789", 10);
+
+		ptr = a.Realloc(ptr, 500, 10);
+		REQUIRE(ptr != nullptr);
+		CHECK(memcmp(ptr, "0123456789", 10) == 0);
+
+		// Small to large
+		ptr = a.Realloc(ptr, 4096, 500);
+		REQUIRE(ptr != nullptr);
+		CHECK(memcmp(ptr, "0123456789", 10) == 0);
+
+		ptr = a.Realloc(ptr, 5, 4096);
+		REQUIRE(ptr != nullptr);
+		CHECK(memcmp(ptr, "01234", 5) == 0);
+		a.Free(ptr, 5);
+	}
+
+	SECTION("Large allocations")
+	{
+		void* ptr = a.Alloc(64 * 1024);
+		REQUIRE(ptr != nullptr);
+		memset(ptr, 0xFF, 64 * 1024);
+		CHECK(a.GetAllocatedBytes() >= 64 * 1024);
+		a.Free(ptr, 64 * 1024);
+		CHECK(a.GetAllocatedBytes() == 0);
+	}
+
+	SECTION("Many allocations")
+	{
+		constexpr size_t kNumAllocations = 10000;
+		std::vector<void*> pointers;
+		for(size_t i = 0; i < kNumAllocations; ++i)
+		{
+			const size_t size = 1 + i % SmallObjectAllocator::kMaxSmallObjectSize;
+			void* ptr = a.Alloc(size);
+			REQUIRE(ptr != nullptr);
+			memset(ptr, static_cast<int>(i), size);
+			pointers.push_back(ptr);
+		}
+
+		// Check that the blocks are not overlapping
+		bool isDataValid = true;
+		for(size_t i = 0; i < kNumAllocations; ++i)
+		{
+			const size_t size = 1 + i % SmallObjectAllocator::kMaxSmallObjectSize;
+			const uint8_t* pData = static_cast<const uint8_t*>(pointers[i]);
+			isDataValid &= (pData[0] == static_cast<uint8_t>(i) && pData[size - 1] == static_cast<uint8_t>(i));
+			a.Free(pointers[i], size);
+		}
+		CHECK(isDataValid);
+	}
+
+	SECTION("Free on an other thread")
+	{
+		constexpr size_t kNumAllocations = 1000;
+		std::vector<void*> pointers;
+		for(size_t i = 0; i < kNumAllocations; ++i)
+		{
+			pointers.push_back(a.Alloc(32));
+		}
+
+		std::thread thread([&a, &pointers]()
+		{
+			for(void* ptr : pointers)
+			{
+				a.Free(ptr, 32);
+			}
+		});
+		thread.join();
+
+		// The owner thread gets the blocks back
+		std::vector<void*> newPointers;
+		for(size_t i = 0; i < kNumAllocations; ++i)
+		{
+			newPointers.push_back(a.Alloc(32));
+		}
+		std::sort(pointers.begin(), pointers.end());
+		std::sort(newPointers.begin(), newPointers.end());
+		CHECK(pointers == newPointers);
+
+		for(void* ptr : newPointers)
+		{
+			a.Free(ptr, 32);
+		}
+	}
+
+	SECTION("Heap of an exited thread is adopted")
+	{
+		void* pOtherThreadPtr = nullptr;
+		std::thread([&a, &pOtherThreadPtr]()
+		{
+			pOtherThreadPtr = a.Alloc(48);
+			a.Free(pOtherThreadPtr, 48);
+		}).join();
+
+		void* pNewThreadPtr = nullptr;
+		std::thread([&a, &pNewThreadPtr]()
+		{
+			pNewThreadPtr = a.Alloc(48);
+			a.Free(pNewThreadPtr, 48);
+		}).join();
+
+		CHECK(pNewThreadPtr == pOtherThreadPtr);
+	}
+
+	SECTION("Multiple threads")
+	{
+		constexpr uint32_t kNumThreads = 4;
+		std::atomic<bool> isDataValid = true;
+		std::vector<std::thread> threads;
+		for(uint32_t threadIdx = 0; threadIdx < kNumThreads; ++threadIdx)
+		{
+			threads.emplace_back([&a, &isDataValid, threadIdx]()
+			{
+				std::vector<void*> pointers;
+				for(uint32_t i = 0; i < 10000; ++i)
+				{
+					void* ptr = a.Alloc(64);
+					memset(ptr, static_cast<int>(threadIdx), 64);
+					pointers.push_back(ptr);
+				}
+
+				for(void* ptr : pointers)
+				{
+					if(*static_cast<uint8_t*>(ptr) != threadIdx)
+					{
+						isDataValid = false;
+					}
+					a.Free(ptr, 64);
+				}
+			});
+		}
+
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		CHECK(isDataValid);
+	}
+}
+
+TEST_CASE("SmallObjectAllocator benchmark", "[Core][!benchmark]")
+{
+	constexpr size_t kNumAllocations = 10000;
+
+	SmallObjectAllocator smallObjectAllocator;
+	SystemAllocator systemAllocator;
+	std::vector<void*> pointers(kNumAllocations);
+
+	for(Allocator* pAllocator : { static_cast<Allocator*>(&smallObjectAllocator), static_cast<Allocator*>(&systemAllocator) })
+	{
+		const char* pName = (pAllocator == &smallObjectAllocator) ? "SmallObjectAllocator" : "SystemAllocator";
+
+		BENCHMARK(std::string(pName) + " Alloc/Free")
+		{
+			for(size_t i = 0; i < kNumAllocations; ++i)
+			{
+				pointers[i] = pAllocator->Alloc(16 + i % 256);
+			}
+
+			for(size_t i = 0; i < kNumAllocations; ++i)
+			{
+				pAllocator->Free(pointers[i], 16 + i % 256);
+			}
+			return pointers[0];
+		};
+	}
+}
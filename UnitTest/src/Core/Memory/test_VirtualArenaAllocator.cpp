@@ -0,0 +1,71 @@
+#include "stdafx.h"
+#include "Engine/Core/Memory/VirtualArenaAllocator.h"
+
+#include "Engine/Core/Memory/MemorySystem.h"
+
+TEST_CASE("VirtualArenaAllocator", "[Core][memory]")
+{
+	constexpr size_t kReservedSize = 256 * 1024 * 1024;
+	const bool useHugePages = GENERATE(false, true);
+	VirtualArenaAllocator a(kReservedSize, useHugePages);
+	CHECK(a.GetReservedSize() >= kReservedSize);
+	CHECK(a.GetCommittedSize() == 0);
+
+	SECTION("Alloc/Realloc/Free")
+	{
+		void* ptr = a.Alloc(10);
+		REQUIRE(ptr != nullptr);
+		CHECK(a.IsMemoryFromThis(ptr));
+		memcpy(ptr, "0123456789", 10);
+		CHECK(a.GetAllocatedBytes() == 10);
+		CHECK(a.GetCommittedSize() > 0);
+
+		// The last allocation grows in place even beyond the committed memory
+		void* grownPtr = a.Realloc(ptr, 10 * 1024 * 1024, 10);
+		CHECK(grownPtr == ptr);
+		CHECK(a.GetCommittedSize() >= 10 * 1024 * 1024);
+		memset(static_cast<uint8_t*>(grownPtr) + 10, 0xFF, 10 * 1024 * 1024 - 10);
+		CHECK(memcmp(grownPtr, "0123456789", 10) == 0);
+
+		a.Free(grownPtr, 10 * 1024 * 1024);
+		CHECK(a.GetAllocatedBytes() == 0);
+		CHECK(a.GetHighWaterMark() == 10 * 1024 * 1024);
+	}
+
+	SECTION("Reset()")
+	{
+		for(uint32_t i = 0; i < 100; ++i)
+		{
+			void* ptr = a.Alloc(100 * 1024);
+			REQUIRE(ptr != nullptr);
+			CHECK(reinterpret_cast<uintptr_t>(ptr) % MemorySystem::kDefaultAlignment == 0);
+			memset(ptr, 0xFF, 100 * 1024);
+		}
+		const size_t committedSize = a.GetCommittedSize();
+		CHECK(committedSize >= 100 * 100 * 1024);
+
+		// Keep the committed memory
+		a.Reset(committedSize);
+		CHECK(a.GetAllocatedBytes() == 0);
+		CHECK(a.GetCommittedSize() == committedSize);
+
+		// Decommit down to the given size
+		a.Reset(1024 * 1024);
+		CHECK(a.GetCommittedSize() < committedSize);
+		CHECK(a.GetCommittedSize() >= 1024 * 1024);
+
+		void* ptr = a.Alloc(2 * 1024 * 1024);
+		REQUIRE(ptr != nullptr);
+		memset(ptr, 0xFF, 2 * 1024 * 1024);
+
+		a.Reset();
+		CHECK(a.GetCommittedSize() == 0);
+	}
+
+	SECTION("Allocate the whole reserved range")
+	{
+		VirtualArenaAllocator small(1024);
+		void* ptr = small.Alloc(small.GetReservedSize());
+		CHECK(ptr != nullptr);
+	}
+}
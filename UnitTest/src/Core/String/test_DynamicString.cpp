@@ -59,7 +59,29 @@ TEST_CASE("DynamicString", "[Core]")
 
 	SECTION("Reserve()")
 	{
-		// TODO: Add test cases
+		// Growing beyond the inline storage keeps the content
+		DynamicString s = "short";
+		CHECK(s.Reserve(DynamicString::kInlineSize * 4));
+		CHECK(s.Equals("short"));
+		s += " string which is longer than the inline storage";
+		CHECK(s.Equals("short string which is longer than the inline storage"));
+
+		// Moving a heap allocated string takes over its memory
+		const char* pData = s.Str();
+		DynamicString movedString = std::move(s);
+		CHECK(movedString.Str() == pData);
+		CHECK(s.Equals(""));
+
+		// Moving an inline string copies the characters
+		DynamicString inlineString = "inline";
+		DynamicString movedInlineString = std::move(inlineString);
+		CHECK(movedInlineString.Equals("inline"));
+		CHECK(inlineString.Equals(""));
+
+		movedString.Reset();
+		CHECK(movedString.Equals(""));
+		movedString = "after reset";
+		CHECK(movedString.Equals("after reset"));
 	}
 }
 
@@ -157,6 +179,10 @@ TEST_CASE("WritableString", "[Core]")
 		replaceStr.ReplaceAllChar('b', 'X');
 		CHECK(replaceStr.Equals("aaXXc"));
 
+		DynamicString pathStr = "data\\textures\\environment\\rocks\\granite_01_albedo.png";
+		pathStr.ReplaceAllChar('\\', '/');
+		CHECK(pathStr.Equals("data/textures/environment/rocks/granite_01_albedo.png"));
+
 		// When replacing to the null-character the string has to be truncated
 		string.ReplaceAllChar(' ', '\0');
 		CHECK(string.Length() == 6);
@@ -182,6 +208,16 @@ TEST_CASE("WritableString", "[Core]")
 		CHECK(numberString.Equals("String ASD-1212345-123456789123456789123456789123456789654.321"));
 		numberString += 654.321;
 		CHECK(numberString.Equals("String ASD-1212345-123456789123456789123456789123456789654.321654.321"));
+
+		DynamicString limitsString;
+		limitsString += INT32_MIN;
+		limitsString += UINT64_MAX;
+		limitsString += -0.0005f;
+		CHECK(limitsString.Equals("-214748364818446744073709551615-0.001"));
+
+		limitsString.Clear();
+		limitsString += FLT_MAX;
+		CHECK(limitsString.Equals("340282346638528859811704183484516925440.000"));
 	}
 
 	SECTION("Trim()")
@@ -195,6 +231,14 @@ TEST_CASE("WritableString", "[Core]")
 		trimString.Trim();
 		CHECK(trimString.Equals("ASD"));
 
+		trimString = " \t \r\n                    ASD\t                    \r\n";
+		trimString.Trim();
+		CHECK(trimString.Equals("ASD"));
+
+		trimString = "                    A                    S D                    ";
+		trimString.Trim();
+		CHECK(trimString.Equals("A                    S D"));
+
 		trimString = "   ";
 		trimString.Trim();
 		CHECK(trimString.Equals(""));
@@ -209,6 +253,11 @@ TEST_CASE("WritableString", "[Core]")
 		DynamicString s = "123 ABCDEFGHIJKLMNOPQRSTUVWXYZ !@#";
 		s.ToLower();
 		CHECK(s.Equals("123 abcdefghijklmnopqrstuvwxyz !@#"));
+
+		// Non-ASCII characters are not changed
+		s = u8"@[`{ \u00C1RV\u00CDZT\u0170R\u0150 T\u00DCK\u00D6RF\u00DAR\u00D3G\u00C9P";
+		s.ToLower();
+		CHECK(s.Equals(u8"@[`{ \u00C1rv\u00CDzt\u0170r\u0150 t\u00DCk\u00D6rf\u00DAr\u00D3g\u00C9p"));
 	}
 
 	SECTION("ToUpper()")
@@ -219,6 +268,11 @@ TEST_CASE("WritableString", "[Core]")
 		DynamicString s = "123 abcdefghijklmnopqrstuvwxyz !@#";
 		s.ToUpper();
 		CHECK(s.Equals("123 ABCDEFGHIJKLMNOPQRSTUVWXYZ !@#"));
+
+		// Non-ASCII characters are not changed
+		s = u8"@[`{ \u00E1rv\u00EDzt\u0171r\u0151 t\u00FCk\u00F6rf\u00FAr\u00F3g\u00E9p";
+		s.ToUpper();
+		CHECK(s.Equals(u8"@[`{ \u00E1RV\u00EDZT\u0171R\u0151 T\u00FCK\u00F6RF\u00FAR\u00F3G\u00E9P"));
 	}
 
 	SECTION("AsCharBufferWithSize()")
@@ -255,3 +309,52 @@ TEST_CASE("WritableString", "[Core]")
 		CHECK(string.Equals("String ASD 123 00123 1.5 X test"));
 	}
 }
+
+TEST_CASE("WritableString number append benchmark", "[Core][!benchmark]")
+{
+	constexpr int32_t kNumAppends = 1000;
+
+	BENCHMARK("snprintf() int32_t")
+	{
+		DynamicString string;
+		for(int32_t i = 0; i < kNumAppends; ++i)
+		{
+			char str[10 + 2];
+			const int32_t len = snprintf(str, sizeof(str), "%d", i * 7919);
+			string.Append(String(str, len));
+		}
+		return string.Length();
+	};
+
+	BENCHMARK("operator +=(int32_t)")
+	{
+		DynamicString string;
+		for(int32_t i = 0; i < kNumAppends; ++i)
+		{
+			string += i * 7919;
+		}
+		return string.Length();
+	};
+
+	BENCHMARK("snprintf() float")
+	{
+		DynamicString string;
+		for(int32_t i = 0; i < kNumAppends; ++i)
+		{
+			char str[32];
+			const int32_t len = snprintf(str, sizeof(str), "%.3f", i * 0.37f);
+			string.Append(String(str, len));
+		}
+		return string.Length();
+	};
+
+	BENCHMARK("operator +=(float)")
+	{
+		DynamicString string;
+		for(int32_t i = 0; i < kNumAppends; ++i)
+		{
+			string += i * 0.37f;
+		}
+		return string.Length();
+	};
+}
@@ -0,0 +1,67 @@
+#include "stdafx.h"
+#include "Engine/Core/String/HashedString.h"
+
+#include "Engine/Core/String/String.h"
+
+#define CHECK_SAME_HASH(STR)	CHECK(DESIRE_HASHED_STRING(STR) == HashedString(String(STR, sizeof(STR) - 1)))
+
+// Reference values of XXH64 with seed 0
+#define CHECK_KNOWN_HASH(STR, HASH)														\
+	static_assert(HashedString::Hash64(STR, sizeof(STR) - 1) == HASH);					\
+	CHECK(HashedString(String(STR, sizeof(STR) - 1)).GetHash() == HASH)
+
+TEST_CASE("HashedString", "[Core]")
+{
+	SECTION("Compile-time and runtime hashes are the same")
+	{
+		// Covers all the code paths: the 32 byte stripes, the 8 and 4 byte blocks and the remaining bytes
+		CHECK_SAME_HASH("");
+		CHECK_SAME_HASH("a");
+		CHECK_SAME_HASH("abcd");
+		CHECK_SAME_HASH("abcdefgh");
+		CHECK_SAME_HASH("matWorldViewProj");
+		CHECK_SAME_HASH("0123456789abcdefghijklmnopqrstu");
+		CHECK_SAME_HASH("0123456789abcdefghijklmnopqrstuv");
+		CHECK_SAME_HASH("0123456789abcdefghijklmnopqrstuvwxyz\xC3\xA1\xC3\xA9 ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+	}
+
+	SECTION("Known hashes")
+	{
+		CHECK_KNOWN_HASH("", 0xEF46DB3751D8E999ULL);
+		CHECK_KNOWN_HASH("a", 0xD24EC4F1A98C6E5BULL);
+		CHECK_KNOWN_HASH("abc", 0x44BC2CF5AD770999ULL);
+		CHECK_KNOWN_HASH("abcdefgh", 0x3AD351775B4634B7ULL);
+		CHECK_KNOWN_HASH("matWorldViewProj", 0x7FB7BD6FD1EC301BULL);
+		CHECK_KNOWN_HASH("0123456789abcdefghijklmnopqrstuv", 0xBF7C9DBE16B5C6E2ULL);
+		CHECK_KNOWN_HASH("The quick brown fox jumps over the lazy dog", 0x0B242D361FDA71BCULL);
+	}
+
+	SECTION("Different strings")
+	{
+		CHECK(HashedString("asd") != HashedString("asD"));
+		CHECK(HashedString("asd") == HashedString(String("asd")));
+	}
+
+	SECTION("FromConcatenation()")
+	{
+		// The parts are hashed incrementally, crossing the 32 byte stripes and the 8 byte blocks
+		const String filename = "shaders/sprite_with_normal_map.vert";
+		const String separator = "|";
+		const String defines = "DIFFUSE_TEXTURE;NORMAL_TEXTURE";
+		CHECK(HashedString::FromConcatenation({ &filename, &separator, &defines }) == DESIRE_HASHED_STRING("shaders/sprite_with_normal_map.vert|DIFFUSE_TEXTURE;NORMAL_TEXTURE"));
+		CHECK(HashedString::FromConcatenation({ &filename, &separator, &String::kEmptyString }) == DESIRE_HASHED_STRING("shaders/sprite_with_normal_map.vert|"));
+		CHECK(HashedString::FromConcatenation({ &defines }) == HashedString(defines));
+		CHECK(HashedString::FromConcatenation({}) == DESIRE_HASHED_STRING(""));
+	}
+
+#if DESIRE_HASHED_STRING_INTERNING
+	SECTION("GetDebugString()")
+	{
+		const HashedString hashedString = DESIRE_HASHED_STRING("debug string");
+		REQUIRE(hashedString.GetDebugString() != nullptr);
+		CHECK(strcmp(hashedString.GetDebugString(), "debug string") == 0);
+	}
+#else
+	static_assert(DESIRE_HASHED_STRING("asd") != DESIRE_HASHED_STRING("asD"));
+#endif
+}
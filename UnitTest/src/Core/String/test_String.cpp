@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "Engine/Core/String/String.h"
 
+#include "Engine/Core/String/DynamicString.h"
+
 TEST_CASE("String", "[Core]")
 {
 	const char charSeq[] = "String ASD";
@@ -25,18 +27,59 @@ TEST_CASE("String", "[Core]")
 
 	SECTION("Find()")
 	{
-		DESIRE_TODO("Add test cases");
-//		size_t Find(const String& search, size_t startIndex = 0) const;
-//		size_t Find(const char *search, size_t startIndex = 0) const;
-//		size_t Find(char search, size_t startIndex = 0) const;
+		CHECK(string.Find("ASD") == 7);
+		CHECK(string.Find("S") == 0);
+		CHECK(string.Find("S", 1) == 8);
+		CHECK(string.Find("ASDX") == String::kInvalidPos);
+		CHECK(string.Find("") == String::kInvalidPos);
+		CHECK(string.Find("S", string.Length()) == String::kInvalidPos);
+
+		CHECK(string.Find('S') == 0);
+		CHECK(string.Find('S', 1) == 8);
+		CHECK(string.Find('x') == String::kInvalidPos);
+		CHECK(string.Find('\0') == String::kInvalidPos);
+
+		// Long enough to be processed in multiple blocks
+		String longString = "data/textures/environment/rocks/granite_01_albedo.png";
+		CHECK(longString.Find('/') == 4);
+		CHECK(longString.Find('/', 5) == 13);
+		CHECK(longString.Find('.') == 49);
+		CHECK(longString.Find("granite") == 32);
+		CHECK(longString.Find("albedo.png") == 43);
+		CHECK(longString.Find("o") == 19);
+		CHECK(longString.Find("o", 40) == 48);
+		CHECK(longString.Find("albedo.jpg") == String::kInvalidPos);
+
+		// Stops at the end of the string
+		String stringWithNullSeparator = "Word0\0Word1";
+		CHECK(stringWithNullSeparator.Find('1') == 10);
+		CHECK(stringWithNullSeparator.Find("Word1") == 6);
 	}
 
 	SECTION("FindLast()")
 	{
-		DESIRE_TODO("Add test cases");
-//		size_t FindLast(const String& search) const;
-//		size_t FindLast(const char *search) const;
-//		size_t FindLast(char search) const;
+		CHECK(string.FindLast("S") == 8);
+		CHECK(string.FindLast("Str") == 0);
+		CHECK(string.FindLast("ASDX") == String::kInvalidPos);
+		CHECK(string.FindLast("String ASD and more") == String::kInvalidPos);
+		CHECK(string.FindLast("") == string.Length());
+
+		CHECK(string.FindLast('S') == 8);
+		CHECK(string.FindLast('g') == 5);
+		CHECK(string.FindLast('x') == String::kInvalidPos);
+
+		// Long enough to be processed in multiple blocks
+		String longString = "data/textures/environment/rocks/granite_01_albedo.png";
+		CHECK(longString.FindLast('/') == 31);
+		CHECK(longString.FindLast('d') == 47);
+		CHECK(longString.FindLast('t') == 37);
+		CHECK(longString.FindLast("data") == 0);
+		CHECK(longString.FindLast("/") == 31);
+		CHECK(longString.FindLast("en") == 22);
+		CHECK(longString.FindLast(".png") == 49);
+		CHECK(longString.FindLast("rock") == 26);
+		CHECK(longString.FindLast("rocks/granite_01_albedo.pn") == 26);
+		CHECK(longString.FindLast(".jpg") == String::kInvalidPos);
 	}
 
 	SECTION("Length()")
@@ -54,6 +97,10 @@ TEST_CASE("String", "[Core]")
 		String utf8Str = u8"\u20AC \U0001F34C";
 		CHECK(utf8Str.Length() == 8);
 		CHECK(utf8Str.LengthUTF8() == 3);
+
+		// Long enough to be processed in multiple blocks
+		String longUtf8Str = u8"\u00C1rv\u00EDzt\u0171r\u0151 t\u00FCk\u00F6rf\u00FAr\u00F3g\u00E9p \u20AC \U0001F34C";
+		CHECK(longUtf8Str.LengthUTF8() == 26);
 	}
 
 	SECTION("AsInt32()")
@@ -183,3 +230,91 @@ TEST_CASE("String", "[Core]")
 //		String SubString(size_t pos) const;
 	}
 }
+
+TEST_CASE("String search benchmark", "[Core][!benchmark]")
+{
+	// The searched characters are far from where the search starts (or missing) so the whole strings are processed
+	DynamicString path;
+	for(int32_t i = 0; i < 64; ++i)
+	{
+		path += "directory";
+		path += i;
+		path += "/";
+	}
+	path += "file.ext";
+
+	DynamicString utf8Text;
+	for(int32_t i = 0; i < 64; ++i)
+	{
+		utf8Text += u8"\u00C1rv\u00EDzt\u0171r\u0151 t\u00FCk\u00F6rf\u00FAr\u00F3g\u00E9p \u20AC \U0001F34C ";
+	}
+
+	BENCHMARK("strchr()")
+	{
+		return strchr(path.Str(), '.');
+	};
+
+	BENCHMARK("Find(char)")
+	{
+		return path.Find('.');
+	};
+
+	BENCHMARK("strstr()")
+	{
+		return strstr(path.Str(), "file");
+	};
+
+	BENCHMARK("Find(String)")
+	{
+		return path.Find("file");
+	};
+
+	BENCHMARK("Scalar FindLast(char)")
+	{
+		for(size_t i = path.Length(); i > 0; --i)
+		{
+			if(path.Str()[i - 1] == '\\')
+			{
+				return i - 1;
+			}
+		}
+		return String::kInvalidPos;
+	};
+
+	BENCHMARK("FindLast(char)")
+	{
+		return path.FindLast('\\');
+	};
+
+	BENCHMARK("Scalar FindLast(String)")
+	{
+		for(size_t i = path.Length() - 11 + 1; i > 0; --i)
+		{
+			if(memcmp(path.Str() + i - 1, "directory0/", 11) == 0)
+			{
+				return i - 1;
+			}
+		}
+		return String::kInvalidPos;
+	};
+
+	BENCHMARK("FindLast(String)")
+	{
+		return path.FindLast("directory0/");
+	};
+
+	BENCHMARK("Scalar LengthUTF8()")
+	{
+		size_t len = 0;
+		for(const char* pCh = utf8Text.Str(); *pCh != '\0'; ++pCh)
+		{
+			len += ((*pCh & 0xC0) != 0x80);
+		}
+		return len;
+	};
+
+	BENCHMARK("LengthUTF8()")
+	{
+		return utf8Text.LengthUTF8();
+	};
+}
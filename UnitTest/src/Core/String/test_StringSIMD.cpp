@@ -0,0 +1,171 @@
+#include "stdafx.h"
+#include "Engine/Core/String/StringSIMD.h"
+
+#include "Engine/Core/Container/Array.h"
+
+// Runs all the functions on every sub-range (with a few different starting positions) and collects the results
+static void CollectResults(Array<int64_t>& results, const char* pText, const char* pWhitespaceText, size_t textSize)
+{
+	auto Offset = [](const char* pCh, const char* pBegin)
+	{
+		return (pCh != nullptr) ? static_cast<int64_t>(pCh - pBegin) : -1;
+	};
+
+	auto Hash = [](const char* pData, size_t size)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for(size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ static_cast<uint8_t>(pData[i])) * 1099511628211ull;
+		}
+		return static_cast<int64_t>(hash);
+	};
+
+	const char* pLongSearch = pText + textSize / 2;
+	char buffer[256] = {};
+	for(size_t begin = 0; begin < 4; ++begin)
+	{
+		for(size_t size = 0; begin + size <= textSize; ++size)
+		{
+			const char* pBegin = pText + begin;
+			const char* pEnd = pBegin + size;
+
+			results.Add(Offset(StringSIMD::FindChar(pBegin, pEnd, 'a'), pBegin));
+			results.Add(Offset(StringSIMD::FindChar(pBegin, pEnd, '#'), pBegin));
+			results.Add(Offset(StringSIMD::FindLastChar(pBegin, pEnd, 'a'), pBegin));
+			results.Add(Offset(StringSIMD::FindLastChar(pBegin, pEnd, '\xC3'), pBegin));
+
+			for(size_t searchSize : { 1, 2, 3, 17, 40 })
+			{
+				results.Add(Offset(StringSIMD::FindString(pBegin, pEnd, "ab/.a\xC3 bba/.ab", std::min<size_t>(searchSize, 14)), pBegin));
+				results.Add(Offset(StringSIMD::FindString(pBegin, pEnd, pLongSearch, searchSize), pBegin));
+				results.Add(Offset(StringSIMD::FindLastString(pBegin, pEnd, "ab/.a\xC3 bba/.ab", std::min<size_t>(searchSize, 14)), pBegin));
+				results.Add(Offset(StringSIMD::FindLastString(pBegin, pEnd, pLongSearch, searchSize), pBegin));
+			}
+
+			memcpy(buffer, pText, textSize);
+			buffer[begin + size / 2] = 'b';
+			const int32_t compareResult = StringSIMD::Compare(pBegin, buffer + begin, size);
+			results.Add((compareResult > 0) - (compareResult < 0));
+
+			results.Add(static_cast<int64_t>(StringSIMD::CountUTF8Chars(pBegin, pEnd)));
+
+			const char* pWhitespaceBegin = pWhitespaceText + begin;
+			results.Add(Offset(StringSIMD::SkipWhitespaces(pWhitespaceBegin, pWhitespaceBegin + size), pWhitespaceBegin));
+			results.Add(Offset(StringSIMD::SkipWhitespacesBackwards(pWhitespaceBegin, pWhitespaceBegin + size), pWhitespaceBegin));
+
+			// The characters outside of the range have to be kept
+			memcpy(buffer, pText, textSize);
+			StringSIMD::ToLower(buffer + begin, buffer + begin + size);
+			StringSIMD::ReplaceChar(buffer + begin, buffer + begin + size, '/', '\\');
+			results.Add(Hash(buffer, textSize));
+
+			memcpy(buffer, pText, textSize);
+			StringSIMD::ToUpper(buffer + begin, buffer + begin + size);
+			results.Add(Hash(buffer, textSize));
+		}
+	}
+}
+
+TEST_CASE("StringSIMD", "[Core]")
+{
+	// Pseudo-random characters from a small set, so the searched strings are partially matching at a lot of positions
+	constexpr size_t kTextSize = 200;
+	const char kChars[] = "aAbzZ/. \xC3\xA1";
+	char text[kTextSize];
+	char whitespaceText[kTextSize];
+	uint32_t seed = 1;
+	for(size_t i = 0; i < kTextSize; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		text[i] = kChars[(seed >> 16) % (sizeof(kChars) - 1)];
+		// Long whitespace runs with a few other characters
+		whitespaceText[i] = " \t\n\r"[(seed >> 16) % 4];
+		if((seed >> 8) % 37 == 0)
+		{
+			whitespaceText[i] = 'x';
+		}
+	}
+
+	const StringSIMD::EInstructionSet originalInstructionSet = StringSIMD::GetInstructionSet();
+	CHECK(originalInstructionSet <= StringSIMD::GetSupportedInstructionSet());
+
+	Array<int64_t> expectedResults;
+	StringSIMD::SetInstructionSet(StringSIMD::EInstructionSet::Scalar);
+	CollectResults(expectedResults, text, whitespaceText, kTextSize);
+
+	// Every implementation which is supported by the CPU has to give the same results as the scalar one
+	for(StringSIMD::EInstructionSet instructionSet : { StringSIMD::EInstructionSet::SSE2, StringSIMD::EInstructionSet::SSE42, StringSIMD::EInstructionSet::AVX2 })
+	{
+		if(instructionSet > StringSIMD::GetSupportedInstructionSet())
+		{
+			continue;
+		}
+
+		StringSIMD::SetInstructionSet(instructionSet);
+		CHECK(StringSIMD::GetInstructionSet() == instructionSet);
+
+		Array<int64_t> results;
+		CollectResults(results, text, whitespaceText, kTextSize);
+
+		REQUIRE(results.Size() == expectedResults.Size());
+		size_t numMismatches = 0;
+		for(size_t i = 0; i < results.Size(); ++i)
+		{
+			numMismatches += (results[i] != expectedResults[i]);
+		}
+		CHECK(numMismatches == 0);
+	}
+
+	StringSIMD::SetInstructionSet(originalInstructionSet);
+}
+
+TEST_CASE("StringSIMD benchmark", "[Core][!benchmark]")
+{
+	// The searched characters are missing, so the whole string is processed
+	char text[4096];
+	for(size_t i = 0; i < sizeof(text); ++i)
+	{
+		text[i] = "directory/"[i % 10];
+	}
+
+	const StringSIMD::EInstructionSet originalInstructionSet = StringSIMD::GetInstructionSet();
+	const char* instructionSetNames[] = { "Scalar", "SSE2", "SSE4.2", "AVX2" };
+	for(StringSIMD::EInstructionSet instructionSet : { StringSIMD::EInstructionSet::Scalar, StringSIMD::EInstructionSet::SSE2, StringSIMD::EInstructionSet::SSE42, StringSIMD::EInstructionSet::AVX2 })
+	{
+		if(instructionSet > StringSIMD::GetSupportedInstructionSet())
+		{
+			continue;
+		}
+
+		StringSIMD::SetInstructionSet(instructionSet);
+		const std::string name = instructionSetNames[static_cast<size_t>(instructionSet)];
+
+		BENCHMARK(name + " FindChar()")
+		{
+			return StringSIMD::FindChar(text, text + sizeof(text), '.');
+		};
+
+		BENCHMARK(name + " FindLastChar()")
+		{
+			return StringSIMD::FindLastChar(text, text + sizeof(text), '.');
+		};
+
+		BENCHMARK(name + " FindString()")
+		{
+			return StringSIMD::FindString(text, text + sizeof(text), "directory.", 10);
+		};
+
+		BENCHMARK(name + " FindLastString()")
+		{
+			return StringSIMD::FindLastString(text, text + sizeof(text), "directory.", 10);
+		};
+
+		BENCHMARK(name + " Compare()")
+		{
+			return StringSIMD::Compare(text, text, sizeof(text));
+		};
+	}
+
+	StringSIMD::SetInstructionSet(originalInstructionSet);
+}
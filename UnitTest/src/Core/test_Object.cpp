@@ -2,6 +2,11 @@
 #include "Engine/Core/Object.h"
 #include "Engine/Core/Math/Transform.h"
 
+#include "Engine/Core/Container/Array.h"
+#include "Engine/Core/Job/JobSystem.h"
+#include "Engine/Core/Math/Rand.h"
+#include "Engine/Core/Math/math.h"
+
 #include "Engine/Scene/SceneGraphTraversal.h"
 
 TEST_CASE("Object", "[Core]")
@@ -252,4 +257,267 @@ TEST_CASE("Object", "[Core]")
 		}
 	);
 	CHECK(traversedCount == 3);
+
+	delete pRootObj;
+}
+
+TEST_CASE("Object world matrix update", "[Core]")
+{
+	Object* pRootObj = new Object();
+	Object& child1 = pRootObj->CreateChildObject("1");
+	Object& child2 = pRootObj->CreateChildObject("2");
+	Object& child1_A = child1.CreateChildObject("1A");
+	Object* pOtherRootObj = new Object();
+
+	auto CheckWorldPosition = [](const Object& object, float expectedValue)
+	{
+		// The matrix is already up-to-date, so GetWorldMatrix() returns the result of UpdateAllWorldMatrices()
+		const Vector3 worldPos = object.GetTransform().GetWorldMatrix().GetTranslation();
+		CHECK(worldPos.GetX() == Approx(expectedValue));
+		CHECK(worldPos.GetY() == Approx(expectedValue));
+		CHECK(worldPos.GetZ() == Approx(expectedValue));
+	};
+
+	pRootObj->GetTransform().SetLocalPosition(Vector3(1.0f, 1.0f, 1.0f));
+	child1.GetTransform().SetLocalPosition(Vector3(2.0f, 2.0f, 2.0f));
+	child1_A.GetTransform().SetLocalPosition(Vector3(3.0f, 3.0f, 3.0f));
+	pOtherRootObj->GetTransform().SetLocalPosition(Vector3(4.0f, 4.0f, 4.0f));
+	Object::UpdateAllWorldMatrices();
+	CheckWorldPosition(*pRootObj, 1.0f);
+	CheckWorldPosition(child1, 3.0f);
+	CheckWorldPosition(child1_A, 6.0f);
+	CheckWorldPosition(child2, 1.0f);
+	CheckWorldPosition(*pOtherRootObj, 4.0f);
+
+	// Only a leaf is changed under clean parents
+	child1_A.GetTransform().SetLocalPosition(Vector3(10.0f, 10.0f, 10.0f));
+	Object::UpdateAllWorldMatrices();
+	CheckWorldPosition(child1_A, 13.0f);
+
+	// Rotation and scale give the same result as the lazy update
+	child1.GetTransform().SetLocalRotation(Quat::CreateRotationY(Math::Pi_2));
+	child1.GetTransform().SetLocalScale(Vector3(2.0f, 2.0f, 2.0f));
+	Object::UpdateAllWorldMatrices();
+	const Matrix4 expectedWorldMatrix = pRootObj->GetTransform().GetWorldMatrix() * child1.GetTransform().ConstructLocalMatrix() * child1_A.GetTransform().ConstructLocalMatrix();
+	const Matrix4& worldMatrix = child1_A.GetTransform().GetWorldMatrix();
+	for(int32_t i = 0; i < 4; ++i)
+	{
+		CHECK(worldMatrix.GetCol(i).GetX() == Approx(expectedWorldMatrix.GetCol(i).GetX()));
+		CHECK(worldMatrix.GetCol(i).GetY() == Approx(expectedWorldMatrix.GetCol(i).GetY()));
+		CHECK(worldMatrix.GetCol(i).GetZ() == Approx(expectedWorldMatrix.GetCol(i).GetZ()));
+		CHECK(worldMatrix.GetCol(i).GetW() == Approx(expectedWorldMatrix.GetCol(i).GetW()));
+	}
+
+	// Moved hierarchy
+	child1.SetParent(pOtherRootObj);
+	Object::UpdateAllWorldMatrices();
+	const Vector3 worldPos = child1.GetTransform().GetWorldMatrix().GetTranslation();
+	CHECK(worldPos.GetX() == Approx(6.0f));
+
+	delete pOtherRootObj;
+	delete pRootObj;
+}
+
+TEST_CASE("Object parallel world matrix update", "[Core]")
+{
+	Modules::JobSystem = std::make_unique<JobSystem>(3);
+
+	// Wide and deep hierarchies with random local transforms
+	Rand rand;
+	Array<Object*> objects;
+	for(int32_t i = 0; i < 20; ++i)
+	{
+		Object* pRootObj = new Object();
+		objects.Add(pRootObj);
+		for(int32_t j = 0; j < 200; ++j)
+		{
+			// The parent is one of the last few objects
+			Object* pParent = objects[objects.Size() - 1 - rand.GetUint(0, std::min<uint32_t>(static_cast<uint32_t>(objects.Size()), 8) - 1)];
+			Object& child = pParent->CreateChildObject("child");
+			child.GetTransform().SetLocalPosition(Vector3(rand.GetFloat(-10.0f, 10.0f), rand.GetFloat(-10.0f, 10.0f), rand.GetFloat(-10.0f, 10.0f)));
+			child.GetTransform().SetLocalRotation(Quat::CreateRotationFromEulerAngles(Vector3(rand.GetFloat(0.0f, Math::Tau), rand.GetFloat(0.0f, Math::Tau), rand.GetFloat(0.0f, Math::Tau))));
+			child.GetTransform().SetLocalScale(Vector3(rand.GetFloat(0.5f, 1.5f), rand.GetFloat(0.5f, 1.5f), rand.GetFloat(0.5f, 1.5f)));
+			objects.Add(&child);
+		}
+	}
+
+	auto MarkAllDirty = [&objects]()
+	{
+		for(Object* pObject : objects)
+		{
+			if(pObject->GetParent() == nullptr)
+			{
+				pObject->GetTransform().SetLocalPosition(pObject->GetTransform().GetLocalPosition());
+			}
+		}
+	};
+
+	Object::UpdateAllWorldMatrices();
+	Array<Matrix4> serialWorldMatrices;
+	for(Object* pObject : objects)
+	{
+		serialWorldMatrices.Add(pObject->GetTransform().GetWorldMatrix());
+	}
+
+	auto CheckSameWorldMatrices = [&objects, &serialWorldMatrices]()
+	{
+		bool isBitwiseEqual = true;
+		for(size_t i = 0; i < objects.Size(); ++i)
+		{
+			isBitwiseEqual &= (memcmp(&objects[i]->GetTransform().GetWorldMatrix(), &serialWorldMatrices[i], sizeof(Matrix4)) == 0);
+		}
+		CHECK(isBitwiseEqual);
+	};
+
+	MarkAllDirty();
+	Object::UpdateAllWorldMatricesParallel();
+	CheckSameWorldMatrices();
+
+	// Falls back to the linear pass when only a few transforms are dirty
+	objects[0]->GetTransform().SetLocalPosition(objects[0]->GetTransform().GetLocalPosition());
+	Object::UpdateAllWorldMatricesParallel();
+	CheckSameWorldMatrices();
+
+	// The depth index is rebuilt after the hierarchy is changed (the second hierarchy is moved under the first one)
+	objects[201]->SetParent(objects[1]);
+	Object::UpdateAllWorldMatrices();
+	serialWorldMatrices.Clear();
+	for(Object* pObject : objects)
+	{
+		serialWorldMatrices.Add(pObject->GetTransform().GetWorldMatrix());
+	}
+
+	MarkAllDirty();
+	Object::UpdateAllWorldMatricesParallel();
+	CheckSameWorldMatrices();
+
+	for(Object* pObject : objects)
+	{
+		if(pObject->GetParent() == nullptr)
+		{
+			delete pObject;
+		}
+	}
+
+	Modules::JobSystem = nullptr;
+}
+
+TEST_CASE("Object transform capacity", "[Core]")
+{
+	CHECK(Object::GetMaxNumTransforms() == Object::kDefaultMaxNumTransforms);
+
+	// The transforms are kept in one array which grows without moving them
+	constexpr size_t kNumObjects = 100000;
+	Array<Object*> objects;
+	objects.Reserve(kNumObjects);
+	for(size_t i = 0; i < kNumObjects; ++i)
+	{
+		objects.Add(new Object());
+	}
+
+	const Transform* pFirstTransform = &objects[0]->GetTransform();
+	bool isArrayContiguous = true;
+	for(size_t i = 0; i < kNumObjects; ++i)
+	{
+		isArrayContiguous &= (&objects[i]->GetTransform() == pFirstTransform + i);
+	}
+	CHECK(isArrayContiguous);
+
+	for(size_t i = kNumObjects; i > 0; --i)
+	{
+		delete objects[i - 1];
+	}
+}
+
+TEST_CASE("Object world matrix update benchmark", "[Core][!benchmark]")
+{
+	// 10000 hierarchies with 10 transforms each
+	constexpr int32_t kNumRootObjects = 10000;
+
+	Array<Object*> objects;
+	for(int32_t i = 0; i < kNumRootObjects; ++i)
+	{
+		Object* pRootObj = new Object();
+		objects.Add(pRootObj);
+		for(int32_t j = 0; j < 3; ++j)
+		{
+			Object& child = pRootObj->CreateChildObject("child");
+			child.GetTransform().SetLocalPosition(Vector3(1.0f, 2.0f, 3.0f));
+			child.GetTransform().SetLocalRotation(Quat::CreateRotationZ(0.1f * j));
+			objects.Add(&child);
+			for(int32_t k = 0; k < 2; ++k)
+			{
+				Object& grandChild = child.CreateChildObject("grandChild");
+				grandChild.GetTransform().SetLocalScale(Vector3(0.5f, 0.5f, 0.5f));
+				objects.Add(&grandChild);
+			}
+		}
+	}
+
+	auto MarkAllDirty = [&objects]()
+	{
+		for(int32_t i = 0; i < kNumRootObjects; ++i)
+		{
+			objects[i * 10]->GetTransform().SetLocalPosition(Vector3(static_cast<float>(i), 0.0f, 0.0f));
+		}
+	};
+
+	BENCHMARK_ADVANCED("Lazy GetWorldMatrix()")(Catch::Benchmark::Chronometer meter)
+	{
+		meter.measure([&objects, &MarkAllDirty]()
+		{
+			MarkAllDirty();
+			float sum = 0.0f;
+			for(Object* pObject : objects)
+			{
+				sum += pObject->GetTransform().GetWorldMatrix().GetTranslation().GetX();
+			}
+			return sum;
+		});
+	};
+
+	BENCHMARK_ADVANCED("UpdateAllWorldMatrices()")(Catch::Benchmark::Chronometer meter)
+	{
+		meter.measure([&objects, &MarkAllDirty]()
+		{
+			MarkAllDirty();
+			Object::UpdateAllWorldMatrices();
+			float sum = 0.0f;
+			for(Object* pObject : objects)
+			{
+				sum += pObject->GetTransform().GetWorldMatrix().GetTranslation().GetX();
+			}
+			return sum;
+		});
+	};
+
+	BENCHMARK("UpdateAllWorldMatrices() without changes")
+	{
+		Object::UpdateAllWorldMatrices();
+	};
+
+	Modules::JobSystem = std::make_unique<JobSystem>();
+	Object::UpdateAllWorldMatricesParallel();
+
+	BENCHMARK_ADVANCED("UpdateAllWorldMatricesParallel()")(Catch::Benchmark::Chronometer meter)
+	{
+		meter.measure([&objects, &MarkAllDirty]()
+		{
+			MarkAllDirty();
+			Object::UpdateAllWorldMatricesParallel();
+			float sum = 0.0f;
+			for(Object* pObject : objects)
+			{
+				sum += pObject->GetTransform().GetWorldMatrix().GetTranslation().GetX();
+			}
+			return sum;
+		});
+	};
+
+	Modules::JobSystem = nullptr;
+
+	for(int32_t i = 0; i < kNumRootObjects; ++i)
+	{
+		delete objects[i * 10];
+	}
 }
@@ -0,0 +1,91 @@
+#include "stdafx.h"
+#include "Engine/Render/FrameRenderState.h"
+
+#include "Engine/Core/Object.h"
+#include "Engine/Render/RenderComponent.h"
+#include "Engine/Render/RenderThread.h"
+#include "Engine/Render/Renderable.h"
+
+TEST_CASE("FrameRenderState", "[Render]")
+{
+	FrameRenderState renderState;
+	CHECK(renderState.IsEmpty());
+
+	std::weak_ptr<Renderable> wpRenderable;
+	{
+		Object object;
+		RenderComponent& renderComponent = object.AddComponent<RenderComponent>();
+		std::shared_ptr<Renderable> spRenderable = std::make_shared<Renderable>();
+		wpRenderable = spRenderable;
+		renderComponent.AddRenderable(std::move(spRenderable));
+
+		// Invisible components are skipped
+		renderComponent.ExtractRenderState(renderState);
+		CHECK(renderState.IsEmpty());
+
+		renderComponent.SetVisible(true);
+		renderComponent.ExtractRenderState(renderState);
+	}
+
+	// The object is destroyed by the simulation, but the renderable is kept alive by the render state
+	REQUIRE(renderState.GetRenderItems().Size() == 1);
+	CHECK(renderState.GetRenderItems()[0].spRenderable == wpRenderable.lock());
+	CHECK_FALSE(renderState.IsEmpty());
+
+	renderState.Clear();
+	CHECK(wpRenderable.expired());
+	CHECK(renderState.IsEmpty());
+}
+
+TEST_CASE("RenderThread", "[Render]")
+{
+	RenderThread renderThread;
+	CHECK(renderThread.GetThreadId() != std::this_thread::get_id());
+
+	SECTION("Run() | WaitForIdle()")
+	{
+		// Every frame is executed in order on the same thread
+		constexpr uint32_t kNumFrames = 100;
+		Array<uint32_t> frameIndices;
+		Array<std::thread::id> threadIds;
+		for(uint32_t i = 0; i < kNumFrames; ++i)
+		{
+			renderThread.Run([&frameIndices, &threadIds, i]()
+			{
+				frameIndices.Add(i);
+				threadIds.Add(std::this_thread::get_id());
+			});
+		}
+		renderThread.WaitForIdle();
+
+		REQUIRE(frameIndices.Size() == kNumFrames);
+		bool isInOrderOnRenderThread = true;
+		for(uint32_t i = 0; i < kNumFrames; ++i)
+		{
+			isInOrderOnRenderThread &= (frameIndices[i] == i && threadIds[i] == renderThread.GetThreadId());
+		}
+		CHECK(isInOrderOnRenderThread);
+	}
+
+	SECTION("Renderables are released on the render thread")
+	{
+		FrameRenderState renderState;
+		std::thread::id destroyingThreadId;
+		{
+			std::shared_ptr<Renderable> spRenderable(new Renderable(), [&destroyingThreadId](Renderable* pRenderable)
+			{
+				destroyingThreadId = std::this_thread::get_id();
+				delete pRenderable;
+			});
+			renderState.AddRenderable(spRenderable, Matrix4::Identity());
+		}
+
+		renderThread.Run([&renderState]()
+		{
+			renderState.Clear();
+		});
+		renderThread.WaitForIdle();
+
+		CHECK(destroyingThreadId == renderThread.GetThreadId());
+	}
+}
@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "Engine/Render/Render.h"
+
+#include "Engine/Render/RenderData.h"
+#include "Engine/Render/RenderThread.h"
+#include "Engine/Render/Shader.h"
+
+class TestRender : public Render
+{
+public:
+	bool Init(OSWindow& mainWindow) override													{ DESIRE_UNUSED(mainWindow); return true; }
+	void UpdateRenderWindow(OSWindow& window) override											{ DESIRE_UNUSED(window); }
+	void Kill() override																		{}
+	void AppendShaderFilenameWithPath(WritableString& outString, const String& shaderFilename) const override	{ DESIRE_UNUSED(outString); DESIRE_UNUSED(shaderFilename); }
+	void EndFrame() override																	{}
+	void Clear(uint32_t clearColorRGBA, float depth, uint8_t stencil) override					{ DESIRE_UNUSED(clearColorRGBA); DESIRE_UNUSED(depth); DESIRE_UNUSED(stencil); }
+	void SetScissor(uint16_t x, uint16_t y, uint16_t width, uint16_t height) override			{ DESIRE_UNUSED(x); DESIRE_UNUSED(y); DESIRE_UNUSED(width); DESIRE_UNUSED(height); }
+	void SetWorldMatrix(const Matrix4& worldMatrix) override									{ DESIRE_UNUSED(worldMatrix); }
+	void SetViewProjectionMatrices(const Matrix4& viewMatrix, const Matrix4& projMatrix) override	{ DESIRE_UNUSED(viewMatrix); DESIRE_UNUSED(projMatrix); }
+
+	std::thread::id shaderReleaseThreadId;
+
+private:
+	RenderData* CreateRenderableRenderData(const Renderable& renderable) override				{ DESIRE_UNUSED(renderable); return nullptr; }
+	RenderData* CreateIndexBufferRenderData(const IndexBuffer& indexBuffer) override			{ DESIRE_UNUSED(indexBuffer); return nullptr; }
+	RenderData* CreateVertexBufferRenderData(const VertexBuffer& vertexBuffer) override			{ DESIRE_UNUSED(vertexBuffer); return nullptr; }
+	RenderData* CreateShaderRenderData(const Shader& shader) override							{ DESIRE_UNUSED(shader); return nullptr; }
+	RenderData* CreateTextureRenderData(const Texture& texture) override						{ DESIRE_UNUSED(texture); return nullptr; }
+	RenderData* CreateRenderTargetRenderData(const RenderTarget& renderTarget) override			{ DESIRE_UNUSED(renderTarget); return nullptr; }
+
+	void OnDestroyShaderRenderData(RenderData* pRenderData) override							{ DESIRE_UNUSED(pRenderData); shaderReleaseThreadId = std::this_thread::get_id(); }
+
+	void SetIndexBuffer(IndexBuffer& indexBuffer) override										{ DESIRE_UNUSED(indexBuffer); }
+	void SetVertexBuffer(VertexBuffer& vertexBuffer) override									{ DESIRE_UNUSED(vertexBuffer); }
+	void SetRenderTarget(RenderTarget* pRenderTarget) override									{ DESIRE_UNUSED(pRenderTarget); }
+	void UpdateDeviceBuffer(DeviceBuffer& deviceBuffer) override								{ DESIRE_UNUSED(deviceBuffer); }
+	void UpdateShaderParams(const Material& material) override									{ DESIRE_UNUSED(material); }
+
+	void DoRender(Renderable& renderable, uint32_t indexOffset, uint32_t vertexOffset, uint32_t numIndices, uint32_t numVertices) override
+	{
+		DESIRE_UNUSED(renderable);
+		DESIRE_UNUSED(indexOffset);
+		DESIRE_UNUSED(vertexOffset);
+		DESIRE_UNUSED(numIndices);
+		DESIRE_UNUSED(numVertices);
+	}
+};
+
+TEST_CASE("Render", "[Render]")
+{
+	Modules::Render = std::make_unique<TestRender>();
+	TestRender& render = static_cast<TestRender&>(*Modules::Render);
+	CHECK(render.IsOwnerThread());
+
+	SECTION("Unbind() on the owner thread")
+	{
+		{
+			Shader shader("test");
+			shader.m_pRenderData = new RenderData();
+		}
+		CHECK(render.shaderReleaseThreadId == std::this_thread::get_id());
+	}
+
+	SECTION("Unbind() on other threads is deferred")
+	{
+		RenderThread renderThread;
+		render.SetOwnerThread(renderThread.GetThreadId());
+		CHECK_FALSE(render.IsOwnerThread());
+
+		{
+			Shader shader("test");
+			shader.m_pRenderData = new RenderData();
+		}
+		CHECK(render.shaderReleaseThreadId == std::thread::id());
+
+		renderThread.Run([&render]()
+		{
+			render.ExecuteDeferredCommands();
+		});
+		renderThread.WaitForIdle();
+		CHECK(render.shaderReleaseThreadId == renderThread.GetThreadId());
+	}
+
+	Modules::Render = nullptr;
+}